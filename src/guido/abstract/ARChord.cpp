@@ -29,6 +29,7 @@
 #include "functor.h"
 #include "tree_browser.h"
 #include "visitor.h"
+#include "guidotags.h"
 
 using namespace std;
 
@@ -178,25 +179,17 @@ void ARChord::duration (rationals& dur, rational currdur, int curdots) const {
 
 //______________________________________________________________________________
 void ARChord::acceptIn(basevisitor& v) {
-	if (visitor<SMARTP<ARChord> >* p = dynamic_cast<visitor<SMARTP<ARChord> >*>(&v)) {
-		SMARTP<ARChord> sptr = this;
-		p->visitStart(sptr);
-	}
-	else guidoelement::acceptIn(v);
+	dispatcher<SMARTP<ARChord>, Sguidoelement>::visitStart (v, kDChord, this);
 }
 
 //______________________________________________________________________________
 void ARChord::acceptOut(basevisitor& v) {
-	if (visitor<SMARTP<ARChord> >* p = dynamic_cast<visitor<SMARTP<ARChord> >*>(&v)) {
-		SMARTP<ARChord> sptr = this;
-		p->visitEnd(sptr);
-	}
-	else guidoelement::acceptOut(v);
+	dispatcher<SMARTP<ARChord>, Sguidoelement>::visitEnd (v, kDChord, this);
 }
 
 //______________________________________________________________________________
-SMARTP<ARChord> ARChord::create()
-    { ARChord* o = new ARChord; assert(o!=0); return o; }
+SMARTP<ARChord> ARChord::create(garena* arena)
+    { ARChord* o = new (arena) ARChord; assert(o!=0); o->setArena(arena); return o; }
 
 
 //______________________________________________________________________________
@@ -47,7 +47,7 @@ class basevisitor;
 class gar_export ARChord : public guidoelement
 { 
 	public:
-		static SMARTP<ARChord> create();
+		static SMARTP<ARChord> create(garena* arena=0);
         virtual void	acceptIn(basevisitor& v);
         virtual void	acceptOut(basevisitor& v);
 		// gives the list of notes durations
@@ -42,59 +42,59 @@ namespace guido
 
 //______________________________________________________________________________
 template<int elt>
-class newTagFunctor : public functor<Sguidotag,long> {
+class newTagFunctor : public functor2<Sguidotag,long,garena*> {
 	public:
-		Sguidotag operator ()(long id) { return ARTag<elt>::create(id); }
+		Sguidotag operator ()(long id, garena* arena) { return ARTag<elt>::create(id, arena); }
 };
 
 //______________________________________________________________________________
-SARMusic ARFactory::createMusic() const
+SARMusic ARFactory::createMusic(garena* arena) const
 {
-	SARMusic elt = ARMusic::create();
+	SARMusic elt = ARMusic::create(arena);
 	if (elt) elt->setName("music");
 	return elt;
 }
 
 //______________________________________________________________________________
-SARVoice ARFactory::createVoice() const
+SARVoice ARFactory::createVoice(garena* arena) const
 {
-	SARVoice elt = ARVoice::create();
+	SARVoice elt = ARVoice::create(arena);
 	if (elt) elt->setName("voice");
 	return elt;
 }
 
 //______________________________________________________________________________
-SARChord ARFactory::createChord() const
+SARChord ARFactory::createChord(garena* arena) const
 {
-	SARChord elt = ARChord::create();
+	SARChord elt = ARChord::create(arena);
 	if (elt) elt->setName("chord");
 	return elt;
 }
 
 //______________________________________________________________________________
-SARNote ARFactory::createNote(const std::string& name) const
+SARNote ARFactory::createNote(const std::string& name, garena* arena) const
 {
-	SARNote elt = ARNote::create();
+	SARNote elt = ARNote::create(arena);
 	if (elt) elt->setName(name);
 	return elt;
 }
 
 //______________________________________________________________________________
-Sguidovariable ARFactory::createVariable(const std::string& name) const
+Sguidovariable ARFactory::createVariable(const std::string& name, garena* arena) const
 {
-	Sguidovariable var = guidovariable::create();
+	Sguidovariable var = guidovariable::create(arena);
 	var->setName(name);
 	return var;
 }
 
 //______________________________________________________________________________
-Sguidotag ARFactory::createTag(const string& eltname, long id) const
+Sguidotag ARFactory::createTag(const string& eltname, long id, garena* arena) const
 { 
 	map<std::string, NewTagFunctor*>::const_iterator i = fMap.find( eltname );
 	if (i != fMap.end()) {
 		NewTagFunctor* f= i->second;
 		if (f) {
-			Sguidotag elt = (*f)(id);
+			Sguidotag elt = (*f)(id, arena);
 			elt->setName(eltname);
 			return elt;
 		}
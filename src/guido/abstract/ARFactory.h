@@ -40,12 +40,15 @@
 namespace guido 
 {
 
-typedef functor<Sguidotag,long>	NewTagFunctor;
+typedef functor2<Sguidotag,long,garena*>	NewTagFunctor;
 
 
 //______________________________________________________________________________
 /*!
 \brief A factory for creating GAR objects
+
+	All the create methods take an optional arena (see garena): when present,
+	the new object is allocated in the arena.
 */
 class gar_export ARFactory : public singleton<ARFactory>{
 
@@ -55,12 +58,12 @@ class gar_export ARFactory : public singleton<ARFactory>{
 				 ARFactory();
 		virtual ~ARFactory();
 
-		Sguidotag		createTag(const std::string& elt, long id=0) const;	
-		SARMusic		createMusic() const;
-		SARVoice		createVoice() const;
-		SARChord		createChord() const;
-		SARNote			createNote(const std::string& name) const;
-		Sguidovariable	createVariable(const std::string& name) const;
+		Sguidotag		createTag(const std::string& elt, long id=0, garena* arena=0) const;
+		SARMusic		createMusic(garena* arena=0) const;
+		SARVoice		createVoice(garena* arena=0) const;
+		SARChord		createChord(garena* arena=0) const;
+		SARNote			createNote(const std::string& name, garena* arena=0) const;
+		Sguidovariable	createVariable(const std::string& name, garena* arena=0) const;
 };
 
 } // namespace
@@ -26,55 +26,74 @@
 #endif
 
 #include <stdlib.h>
-#include <sstream>
 #include "ARNote.h"
+#include "strnum.h"
 #include "visitor.h"
+#include "guidotags.h"
 
 using namespace std;
 
 namespace guido 
 {
 
-std::map<std::string, std::pair<char, int> > ARNote::fNormalizeMap;
+//______________________________________________________________________________
+// the map is built by its first user: notes can then be created from several threads
+// and the pitch names looked up before the library static data are initialized
+static std::map<std::string, std::pair<char, int> > normalizeMap()
+{
+	std::map<std::string, std::pair<char, int> > map;
+	map["c"]   = make_pair('c', 0);
+	map["d"]   = make_pair('d', 0);
+	map["e"]   = make_pair('e', 0);
+	map["f"]   = make_pair('f', 0);
+	map["g"]   = make_pair('g', 0);
+	map["a"]   = make_pair('a', 0);
+	map["b"]   = make_pair('b', 0);
+	map["h"]   = make_pair('b', 0);
+
+	map["do"]  = make_pair('c', 0);
+	map["re"]  = make_pair('d', 0);
+	map["mi"]  = make_pair('e', 0);
+	map["fa"]  = make_pair('f', 0);
+	map["sol"] = make_pair('g', 0);
+	map["la"]  = make_pair('a', 0);
+	map["si"]  = make_pair('b', 0);
+	map["ti"]  = make_pair('b', 0);
+
+	map["cis"] = make_pair('c', 1);
+	map["dis"] = make_pair('d', 1);
+	map["fis"] = make_pair('f', 1);
+	map["gis"] = make_pair('g', 1);
+	map["ais"] = make_pair('a', 1);
+	return map;
+}
 
 //______________________________________________________________________________
 ARNote::ARNote() 
 	:	fOctave(kUndefinedOctave), fAccidental(0), 
-		fDots(0), fDuration(kUndefinedDuration,4)
-		
+		fDots(0), fDuration(kUndefinedDuration,4),
+		fKind(kPitched), fPitchName(0), fPitchAlter(0)
 {
-	if (!fNormalizeMap.size()) {
-		fNormalizeMap["c"]   = make_pair('c', 0);
-		fNormalizeMap["d"]   = make_pair('d', 0);
-		fNormalizeMap["e"]   = make_pair('e', 0);
-		fNormalizeMap["f"]   = make_pair('f', 0);
-		fNormalizeMap["g"]   = make_pair('g', 0);
-		fNormalizeMap["a"]   = make_pair('a', 0);
-		fNormalizeMap["b"]   = make_pair('b', 0);
-		fNormalizeMap["h"]   = make_pair('b', 0);
-
-		fNormalizeMap["do"]  = make_pair('c', 0);
-		fNormalizeMap["re"]  = make_pair('d', 0);
-		fNormalizeMap["mi"]  = make_pair('e', 0);
-		fNormalizeMap["fa"]  = make_pair('f', 0);
-		fNormalizeMap["sol"] = make_pair('g', 0);
-		fNormalizeMap["la"]  = make_pair('a', 0);
-		fNormalizeMap["si"]  = make_pair('b', 0);
-		fNormalizeMap["ti"]  = make_pair('b', 0);
-
-		fNormalizeMap["cis"] = make_pair('c', 1);
-		fNormalizeMap["dis"] = make_pair('d', 1);
-		fNormalizeMap["fis"] = make_pair('f', 1);
-		fNormalizeMap["gis"] = make_pair('g', 1);
-		fNormalizeMap["ais"] = make_pair('a', 1);
-	}
+}
+
+//______________________________________________________________________________
+// the note kind and pitch are computed once, when the name is set
+void ARNote::setName (const string& name)
+{
+	guidoelement::setName (name);
+	if (name == "_")			fKind = kRest;
+	else if (name == "empty")	fKind = kEmpty;
+	else						fKind = kPitched;
+	fPitchAlter = 0;
+	fPitchName = NormalizedPitchName (name, &fPitchAlter);
 }
 
 //______________________________________________________________________________
 char ARNote::NormalizedPitchName (const string& name, int* alter)
 {
+	static const map<string, pair<char, int> > normalize = normalizeMap();	// thread safe initialization
 	pair<map<string, pair<char, int> >::const_iterator, map<string, pair<char, int> >::const_iterator>
-	erp = fNormalizeMap.equal_range( name );
+	erp = normalize.equal_range( name );
 	char outname = 0;
 	if (erp.first != erp.second) {
 		outname = (*erp.first).second.first;
@@ -86,7 +105,8 @@ char ARNote::NormalizedPitchName (const string& name, int* alter)
 //______________________________________________________________________________
 char ARNote::NormalizedPitchName (int* alter) const
 {
-	return NormalizedPitchName( getName(), alter );
+	if (fPitchName && alter) *alter = fPitchAlter;
+	return fPitchName;
 }
 
 //______________________________________________________________________________
@@ -297,58 +317,49 @@ ARNote& ARNote::operator -= (const rational& d)	{ fDuration -= d; fDuration.rati
 
 //______________________________________________________________________________
 void ARNote::acceptIn(basevisitor& v) {
-	if (visitor<SMARTP<ARNote> >* p = dynamic_cast<visitor<SMARTP<ARNote> >*>(&v)) {
-		SMARTP<ARNote> sptr = this;
-		p->visitStart(sptr);
-	}
-	else guidoelement::acceptIn(v);
+	dispatcher<SMARTP<ARNote>, Sguidoelement>::visitStart (v, kDNote, this);
 }
 
 //______________________________________________________________________________
 void ARNote::acceptOut(basevisitor& v) {
-	if (visitor<SMARTP<ARNote> >* p = dynamic_cast<visitor<SMARTP<ARNote> >*>(&v)) {
-		SMARTP<ARNote> sptr = this;
-		p->visitEnd(sptr);
-	}
-	else guidoelement::acceptOut(v);
+	dispatcher<SMARTP<ARNote>, Sguidoelement>::visitEnd (v, kDNote, this);
 }
 
 //______________________________________________________________________________
 ARNote::operator string() const {
-    ostringstream str;
+	string str;
+	write (str);
+	return str;
+}
 
+//______________________________________________________________________________
+void ARNote::write(string& str, bool octave, bool duration, bool dots) const {
 	bool octOut = false;
-	str << getName();
-	if ((getName() != "_") && (getName() != "empty")) {
+	str += getName();
+	if (isPitched()) {
 		int n = GetAccidental();
-		if (n) {
-			char c = (n > 0) ? '#' : '&';
-			n = abs(n);
-			while (n--) str << c;
-		}
+		if (n) str.append (abs(n), (n > 0) ? '#' : '&');
 
 		n = GetOctave();
-		if ( n != ARNote::kUndefinedOctave) {
-			str << n;
+		if (octave && (n != ARNote::kUndefinedOctave)) {
+			appendnum (str, n);
 			octOut = true;
 		}
 	}
 
 	long n = fDuration.getNumerator();
-	if (n != kUndefinedDuration) {
-		if ((n != 1) || octOut)  str << '*' << n;
+	if (duration && (n != kUndefinedDuration)) {
+		if ((n != 1) || octOut)  { str += '*'; appendnum (str, n); }
 		n = fDuration.getDenominator();
-		if (n > 0) str << '/' << n;
+		if (n > 0) { str += '/'; appendnum (str, n); }
 	}
 
-	n = GetDots();
-	while (n--) str << '.';
-
-	return  str.str();
+	n = dots ? GetDots() : 0;
+	if (n > 0) str.append (n, '.');
 }
 
 //______________________________________________________________________________
-SMARTP<ARNote> ARNote::create()
-    { ARNote* o = new ARNote(); assert(o!=0); return o; }
+SMARTP<ARNote> ARNote::create(garena* arena)
+    { ARNote* o = new (arena) ARNote(); assert(o!=0); o->setArena(arena); return o; }
 
 }
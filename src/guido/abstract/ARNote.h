@@ -52,16 +52,19 @@ class gar_export ARNote : public guidoelement
 
 		int fOctave, fAccidental, fDots;
 		rational fDuration;
-
-		static std::map<std::string, std::pair<char, int> >	fNormalizeMap;
+		int  fKind;					// the note kind, computed from the note name
+		char fPitchName;			// the normalized pitch name, computed from the note name
+		int  fPitchAlter;			// the alteration carried by the note name (e.g. cis)
 
 	public:
 		enum { kUndefinedOctave = -999, kUndefinedDuration = -999999, kDefaultOctave=1 };
 		enum pitch { kNoPitch = -1, C, D, E, F, G, A, B };
+		enum kind { kPitched, kRest, kEmpty };
 
-		static SMARTP<ARNote> create();
+		static SMARTP<ARNote> create(garena* arena=0);
         virtual void			acceptIn  (basevisitor& v);
         virtual void			acceptOut (basevisitor& v);
+		virtual void			setName (const std::string& name);
 
 		void SetOctave		(int oct)	{ fOctave = oct; }
 		void SetAccidental	(int acc)	{ fAccidental = acc; }
@@ -73,9 +76,10 @@ class gar_export ARNote : public guidoelement
 		int GetOctave		() const	{ return fOctave; }
 		int GetAccidental	() const	{ return fAccidental; }
 		int GetDots			() const	{ return fDots; }
-		bool isRest ()	const			{ return getName() == "_"; }
-		bool isEmpty ()	const			{ return getName() == "empty"; }
-		bool isPitched () const			{ return !isRest() && !isEmpty(); }
+		kind getKind () const			{ return kind(fKind); }
+		bool isRest ()	const			{ return fKind == kRest; }
+		bool isEmpty ()	const			{ return fKind == kEmpty; }
+		bool isPitched () const			{ return fKind == kPitched; }
 		
 		pitch	GetPitch	(int& alter) const;
 		int		midiPitch	(int& currentOctave) const;
@@ -118,6 +122,8 @@ class gar_export ARNote : public guidoelement
 		static pitch decPitch	(pitch p, int& octave, int& alter);
 		
 		operator std::string () const;
+		/// appends the gmn code of the note to str, the octave, duration and dots may be omitted (i.e. left implicit)
+		void write (std::string& str, bool octave=true, bool duration=true, bool dots=true) const;
 };
 
 }
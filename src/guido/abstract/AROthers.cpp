@@ -23,6 +23,7 @@
 
 #include "AROthers.h"
 #include "visitor.h"
+#include "guidotags.h"
 
 using namespace std;
 
@@ -34,25 +35,17 @@ namespace guido
 //   ARMusic
 //______________________________________________________________________________
 void ARMusic::acceptIn(basevisitor& v) {
-	if (visitor<SMARTP<ARMusic> >* p = dynamic_cast<visitor<SMARTP<ARMusic> >*>(&v)) {
-		SMARTP<ARMusic> sptr = this;
-		p->visitStart(sptr);
-	}
-	else guidoelement::acceptIn(v);
+	dispatcher<SMARTP<ARMusic>, Sguidoelement>::visitStart (v, kDMusic, this);
 }
 
 //______________________________________________________________________________
 void ARMusic::acceptOut(basevisitor& v) {
-	if (visitor<SMARTP<ARMusic> >* p = dynamic_cast<visitor<SMARTP<ARMusic> >*>(&v)) {
-		SMARTP<ARMusic> sptr = this;
-		p->visitEnd(sptr);
-	}
-	else guidoelement::acceptOut(v);
+	dispatcher<SMARTP<ARMusic>, Sguidoelement>::visitEnd (v, kDMusic, this);
 }
 
 //______________________________________________________________________________
-SMARTP<ARMusic> ARMusic::create()
-    { ARMusic* o = new ARMusic; assert(o!=0); return o; }
+SMARTP<ARMusic> ARMusic::create(garena* arena)
+    { ARMusic* o = new (arena) ARMusic; assert(o!=0); o->setArena(arena); return o; }
 
 
 //______________________________________________________________________________
@@ -60,24 +53,16 @@ SMARTP<ARMusic> ARMusic::create()
 //   ARVoice
 //______________________________________________________________________________
 void ARVoice::acceptIn(basevisitor& v) {
-	if (visitor<SMARTP<ARVoice> >* p = dynamic_cast<visitor<SMARTP<ARVoice> >*>(&v)) {
-		SMARTP<ARVoice> sptr = this;
-		p->visitStart(sptr);
-	}
-	else guidoelement::acceptIn(v);
+	dispatcher<SMARTP<ARVoice>, Sguidoelement>::visitStart (v, kDVoice, this);
 }
 
 //______________________________________________________________________________
 void ARVoice::acceptOut(basevisitor& v) {
-	if (visitor<SMARTP<ARVoice> >* p = dynamic_cast<visitor<SMARTP<ARVoice> >*>(&v)) {
-		SMARTP<ARVoice> sptr = this;
-		p->visitEnd(sptr);
-	}
-	else guidoelement::acceptOut(v);
+	dispatcher<SMARTP<ARVoice>, Sguidoelement>::visitEnd (v, kDVoice, this);
 }
 
 //______________________________________________________________________________
-SMARTP<ARVoice> ARVoice::create()
-    { ARVoice* o = new ARVoice; assert(o!=0); return o; }
+SMARTP<ARVoice> ARVoice::create(garena* arena)
+    { ARVoice* o = new (arena) ARVoice; assert(o!=0); o->setArena(arena); return o; }
 
 } // namespace
@@ -47,20 +47,31 @@ class gar_export ARMusic : public guidoelement
 		typedef std::vector<Sguidoelement> THeader;
 		typedef std::vector<Sguidoelement> TFooter;
 	
-		static SMARTP<ARMusic> create();
+		static SMARTP<ARMusic> create(garena* arena=0);
         virtual void	acceptIn(basevisitor& v);
         virtual void	acceptOut(basevisitor& v);
 		virtual void	setHeader (THeader& header)		{ fHeader = header; }
-		virtual void	addHeader (Sguidoelement elt)	{ fHeader.push_back(elt); }
-		virtual THeader	getHeader () const				{ return fHeader; }
-		virtual void	addFooter (Sguidoelement elt)	{ fFooter.push_back(elt); }
-		virtual TFooter	getFooter () const				{ return fFooter; }
+		virtual void	addHeader (Sguidoelement elt)	{ fHeader.push_back(std::move(elt)); }
+		virtual const THeader&	getHeader () const		{ return fHeader; }
+		virtual void	addFooter (Sguidoelement elt)	{ fFooter.push_back(std::move(elt)); }
+		virtual const TFooter&	getFooter () const		{ return fFooter; }
+
+		/*! \brief the score tick base: the number of ticks of a whole note
+		
+			All the note durations of the score are integer numbers of ticks, which
+			allows to compute the dates with integers (see durationvisitor).
+			The tick base is computed by the parser, 0 means that it is unknown.
+		*/
+		static const long kMaxTickBase = 1L << 20;		///< keeps the dates in ticks far from overflow
+		long			getTickBase () const			{ return fTickBase; }
+		void			setTickBase (long base)			{ fTickBase = base; }
 
     protected:
-				 ARMusic() {}
+				 ARMusic() : fTickBase(0) {}
 		virtual ~ARMusic() {}
 		THeader fHeader;
 		TFooter fFooter;
+		long	fTickBase;
 };
 
 //______________________________________________________________________________
@@ -72,13 +83,13 @@ class gar_export ARVoice : public guidoelement
 	public:
 		typedef std::vector<Sguidoelement> TComments;
 
-		static SMARTP<ARVoice> create();
+		static SMARTP<ARVoice> create(garena* arena=0);
         virtual void	acceptIn(basevisitor& v);
         virtual void	acceptOut(basevisitor& v);
-		virtual void		addBefore(Sguidoelement elt){ fBefore.push_back(elt); }
-		virtual TComments	getBefore () const			{ return fBefore; }
-		virtual void		addAfter (Sguidoelement elt){ fAfter.push_back(elt); }
-		virtual TComments	getAfter () const			{ return fAfter; }
+		virtual void		addBefore(Sguidoelement elt){ fBefore.push_back(std::move(elt)); }
+		virtual const TComments& getBefore () const		{ return fBefore; }
+		virtual void		addAfter (Sguidoelement elt){ fAfter.push_back(std::move(elt)); }
+		virtual const TComments& getAfter () const		{ return fAfter; }
 
     protected:	
 				 ARVoice() {}
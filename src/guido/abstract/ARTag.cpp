@@ -21,22 +21,55 @@
 
 */
 
-#include <sstream>
 #include "ARTag.h"
+#include "guidotags.h"
+#include "strnum.h"
 
 using namespace std;
 
 namespace guido 
 {
 
+//______________________________________________________________________________
+// the xxxBegin and xxxEnd tag types: the table gives the matching tag type
+// as a positive value for Begin tags and a negative value for End tags
+//______________________________________________________________________________
+static const int* matchTable()
+{
+	static int table[kTagEnd] = { 0 };
+	static const int pairs[][2] = {
+		{ kTAccelBegin, kTAccelEnd },		{ kTBeamBegin, kTBeamEnd },
+		{ kTCrescBegin, kTCrescEnd },		{ kTDecrescBegin, kTDecrescEnd },
+		{ kTDimBegin, kTDimEnd },			{ kTFBeamBegin, kTFBeamEnd },
+		{ kTGlissandoBegin, kTGlissandoEnd },	{ kTRepeatBegin, kTRepeatEnd },
+		{ kTRitBegin, kTRitEnd },			{ kTSlurBegin, kTSlurEnd },
+		{ kTStaccBegin, kTStaccEnd },		{ kTTieBegin, kTTieEnd },
+		{ kTTremBegin, kTTremEnd },			{ kTTrillBegin, kTTrillEnd },
+		{ kTTupletBegin, kTTupletEnd },		{ kTVoltaBegin, kTVoltaEnd },
+		{ 0, 0 }
+	};
+	for (int i=0; pairs[i][0]; i++) {
+		table[pairs[i][0]] = pairs[i][1];
+		table[pairs[i][1]] = -pairs[i][0];
+	}
+	return table;
+}
+static const int* gMatchTable = matchTable();
+
 //______________________________________________________________________________
 bool guidotag::beginTag() const {
-	return getName().find("Begin", 0) != string::npos;
+	return gMatchTable[getType()] > 0;
 }
 
 //______________________________________________________________________________
 bool guidotag::endTag() const {
-	return getName().find("End", 0) != string::npos;
+	return gMatchTable[getType()] < 0;
+}
+
+//______________________________________________________________________________
+int guidotag::matchType () const {
+	int match = gMatchTable[getType()];
+	return match < 0 ? -match : match;
 }
 
 //______________________________________________________________________________
@@ -59,7 +92,8 @@ string guidotag::matchTag () const {
 
 //______________________________________________________________________________
 bool guidotag::matchTag (const Sguidotag& tag) const {
-	return matchTag() == tag->getName();
+	int match = matchType();
+	return match && (match == tag->getType());
 }
 
 //______________________________________________________________________________
@@ -69,26 +103,21 @@ bool guidotag::operator ==(const Sguidotag& elt) const {
 
 //______________________________________________________________________________
 void guidotag::acceptIn(basevisitor& v) {
-	if (visitor<SMARTP<guidotag> >* p = dynamic_cast<visitor<SMARTP<guidotag> >*>(&v)) {
-		SMARTP<guidotag> sptr = this;
-		p->visitStart(sptr);
-	}
-	else guidoelement::acceptIn(v);
+	dispatcher<SMARTP<guidotag>, Sguidoelement>::visitStart (v, kDTag, this);
 }		
 
 //______________________________________________________________________________
 void guidotag::acceptOut(basevisitor& v) {
-	if (visitor<SMARTP<guidotag> >* p = dynamic_cast<visitor<SMARTP<guidotag> >*>(&v)) {
-		SMARTP<guidotag> sptr = this;
-		p->visitEnd(sptr);
-	}
-	else guidoelement::acceptOut(v);
+	dispatcher<SMARTP<guidotag>, Sguidoelement>::visitEnd (v, kDTag, this);
 }		
 
 //______________________________________________________________________________
-string guidotag::escape(const std::string& val) const
+void guidotag::escape(const std::string& val, std::string& esc) const
 {
-	string esc;
+	if (val.find ('"') == string::npos) {	// nothing to escape
+		esc += val;
+		return;
+	}
 	size_t n = val.size();
 	for (int i=0; i<n; i++) {
 		if ((val[i] == '\\') && (val[i+1] == '"'))
@@ -97,40 +126,43 @@ string guidotag::escape(const std::string& val) const
 			esc += '\\';
 		esc += val[i];	
 	}
-	return esc;
 }
 
 //______________________________________________________________________________
 guidotag::operator string() const {
-    ostringstream str;
+	string str;
+	write (str);
+	return str;
+}
 
-	str << '\\' << getName();
+//______________________________________________________________________________
+void guidotag::write(string& str) const {
+	str += '\\';
+	str += getName();
 	long n = getID();
-	if (n) str << ':' << n;
+	if (n) { str += ':'; appendnum (str, n); }
 
 	if (attributes().size()) {
-		str << '<';
+		str += '<';
 
 		Sguidoattributes::const_iterator attr = attributes().begin();
 		while (attr != attributes().end()) {
-			n = (*attr)->getName().size();
-			if (n) str << (*attr)->getName() << "=";
+			const string& name = (*attr)->getName();
+			if (name.size()) { str += name; str += '='; }
+
+			bool quote = (*attr)->quoteVal();
+			if (quote) str += '"';
+			escape ((*attr)->getValue(), str);
+			if (quote) str += '"';
 
-			const string quote = (*attr)->quoteVal() ? "\"" : "";
-			string value = escape((*attr)->getValue());
-			
-			str << quote << value << quote;
-			
-			n = (*attr)->getUnit().size();
-			if (n) str << (*attr)->getUnit();
+			str += (*attr)->getUnit();
 
 			attr++;
 			if (attr != attributes().end())
-				str << ',';
+				str += ',';
 		}
-		str << '>';
+		str += '>';
 	}
-	return  str.str();
 }
 
 } // namespace
@@ -26,9 +26,11 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "arexport.h"
 #include "guidoelement.h"
+#include "guidotags.h"
 #include "visitor.h"
 
 namespace guido 
@@ -65,11 +67,13 @@ class gar_export guidotag : public guidoelement
 		long getID() const				{ return fID; }		/// return the tag id i.e. the xx of the \\tag:xx form
 		void setID(long id)				{ fID = id; }
 		operator std::string () const;
+		void write (std::string& str) const;	/// appends the gmn code of the tag to str
 
 		bool	beginTag () const;		/// return true when the tag is in the form xxxBegin (tieBegin, slurBegin etc...)
 		bool	endTag () const;		/// return true when the tag is in the form xxxEnd (tieEnd, slurEnd etc...)
 		bool	matchTag (const Sguidotag&) const;	/// return true if tags are in the form xxxBegin and xxxEnd and xxx matches 
 		std::string	matchTag () const;		/// return the name of the matching xxxBegin or xxxEnd form if any 
+		int		matchType () const;		/// return the type of the matching xxxBegin or xxxEnd form if any, 0 otherwise
 
 		//________________________________________________________________________
 		virtual bool operator ==(const Sguidotag& i) const;
@@ -78,11 +82,46 @@ class gar_export guidotag : public guidoelement
     protected:	
 				 guidotag(long id) : fID(id) {}
 		virtual ~guidotag() {}
-		std::string escape(const std::string&) const;
+		void escape(const std::string& val, std::string& out) const;	/// appends val to out, with the quotes escaped
 		long fID;						/// represents the tag id i.e the \\tag:xx form of the tags where xx is a discriminant id
 		int  fType;						/// the tag template integer
 };
 
+//______________________________________________________________________________
+/*!
+\brief A map of tags indexed by tag type
+
+	The tags are stored in a flat array. The types that have been set are
+	recorded so that clear() and types() don't have to scan the whole array.
+*/
+class gar_export tagsmap
+{
+	public:
+				 tagsmap() : fTags(kTagEnd), fSet(kTagEnd, false) {}
+		virtual ~tagsmap() {}
+
+		const Sguidotag& operator[] (int type) const	{ return fTags[type]; }
+		void	set (int type, const Sguidotag& tag) {
+			if (!fSet[type]) { fSet[type] = true; fUsed.push_back(type); }
+			fTags[type] = tag;
+		}
+		void	reset (int type)	{ fTags[type] = Sguidotag(); }
+		void	clear () {
+			for (size_t i=0; i < fUsed.size(); i++) {
+				fTags[fUsed[i]] = Sguidotag();
+				fSet[fUsed[i]] = false;
+			}
+			fUsed.clear();
+		}
+		//! the types that have been set since the last clear (their tag may have been reset since)
+		const std::vector<int>& types() const	{ return fUsed; }
+
+	private:
+		std::vector<Sguidotag>	fTags;
+		std::vector<bool>		fSet;
+		std::vector<int>		fUsed;
+};
+
 //______________________________________________________________________________
 /*!
 \brief A template class to type all guido tags with integers
@@ -92,22 +131,14 @@ class gar_export guidotag : public guidoelement
 template <int elt> class ARTag : public guidotag
 {
 	public:
-		static SMARTP<ARTag<elt> > create(long id=0)
-			{ ARTag<elt>* o = new ARTag<elt>(id); assert(o!=0); o->fType=elt; return o; }
+		static SMARTP<ARTag<elt> > create(long id=0, garena* arena=0)
+			{ ARTag<elt>* o = new (arena) ARTag<elt>(id); assert(o!=0); o->fType=elt; o->setArena(arena); return o; }
 
         virtual void acceptIn(basevisitor& v) {
-			if (visitor<SMARTP<ARTag<elt> > >* p = dynamic_cast<visitor<SMARTP<ARTag<elt> > >*>(&v)) {
-				SMARTP<ARTag<elt> > sptr = this;
-				p->visitStart(sptr);
-			}
-			else guidotag::acceptIn(v);
+			dispatcher<SMARTP<ARTag<elt> >, Sguidotag, Sguidoelement>::visitStart (v, elt, this);
 		}
         virtual void acceptOut(basevisitor& v) {
-			if (visitor<SMARTP<ARTag<elt> > >* p = dynamic_cast<visitor<SMARTP<ARTag<elt> > >*>(&v)) {
-				SMARTP<ARTag<elt> > sptr = this;
-				p->visitEnd(sptr);
-			}
-			else guidotag::acceptOut(v);
+			dispatcher<SMARTP<ARTag<elt> >, Sguidotag, Sguidoelement>::visitEnd (v, elt, this);
 		}
 
     protected:	
@@ -21,6 +21,7 @@
 
 #include "guidocomment.h"
 #include "visitor.h"
+#include "guidotags.h"
 
 using namespace std;
 
@@ -28,23 +29,17 @@ namespace guido
 {
 
 //______________________________________________________________________________
-Sguidocomment guidocomment::create()
-	{ guidocomment * o = new guidocomment; assert(o!=0); return o; }
+Sguidocomment guidocomment::create(garena* arena)
+	{ guidocomment * o = new (arena) guidocomment; assert(o!=0); o->setArena(arena); return o; }
 
 //______________________________________________________________________________
 void guidocomment::acceptIn(basevisitor& v) {
-	if (visitor<Sguidocomment>* p = dynamic_cast<visitor<Sguidocomment>*>(&v)) {
-		Sguidocomment ge = this;
-		p->visitStart (ge);
-	}
+	dispatcher<Sguidocomment>::visitStart (v, kDComment, this);
 }
 
 //______________________________________________________________________________
 void guidocomment::acceptOut(basevisitor& v) {
-	if (visitor<Sguidocomment>* p = dynamic_cast<visitor<Sguidocomment>*>(&v)) {
-		Sguidocomment ge = this;
-		p->visitEnd (ge);
-	}
+	dispatcher<Sguidocomment>::visitEnd (v, kDComment, this);
 }
 
 //______________________________________________________________________________
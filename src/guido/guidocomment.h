@@ -38,7 +38,7 @@ class gar_export guidocomment : public guidoelement
 		virtual ~guidocomment() {}
 
 	public:
-        static Sguidocomment create();
+        static Sguidocomment create(garena* arena=0);
 
 		virtual void		acceptIn(basevisitor& visitor);
 		virtual void		acceptOut(basevisitor& visitor);
@@ -21,36 +21,79 @@
 
 */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <iostream>
-
+#include <locale>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <unordered_set>
+
 #include "guidoelement.h"
 #include "gmnvisitor.h"
-#include "gmnvisitor.h"
 #include "tree_browser.h"
 #include "visitor.h"
+#include "guidotags.h"
 
 using namespace std;
 
 namespace guido 
 {
 
+//______________________________________________________________________________
+// attributes names and units are taken from a small vocabulary: they are
+// interned so that all the attributes share a single copy of each string
+//______________________________________________________________________________
+static const string gEmptyString;
+
+// the interned strings are looked up by value
+struct internhash	{ size_t operator() (const string* s) const					{ return hash<string>()(*s); } };
+struct internequal	{ bool operator() (const string* a, const string* b) const	{ return *a == *b; } };
+
+static const string* intern (const string& str)
+{
+	if (str.empty()) return &gEmptyString;
+
+	// each thread looks the strings up in its own cache, without locking:
+	// the shared table is locked only for the strings that are new to the thread
+	thread_local unordered_set<const string*, internhash, internequal> cache;
+	auto i = cache.find (&str);
+	if (i != cache.end()) return *i;
+
+	static mutex m;
+	static unordered_set<string> strings;
+	const string* interned;
+	{
+		lock_guard<mutex> lock (m);
+		interned = &*strings.insert(str).first;		// set elements are never moved
+	}
+	cache.insert (interned);
+	return interned;
+}
+
 //______________________________________________________________________________
 // guidoattribute
 //______________________________________________________________________________
-void guidoattribute::setName (const string& name) 		{ fName = name; }
-void guidoattribute::setUnit (const string& unit)		{ fUnit = unit; }
-void guidoattribute::setValue (const string& value, bool quote) { fValue = value; fQuoteVal=quote; }
+guidoattribute::guidoattribute()
+	: fName(&gEmptyString), fUnit(&gEmptyString), fType(kString), fQuoteVal(false)
+{
+	fNumber.fLong = 0;
+}
+
+void guidoattribute::setName (const string& name) 		{ fName = intern(name); }
+void guidoattribute::setUnit (const string& unit)		{ fUnit = intern(unit); }
+void guidoattribute::setValue (const string& value, bool quote) { fValue = value; fQuoteVal=quote; fType = kString; }
 void guidoattribute::setQuoteVal (bool quote)			{ fQuoteVal=quote; }
 
 //______________________________________________________________________________
 void guidoattribute::setValue (long value)
 {
-	stringstream s;
-	s << value;
-	s >> fValue;
+	char buff[32];
+	snprintf (buff, sizeof(buff), "%ld", value);
+	fValue = buff;
+	fNumber.fLong = value;
+	fType = kLong;
 }
 
 //______________________________________________________________________________
@@ -59,18 +102,55 @@ void guidoattribute::setValue (double value)
 	stringstream s;
 	s << value;
 	s >> fValue;
+	fNumber.fFloat = value;
+	fType = kFloat;
+}
+
+//______________________________________________________________________________
+// numeric attributes are converted without parsing their value
+guidoattribute::operator int () const	{ return int(long(*this)); }
+guidoattribute::operator long () const
+{
+	switch (fType) {
+		case kLong:		return fNumber.fLong;
+		case kFloat:	return long(fNumber.fFloat);
+	}
+	return atol(fValue.c_str());
+}
+
+guidoattribute::operator float () const
+{
+	switch (fType) {
+		case kLong:		return float(fNumber.fLong);
+		case kFloat:	return float(fNumber.fFloat);
+	}
+	// atof depends on the C numeric locale, the classic locale is used instead
+	istringstream s(fValue);
+	s.imbue (locale::classic());
+	float value = 0;
+	s >> value;
+	return value;
 }
 
-guidoattribute::operator int () const	{ return atoi(fValue.c_str()); }
-guidoattribute::operator long () const	{ return atol(fValue.c_str()); }
-guidoattribute::operator float () const	{ return (float)atof(fValue.c_str()); }
+//______________________________________________________________________________
+Sguidoattribute guidoattribute::clone(garena* arena) const
+{
+	Sguidoattribute attr = create(arena);
+	attr->fName = fName;
+	attr->fValue = fValue;
+	attr->fUnit = fUnit;
+	attr->fNumber = fNumber;
+	attr->fType = fType;
+	attr->fQuoteVal = fQuoteVal;
+	return attr;
+}
 
 //______________________________________________________________________________
 bool guidoattribute::operator ==(const Sguidoattribute& elt) const { 
 	return  elt 
-			&& (getName() == elt->getName())
+			&& (fName == elt->fName)
 			&& (getValue() == elt->getValue())
-			&& (getUnit() == elt->getUnit())
+			&& (fUnit == elt->fUnit)
 			&& (quoteVal() == elt->quoteVal());
 }
 
@@ -80,15 +160,15 @@ bool guidoattribute::operator ==(const Sguidoattribute& elt) const {
 void guidoelement::setName (const string& name) 	{ fName = name; }
 
 //______________________________________________________________________________
-Sguidoattribute guidoattribute::create()    
-	{ guidoattribute * o = new guidoattribute; assert(o!=0); return o; }
-Sguidoelement guidoelement::create()		
-	{ guidoelement * o = new guidoelement; assert(o!=0); return o; }
+Sguidoattribute guidoattribute::create(garena* arena)
+	{ guidoattribute * o = new (arena) guidoattribute; assert(o!=0); o->setArena(arena); return o; }
+Sguidoelement guidoelement::create(garena* arena)
+	{ guidoelement * o = new (arena) guidoelement; assert(o!=0); o->setArena(arena); return o; }
 
 //______________________________________________________________________________
 // attributes access by name
 //______________________________________________________________________________
-const Sguidoattribute guidoelement::getAttribute (const std::string& attrname) const
+const guidoattribute* guidoelement::findAttribute (const std::string& attrname) const
 {
 	Sguidoattributes::const_iterator it;
 	for (it = attributes().begin(); it != attributes().end(); it++) {
@@ -98,6 +178,11 @@ const Sguidoattribute guidoelement::getAttribute (const std::string& attrname) c
 	return 0;
 }
 
+const Sguidoattribute guidoelement::getAttribute (const std::string& attrname) const
+{
+	return (guidoattribute*)findAttribute(attrname);
+}
+
 void guidoelement::delAttribute (const std::string& attrname)
 {
 	Sguidoattributes::iterator it;
@@ -111,58 +196,64 @@ void guidoelement::delAttribute (const std::string& attrname)
 
 const std::string guidoelement::getAttributeValue (const std::string& attrname) const
 {
-	Sguidoattribute attribute = getAttribute(attrname);
+	const guidoattribute* attribute = findAttribute(attrname);
 	return attribute ? attribute->getValue() : "";
 }
 
 long guidoelement::getAttributeLongValue	(const std::string& attrname, long defaultvalue) const
 {
-	Sguidoattribute attribute = getAttribute(attrname);
+	const guidoattribute* attribute = findAttribute(attrname);
 	return attribute ? long(*attribute) : defaultvalue;
 }
 
 int guidoelement::getAttributeIntValue	(const std::string& attrname, int defaultvalue) const
 {
-	Sguidoattribute attribute = getAttribute(attrname);
+	const guidoattribute* attribute = findAttribute(attrname);
 	return attribute ? int(*attribute) : defaultvalue;
 }
 
 float guidoelement::getAttributeFloatValue	(const std::string& attrname, float defaultvalue) const
 {
-	Sguidoattribute attribute = getAttribute(attrname);
+	const guidoattribute* attribute = findAttribute(attrname);
 	return attribute ? float(*attribute) : defaultvalue;
 }
 
 //______________________________________________________________________________
 // attributes access by index
 //______________________________________________________________________________
+const guidoattribute* guidoelement::findAttribute (unsigned int index) const
+{
+	const Sguidoattributes& attrs = attributes();
+	return (index < attrs.size()) ? (const guidoattribute*)attrs[index] : 0;
+}
+
 const Sguidoattribute guidoelement::getAttribute (unsigned int index) const
 {
-	Sguidoattributes attrs = attributes();
+	const Sguidoattributes& attrs = attributes();
 	return (index < attrs.size()) ? attrs[index] : 0;
 }
 
 const std::string guidoelement::getAttributeValue (unsigned int index) const
 {
-	Sguidoattribute attribute = getAttribute(index);
+	const guidoattribute* attribute = findAttribute(index);
 	return attribute ? attribute->getValue() : "";
 }
 
 long guidoelement::getAttributeLongValue	(unsigned int index, long defaultvalue) const
 {
-	Sguidoattribute attribute = getAttribute(index);
+	const guidoattribute* attribute = findAttribute(index);
 	return attribute ? long(*attribute) : defaultvalue;
 }
 
 int guidoelement::getAttributeIntValue	(unsigned int index, int defaultvalue) const
 {
-	Sguidoattribute attribute = getAttribute(index);
+	const guidoattribute* attribute = findAttribute(index);
 	return attribute ? int(*attribute) : defaultvalue;
 }
 
 float guidoelement::getAttributeFloatValue	(unsigned int index, float defaultvalue) const
 {
-	Sguidoattribute attribute = getAttribute(index);
+	const guidoattribute* attribute = findAttribute(index);
 	return attribute ? float(*attribute) : defaultvalue;
 }
 
@@ -174,29 +265,38 @@ long guidoelement::add (const Sguidoattribute& attr)
 	return n;
 }
 
+long guidoelement::add (Sguidoattribute&& attr)
+{ 
+	long n = fAttributes.size();
+	fAttributes.push_back(std::move(attr));
+	return n;
+}
+
 //______________________________________________________________________________
 long guidoelement::add (const Sguidoattributes& attr)
 { 
 	long n = fAttributes.size();
-	for (Sguidoattributes::const_iterator i = attr.begin(); i != attr.end(); i++)
-		fAttributes.push_back(*i);
+	fAttributes.insert(fAttributes.end(), attr.begin(), attr.end());
+	return n;
+}
+
+long guidoelement::add (Sguidoattributes&& attr)
+{ 
+	long n = fAttributes.size();
+	if (!n) fAttributes = std::move(attr);
+	else for (Sguidoattributes::iterator i = attr.begin(); i != attr.end(); i++)
+		fAttributes.push_back(std::move(*i));
 	return n;
 }
 
 //______________________________________________________________________________
 void guidoelement::acceptIn(basevisitor& v) {
-	if (visitor<Sguidoelement>* p = dynamic_cast<visitor<Sguidoelement>*>(&v)) {
-		Sguidoelement ge = this;
-		p->visitStart (ge);
-	}
+	dispatcher<Sguidoelement>::visitStart (v, kDElement, this);
 }
 
 //______________________________________________________________________________
 void guidoelement::acceptOut(basevisitor& v) {
-	if (visitor<Sguidoelement>* p = dynamic_cast<visitor<Sguidoelement>*>(&v)) {
-		Sguidoelement ge = this;
-		p->visitEnd (ge);
-	}
+	dispatcher<Sguidoelement>::visitEnd (v, kDElement, this);
 }
 
 //______________________________________________________________________________
@@ -224,9 +324,16 @@ bool guidoelement::operator ==(const Sguidoelement& elt) const {
 	return elt && (getName() == elt->getName()) && (*this) == elt->attributes();
 }
 
+//______________________________________________________________________________
+// the output mode is stored in the stream
+static int gmnModeIndex ()		{ static int index = ios_base::xalloc(); return index; }
+
+ostream& gmnpretty (ostream& os)	{ os.iword(gmnModeIndex()) = 0; return os; }
+ostream& gmncompact (ostream& os)	{ os.iword(gmnModeIndex()) = 1; return os; }
+
 //______________________________________________________________________________
 void guidoelement::print(ostream& os) {
-	gmnvisitor gv(os);
+	gmnvisitor gv(os, false, os.iword(gmnModeIndex()) != 0);
 	tree_browser<guidoelement> browser(&gv);
 	browser.browse(*this);
 }
@@ -32,6 +32,7 @@
 #include "ctree.h"
 #include "gar_smartpointer.h"
 #include "guidorational.h"
+#include "smallvector.h"
 
 namespace guido 
 {
@@ -47,23 +48,36 @@ typedef SMARTP<guidoelement> 	Sguidoelement;
 
 	An attribute is represented by its name and its value.
 	Attributes are mainly used with tags. Names are often omitted.	
+	Names and units are interned: they are shared by all the attributes.
+	Numeric values are stored natively, along with their textual form.
 */
 class gar_export guidoattribute : public smartable {
-	//! the attribute name
-	std::string	fName;
+	public:
+		enum type { kString, kLong, kFloat };
+
+	private:
+	//! the attribute name (interned)
+	const std::string*	fName;
 	//! the attribute value
 	std::string 	fValue;
-	//! the optional attribute unit
-	std::string 	fUnit;
+	//! the optional attribute unit (interned)
+	const std::string*	fUnit;
+	//! the value of numeric attributes
+	union {
+		long	fLong;
+		double	fFloat;
+	} fNumber;
+	//! the value type
+	char fType;
 	//! force quotes for string values
 	bool fQuoteVal;
 	
     protected:
-		guidoattribute() : fQuoteVal(false) {}
+				 guidoattribute();
 		virtual ~guidoattribute() {}
     public:
-		static	Sguidoattribute create();
-				Sguidoattribute	clone() const;
+		static	Sguidoattribute create(garena* arena=0);
+				Sguidoattribute	clone(garena* arena=0) const;
 
 		void setName (const std::string& name);
 		void setValue (const std::string& value, bool quote=false);
@@ -72,10 +86,13 @@ class gar_export guidoattribute : public smartable {
 		void setValue (double value);
 		void setQuoteVal (bool);
 
-		const std::string& getName () const		{ return fName; }
+		const std::string& getName () const		{ return *fName; }
 		const std::string& getValue () const	{ return fValue; }
-		const std::string& getUnit () const		{ return fUnit; }
+		const std::string& getUnit () const		{ return *fUnit; }
+		type			getType () const		{ return type(fType); }
 		bool			quoteVal () const		{ return fQuoteVal; }
+		//! returns the value of a kFloat attribute, without loss of precision
+		double			getFloat () const		{ return fNumber.fFloat; }
 
 		//! returns the attribute value as a int
 		operator int () const;
@@ -89,7 +106,8 @@ class gar_export guidoattribute : public smartable {
 		virtual bool operator !=(const Sguidoattribute& i) const		{ return !(*this == i); }
 };
 
-typedef std::vector<Sguidoattribute> Sguidoattributes;
+//! most elements carry no more than 3 attributes, they are stored inline
+typedef smallvector<Sguidoattribute, 3> Sguidoattributes;
 /*!
 \brief A generic guido element representation.
 
@@ -105,6 +123,9 @@ class gar_export guidoelement : public ctree<guidoelement>, public visitable
 	Sguidoattributes fAttributes;
 	//! list of the element attributes
 	bool	fAuto;
+
+	const guidoattribute*	findAttribute (const std::string& attrname) const;
+	const guidoattribute*	findAttribute (unsigned int index) const;
 	
     protected:
 		guidoelement() : fAuto(false) {}
@@ -113,19 +134,21 @@ class gar_export guidoelement : public ctree<guidoelement>, public visitable
 		virtual bool operator ==(const Sguidoattributes& attributes) const;
 
 	public:
-        static Sguidoelement create();
+        static Sguidoelement create(garena* arena=0);
 
 		virtual void		acceptIn(basevisitor& visitor);
 		virtual void		acceptOut(basevisitor& visitor);
 		virtual	void		print(std::ostream& os);
 
-		void				setName (const std::string& name);
+		virtual void		setName (const std::string& name);
 		const std::string&	getName () const		{ return fName; }
 		void				setAuto(bool v)			{ fAuto = v; }
 		bool				getAuto() const			{ return fAuto; }
 
 		long add (const Sguidoattribute& attr);        
+		long add (Sguidoattribute&& attr);
 		long add (const Sguidoattributes& attr);        
+		long add (Sguidoattributes&& attr);
         const Sguidoattributes& attributes() const	{ return fAttributes; }
         Sguidoattributes& attributes()				{ return fAttributes; }
 
@@ -153,6 +176,12 @@ class gar_export guidoelement : public ctree<guidoelement>, public visitable
 
 gar_export std::ostream& operator << (std::ostream& os, const Sguidoelement& elt);
 
+/*! \brief stream manipulators that select how the elements are printed to a stream:
+	pretty printed (the default) or in compact form (see gmnvisitor)
+*/
+gar_export std::ostream& gmnpretty (std::ostream& os);
+gar_export std::ostream& gmncompact (std::ostream& os);
+
 } // namespace
 
 #endif
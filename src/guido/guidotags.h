@@ -173,7 +173,19 @@ enum {
 	kTDrRenz,
 	kTBackward,		// a tag specific to the normal form of a chord
 
-	kTagEnd
+	kTagEnd,
+
+	// the visit dispatch types of the elements that are not typed tags
+	// (the tags use their tag type, see dispatcher in visitor.h)
+	kDElement = kTagEnd,
+	kDMusic,
+	kDVoice,
+	kDChord,
+	kDNote,
+	kDComment,
+	kDVariable,
+	kDTag,
+	kDispatchEnd
 };
 
 } //namespace
@@ -21,6 +21,7 @@
 
 #include "guidovariable.h"
 #include "visitor.h"
+#include "guidotags.h"
 
 using namespace std;
 
@@ -28,35 +29,32 @@ namespace guido
 {
 
 //______________________________________________________________________________
-Sguidovariable guidovariable::create()
-	{ guidovariable * o = new guidovariable; assert(o!=0); return o; }
+Sguidovariable guidovariable::create(garena* arena)
+	{ guidovariable * o = new (arena) guidovariable; assert(o!=0); o->setArena(arena); return o; }
 
 //______________________________________________________________________________
 void guidovariable::acceptIn(basevisitor& v) {
-	if (visitor<Sguidovariable>* p = dynamic_cast<visitor<Sguidovariable>*>(&v)) {
-		Sguidovariable ge = this;
-		p->visitStart (ge);
-	}
+	dispatcher<Sguidovariable>::visitStart (v, kDVariable, this);
 }
 
 //______________________________________________________________________________
 void guidovariable::acceptOut(basevisitor& v) {
-	if (visitor<Sguidovariable>* p = dynamic_cast<visitor<Sguidovariable>*>(&v)) {
-		Sguidovariable ge = this;
-		p->visitEnd (ge);
-	}
+	dispatcher<Sguidovariable>::visitEnd (v, kDVariable, this);
 }
 
 //______________________________________________________________________________
 guidovariable::operator string() const {
-    ostringstream str;
-	str << getName();
+	string str = getName();
 	Sguidoattribute a = getAttribute(0);
 	if (a) {
-		const string quote = a->quoteVal() ? "\"" : "";
-		str << "=" << quote << a->getValue() << quote << ";";
+		const char* quote = a->quoteVal() ? "\"" : "";
+		str += '=';
+		str += quote;
+		str += a->getValue();
+		str += quote;
+		str += ';';
 	}
-	return str.str();
+	return str;
 }
 
 //______________________________________________________________________________
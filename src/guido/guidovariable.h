@@ -38,7 +38,7 @@ class gar_export guidovariable : public guidoelement
 		virtual ~guidovariable() {}
 
 	public:
-        static Sguidovariable create();
+        static Sguidovariable create(garena* arena=0);
 		operator std::string () const;
 
 		virtual void		acceptIn(basevisitor& visitor);
@@ -30,6 +30,11 @@
 
 /*!
 \brief	Rational number representation.
+
+	The results of the arithmetic operators are always normalized: the fraction
+	is reduced and the denominator is positive. Values given to the constructors
+	and setters are kept as is (e.g. a note duration as written in the score).
+	An operation whose exact result doesn't fit a long throws std::overflow_error.
 */
 
 namespace guido
@@ -43,7 +48,7 @@ class gar_export rational {
         long int fDenominator;        
 #endif        
         // Used by rationalise()
-        long int gcd(long int a, long int b); 
+        static long int gcd(long int a, long int b);
  
     public:    
 #ifdef EMCC   
@@ -77,8 +82,8 @@ class gar_export rational {
         rational& operator /=(const rational &dur);
         // (i.e. dur * 3/2 or dur * 7/4)
 
-        rational& operator *=(long int num) { fNumerator *= num; return *this; }
-        rational& operator /=(long int num) { fDenominator *= num; return *this; }
+        rational& operator *=(long int num);
+        rational& operator /=(long int num);
  
         rational& operator =(const rational& dur);
     
@@ -109,39 +114,51 @@ class gar_export rational {
         float	toFloat() const;
         int		toInt() const;
 		
-		static std::vector<rational> getBaseRationals(rational input, bool useDot = false, std::vector<int>* dotsOutput = nullptr) {
-			// If they want dots, they must supply somewhere for them to go
-			if (useDot && !dotsOutput) {
-				printf("Cannot output dots with nullptr!  Pass in dotsOutput (3rd parameter)!\n");
-				std::cout.flush();
-				return std::vector<rational>();
-			}
-			std::vector<rational> output = std::vector<rational>();
-			rational zeroR = rational(0, 1);
-			int currDen = 1;
-			while (input > zeroR) {
-				if (useDot) {
-					while (input >= rational(3, (currDen * 2))) {
-						input -= rational(3, (currDen * 2));
-						output.push_back( rational(1, currDen) );
-						dotsOutput->push_back(1);
-					}
-				}
-				while (input >= rational(1, currDen)) {
-					input -= rational(1, currDen);
-					output.push_back( rational(1, currDen) );
-					if (dotsOutput) dotsOutput->push_back(0);
-				}
-				currDen *= 2;
-			}
-			return output;
-		}
+		/*! \brief decomposes a duration into base note values (see basedurations)
+			\param input the duration to decompose
+			\param useDot when true, dotted values may be used
+			\param dotsOutput when non null, receives the dots of each value (required with useDot)
+			\return the base note values, empty when useDot is set without dotsOutput
+		*/
+		static std::vector<rational> getBaseRationals(const rational& input, bool useDot = false, std::vector<int>* dotsOutput = nullptr);
 };
 
 typedef std::vector<rational> rationals;
 gar_export std::ostream& operator << (std::ostream& os, rational);
 gar_export std::ostream& operator << (std::ostream& os, rationals);
 
+/*!
+\brief	Decomposes a duration into base note values.
+
+	The values are taken greedily from the whole note down: 1/1, 1/2, 1/4...
+	and optionally their dotted forms (3/2, 3/4...), which is the binary
+	expansion of the duration. A duration whose denominator is not a power of
+	2 (e.g. 5/12) is decomposed as a tuplet: the values are divided by the odd
+	part of the denominator (5/12 gives 1/3 and 1/12).
+	The values are produced one at a time, without any allocation, in
+	O(number of values + log2(denominator)).
+*/
+class gar_export basedurations {
+	public:
+				 basedurations(const rational& duration, bool useDot = false);
+
+		//! the number of remaining values
+		size_t	size() const;
+		/*! \brief gives the next value
+			\param dur on output, the value duration (without the dot)
+			\param dots on output, the value dots (0 or 1)
+			\return false when there are no more values
+		*/
+		bool	next(rational& dur, int& dots);
+
+	private:
+		long	fRest;		// the remaining duration, in units of 1/(2^fShift * fOdd)
+		long	fOdd;		// the odd part of the duration denominator
+		int		fShift;		// the power of 2 part of the unit
+		int		fLevel;		// the current value is 1/(2^fLevel * fOdd)
+		bool	fDot;
+};
+
 }
 
 #endif
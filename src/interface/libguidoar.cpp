@@ -23,11 +23,14 @@
 */
 
 #include <fstream>
+#include <stdexcept>
 #include <string.h>
 
 #include "libguidoar.h"
 
 #include "AROthers.h"
+#include "binaryreader.h"
+#include "binaryvisitor.h"
 #include "bottomOperation.h"
 #include "clonevisitor.h"
 #include "durationOperation.h"
@@ -42,14 +45,17 @@
 #endif
 #include "mirrorOperation.h"
 #include "parOperation.h"
+#include "pipelineOperation.h"
 #include "seqOperation.h"
 #include "tailOperation.h"
 #include "topOperation.h"
 #include "transposeOperation.h"
 #include "ringvector.h"
 #include "rythmApplyOperation.h"
+#include "scorestore.h"
 #include "pitchApplyOperation.h"
 #include "unrolled_guido_browser.h"
+#include "voicepool.h"
 
 using namespace std;
 namespace guido
@@ -58,6 +64,7 @@ namespace guido
 //----------------------------------------------------------------------------
 float			guidoarVersion()	{ return 1.10; }
 const char*		guidoarVersionStr()	{ return "1.10"; }
+void			guidoSetVoiceThreads(unsigned threads)	{ voicepool::setThreads (threads); }
 
 //----------------------------------------------------------------------------
 static SARMusic read (const char* buff)
@@ -67,9 +74,12 @@ static SARMusic read (const char* buff)
 	return r.parseString(buff);
 }
 
+//----------------------------------------------------------------------------
+// the rational operations throw overflow_error when a value doesn't fit a long:
+// the entry points catch it and report the operation as failed
 //----------------------------------------------------------------------------
 garErr guido2unrolled(const char* gmn, std::ostream& out)
-{
+try {
 	garErr err = kNoErr;
 	Sguidoelement score =  read(gmn);
 	if (!score) return kInvalidArgument;
@@ -82,31 +92,68 @@ garErr guido2unrolled(const char* gmn, std::ostream& out)
 	else err = kOperationFailed;			
 	return err;
 }
+catch (const overflow_error&) { return kOperationFailed; }
+
+//----------------------------------------------------------------------------
+garErr guido2binary(const char* gmn, std::ostream& out)
+try {
+	Sguidoelement score =  read(gmn);
+	if (!score) return kInvalidArgument;
+	binaryvisitor bv;
+	bv.write (score, out);
+	return kNoErr;
+}
+catch (const overflow_error&) { return kOperationFailed; }
+
+//----------------------------------------------------------------------------
+garErr binary2guido(const char* data, size_t size, std::ostream& out)
+try {
+	binaryreader r;
+	Sguidoelement score = r.readMusic (data, size);
+	if (!score) return kInvalidArgument;
+	out << score << endl;
+	return kNoErr;
+}
+catch (const overflow_error&) { return kOperationFailed; }
+
+//----------------------------------------------------------------------------
+garErr guido2store(const char* gmn, const char* file)
+try {
+	SARMusic score =  read(gmn);
+	if (!score) return kInvalidArgument;
+	ofstream out (file, ios::out | ios::binary);
+	if (!out) return kOperationFailed;
+	scorestore::write (score, out);
+	return out ? kNoErr : kOperationFailed;
+}
+catch (const overflow_error&) { return kOperationFailed; }
 
 //----------------------------------------------------------------------------
 rational	guidoEv2Time(const char* gmn, unsigned int index, unsigned int voice)
-{
+try {
 	Sguidoelement score =  read(gmn);
 	if (!score) return kInvalidArgument;
 	event2timevisitor convert;
 	return convert.event2time (score, index, voice);
 }
+catch (const overflow_error&) { return kOperationFailed; }
 
 //----------------------------------------------------------------------------
 int guidoTime2Ev(const char* gmn, const rational& date, unsigned int voice)
-{
+try {
 	Sguidoelement score =  read(gmn);
 	if (!score) return kInvalidArgument;
 	event2timevisitor convert;
 	return convert.time2event (score, date, voice);
 }
+catch (const overflow_error&) { return kOperationFailed; }
 
 
 //----------------------------------------------------------------------------
 // wrappers for score operations
 //----------------------------------------------------------------------------
 template<typename OP, typename ARG> garErr opWrapper(const char* gmn, ARG param, std::ostream& out)
-{
+try {
 	Sguidoelement score =  read(gmn); 
 	if (!score) return kInvalidArgument;
 
@@ -116,10 +163,11 @@ template<typename OP, typename ARG> garErr opWrapper(const char* gmn, ARG param,
 	else return kOperationFailed;		
 	return kNoErr;
 }
+catch (const overflow_error&) { return kOperationFailed; }
 
 //----------------------------------------------------------------------------
 template<typename OP> garErr opgmnWrapper(const char* gmn, const char* gmnSpec,  std::ostream& out)
-{
+try {
 	SARMusic score =  read(gmn);
 	SARMusic dscore = read(gmnSpec);
 	if (!score || !dscore) return kInvalidArgument;
@@ -130,20 +178,30 @@ template<typename OP> garErr opgmnWrapper(const char* gmn, const char* gmnSpec,
 	else return kOperationFailed;		
 	return kNoErr;
 }
+catch (const overflow_error&) { return kOperationFailed; }
+
+//----------------------------------------------------------------------------
+// the wrappers results are printed then dropped: the operations that support
+// it may share the elements of their input (see clonevisitor)
+template<typename OP> class sharing : public OP
+{
+	public:
+		sharing() { this->share (true); }
+};
 
 //----------------------------------------------------------------------------
 // score operations
 //----------------------------------------------------------------------------
 garErr guidoGBottom(const char* gmn, const char* gmnSpec, std::ostream& out)
-							{ return opgmnWrapper<bottomOperation>(gmn, gmnSpec, out); }
+							{ return opgmnWrapper<sharing<bottomOperation> >(gmn, gmnSpec, out); }
 garErr guidoVBottom(const char* gmn, int nvoices, std::ostream& out)
-							{ return opWrapper<bottomOperation, int>(gmn, nvoices, out); }
+							{ return opWrapper<sharing<bottomOperation>, int>(gmn, nvoices, out); }
 
 //----------------------------------------------------------------------------
 garErr guidoGTop(const char* gmn, const char* gmnSpec, std::ostream& out)
-							{ return opgmnWrapper<topOperation>(gmn, gmnSpec, out); }
+							{ return opgmnWrapper<sharing<topOperation> >(gmn, gmnSpec, out); }
 garErr guidoVTop(const char* gmn, int nvoices, std::ostream& out)
-							{ return opWrapper<topOperation, int>(gmn, nvoices, out); }
+							{ return opWrapper<sharing<topOperation>, int>(gmn, nvoices, out); }
 
 //----------------------------------------------------------------------------
 garErr guidoGSetDuration(const char* gmn, const char* gmnSpec, std::ostream& out)
@@ -153,6 +211,20 @@ garErr guidoVSetDuration(const char* gmn, rational duration, std::ostream& out)
 garErr guidoVMultDuration(const char* gmn, float duration, std::ostream& out)
 							{ return opWrapper<durationOperation, float>(gmn, duration, out); }
 
+//----------------------------------------------------------------------------
+garErr guidoPipeline(const char* gmn, const char* pipeline, std::ostream& out)
+try {
+	Sguidoelement score =  read(gmn);
+	pipelineOperation op;
+	if (!score || !pipeline || !op.parse (pipeline)) return kInvalidArgument;
+
+	score = op(score);
+	if (score) out << score << endl;
+	else return kOperationFailed;
+	return kNoErr;
+}
+catch (const overflow_error&) { return kOperationFailed; }
+
 //----------------------------------------------------------------------------
 garErr guidoApplyRythm(const char* gmn, const char* gmnSpec, TApplyMode mode, std::ostream& out)
 { 
@@ -203,9 +275,9 @@ garErr guidoGTranpose(const char* gmn, const char* gmnSpec, std::ostream& out)
 
 //----------------------------------------------------------------------------
 garErr guidoVHead(const char* gmn, rational duration, std::ostream& out)
-							{ return opWrapper<headOperation, rational>(gmn, duration, out); }
+							{ return opWrapper<sharing<headOperation>, rational>(gmn, duration, out); }
 garErr guidoGHead(const char* gmn, const char* gmnSpec, std::ostream& out)
-							{ return opgmnWrapper<headOperation>(gmn, gmnSpec, out); }
+							{ return opgmnWrapper<sharing<headOperation> >(gmn, gmnSpec, out); }
 
 //----------------------------------------------------------------------------
 garErr guidoVEHead(const char* gmn, int duration, std::ostream& out)
@@ -239,19 +311,20 @@ garErr guidoGMirror(const char* gmn1, const char* gmn2, std::ostream& out)
 
 //----------------------------------------------------------------------------
 rational guidoDuration(const char* gmn)
-{
+try {
 	rational duration (-1,1);
 	Sguidoelement score =  read(gmn); 
 	if (score) {
 		durationvisitor dv;
-		duration = dv.duration (score);
+		duration = dv.voicesDuration (score);
 	}
 	return duration;
 }
+catch (const overflow_error&) { return rational(-1,1); }
 
 //----------------------------------------------------------------------------
 garErr guido2midifile(const char* gmn, const char* file)
-{
+try {
 #ifdef MIDIEXPORT
 	Sguidoelement score =  read(gmn);
 	if (!score) return kInvalidArgument;
@@ -263,12 +336,14 @@ garErr guido2midifile(const char* gmn, const char* file)
 	return kOperationFailed;
 #endif
 }
+catch (const overflow_error&) { return kOperationFailed; }
 
 //----------------------------------------------------------------------------
 bool guidocheck(const char* gmn)
-{
+try {
 	Sguidoelement score =  read(gmn); 
 	return score ? true : false;
 }
+catch (const overflow_error&) { return false; }
 
 }
@@ -44,6 +44,15 @@ namespace guido
 
 enum garErr { kNoErr, kInvalidFile, kInvalidArgument, kOperationFailed };
 
+/*! \brief stream manipulators that select how the functions below print their result score
+
+	\c out << gmncompact selects a compact form intended for machine to machine exchanges: no
+	indentation nor line breaks, no redundant spaces, and the octaves and durations equal to the
+	implicit ones are omitted. \c out << gmnpretty restores the default human readable form.
+*/
+gar_export std::ostream& gmnpretty (std::ostream& os);
+gar_export std::ostream& gmncompact (std::ostream& os);
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +63,16 @@ gar_export float			guidoarVersion();
 /// \brief gives the library version string
 gar_export const char*		guidoarVersionStr();
 
+/*! \brief sets the number of threads used to process the voices of a score
+
+	Transpose, mirror, rythm and pitch application and the score duration process
+	the voices concurrently when several threads are used. The threads are only
+	available when the library is built with atomic reference counting (see the
+	ATOMICREFS cmake option).
+	\param threads the threads count, 0 for the hardware threads count, 1 (the default) to disable the threads
+*/
+gar_export void				guidoSetVoiceThreads(unsigned threads);
+
 //--------------------------------------------------------------------------------
 // operations on scores
 //--------------------------------------------------------------------------------
@@ -67,6 +86,34 @@ gar_export const char*		guidoarVersionStr();
 */
 gar_export garErr			guido2unrolled(const char* gmn, std::ostream& out);
 
+/*! \brief gives the binary form of a score
+
+	The binary form is a compact form of the score abstract representation that is
+	read back without the gmn parser (see binary2guido).
+	\param gmn a string containing the gmn code
+	\param out a stream to output the binary form
+	\return an error code
+*/
+gar_export garErr			guido2binary(const char* gmn, std::ostream& out);
+
+/*! \brief converts the binary form of a score to gmn code
+
+	\param data the binary form of a score, as produced by guido2binary
+	\param size the data size
+	\param out a stream to output the gmn code
+	\return an error code
+*/
+gar_export garErr			binary2guido(const char* data, size_t size, std::ostream& out);
+
+/*! \brief writes a score to a score store file
+
+	A score store is a file from which the score voices are read on demand (see scorestore).
+	\param gmn a string containing the gmn code
+	\param file the output file name
+	\return an error code
+*/
+gar_export garErr			guido2store(const char* gmn, const char* file);
+
 /*! \brief transpose a score
 
 	Transposition of a score affects notes but also key signature when present. Between similar enharmonic
@@ -333,6 +380,18 @@ gar_export garErr			guidoVSetDuration(const char* gmn, rational duration, std::o
 */
 gar_export garErr			guidoVMultDuration(const char* gmn, float mult, std::ostream& out);
 
+/*! \brief applies a sequence of operations to a score
+
+	The score is parsed once, the operations are applied to the score in memory and the
+	result is printed once, which is equivalent to chaining the corresponding functions
+	above (see pipelineOperation for the pipeline syntax).
+	\param gmn a string containing the gmn code
+	\param pipeline the operations separated with ';' or new lines e.g. "transpose 2; head 1/2; top 1"
+	\param out the output stream
+	\return an error code
+*/
+gar_export garErr			guidoPipeline(const char* gmn, const char* pipeline, std::ostream& out);
+
 /*! \brief gives an event index at a given date
 	\param gmn a string containing gmn code
 	\param date a date expressed as a rational (1 is a whole note)
@@ -1,20 +1,25 @@
 
 #include "testInterface.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include "ARTypes.h"
+#include "gmnvisitor.h"
 #include "guidoparser.h"
 #include "guidoelement.h"
 #include "elementoperationvisitor.h"
 #include "ARNote.h"
 #include "ARFactory.h"
 #include "libguidoar.h"
-#include "tailOperation.h"
-#include "headOperation.h"
 #include "topOperation.h"
-#include "bottomOperation.h"
+#include "clonevisitor.h"
 #include "countvoicesvisitor.h"
 #include "durationvisitor.h"
 #include "seqOperation.h"
@@ -22,8 +27,12 @@
 #include "extendVisitor.h"
 #include "tagvisitor.h"
 #include "parOperation.h"
+#include "pipelineOperation.h"
 #include "removevoiceOperation.h"
+#include "sliceOperation.h"
 #include "transposeOperation.h"
+#include "voiceindexvisitor.h"
+#include "voicepool.h"
 #include "guidoelement.h"
 
 using std::cout;
@@ -39,11 +48,8 @@ using guido::ARFactory;
 using guido::NewNoteInfo;
 using guido::NamedNewNoteInfo;
 using guido::OpResult;
-using guido::tailOperation;
-using guido::headOperation;
 using guido::topOperation;
 using guido::countvoicesvisitor;
-using guido::bottomOperation;
 using guido::durationvisitor;
 using guido::seqOperation;
 using guido::getvoicesvisitor;
@@ -51,6 +57,7 @@ using guido::SARVoice;
 using guido::extendVisitor;
 using guido::tagvisitor;
 using guido::parOperation;
+using guido::sliceOperation;
 using guido::ARMusic;
 using guido::guidoattribute;
 
@@ -77,92 +84,295 @@ static SARMusic read (const char* buff)
 	return r.parseString(buff);
 }
 
+// The score held by a GarScoreHandle.  Operations that rebuild the score (transpose, voice
+// removal...) simply replace fScore.  The editor keeps the time index of the score from one
+// edit to the next: it has to be invalidated when the score is modified in place by anything
+// else than the editor itself (extension, added voice...).  The cache keeps the printed code
+// of the score, so that only the parts modified by the editor are printed again.
+struct GarScore {
+	Sguidoelement			fScore;
+	elementoperationvisitor	fEditor;
+	guido::gmncache			fCache;
+};
+
+// Reads the GMN data into a stack allocated handle, so the text based functions can share
+// the implementation of the handle based ones.
+static bool read (const char* buff, GarScore& score)
+{
+	score.fScore = read(buff);
+	return score.fScore != 0;
+}
+
 static char* getPersistentPointer(std::string stringObj) {
 	int len = int(stringObj.size());
 	char* textOutput = (char*)malloc(len + 2); // +2 to allow me to pad end
+	if (!textOutput) return nullptr;
 	memcpy(textOutput, stringObj.c_str(), len);
 	textOutput[len] = 0;
 	textOutput[len+1] = 0;
 	return textOutput;
 }
 
+// The error strings are returned like the scores: allocated with malloc, to be freed by the caller
+static char* errorString(const char* message) {
+	return getPersistentPointer(message);
+}
+
+// A handle given to the handle based methods must hold a score
+static bool valid(GarScoreHandle score) {
+	return score && score->fScore;
+}
 
-// ---------------------------------------[ Public Method Definitions ]---------------------------------------------
+// The rational operations throw overflow_error when a value doesn't fit a long.  The handle
+// methods report it as a failure, the score is restored by the edit snapshot and its cached text is dropped
+static OpResult overflowed(GarScoreHandle score) {
+	score->fCache.invalidate();
+	score->fEditor.invalidate();
+	return OpResult::failure;
+}
+
+// Saves the parts of a handle score that an edit may modify, and restores them when the edit
+// doesn't succeed (or throws).  The editor modifies the elements containers in place, but it
+// replaces the elements that it changes by copies: the saved containers are enough to undo an edit.
+class GarSnapshot {
+	public:
+				 GarSnapshot(GarScore& score) : fHandle(score), fScore(score.fScore), fKept(false) {}
+		virtual ~GarSnapshot() { if (!fKept) restore(); }
+		
+		// Saves the voices in a range, given in 0-based counting
+		void save(int startVoice, int endVoice) {
+			for (int v = std::max(startVoice, 0); v <= endVoice; v++) {
+				guido::voiceindexvisitor* index = fHandle.fEditor.voiceIndex(fScore, v);
+				if (!index) break;
+				saveTree(index->voice());
+			}
+		}
+		void save(int voice)	{ save(voice, voice); }
+		void saveAll()			{ saveTree(fScore); }
+		// The snapshot is dropped when the result is a success
+		OpResult keep(OpResult result) {
+			fKept = (result == OpResult::success);
+			return result;
+		}
+	
+	private:
+		void saveTree(const Sguidoelement& elt) {
+			fContainers.push_back(std::make_pair(elt, elt->elements()));
+			for (const auto& child: elt->elements())
+				if (child->size()) saveTree(child);
+		}
+		void restore() {
+			fHandle.fScore = fScore;
+			for (auto& c: fContainers) c.first->elements().swap(c.second);
+			fHandle.fEditor.invalidate();
+			fHandle.fCache.invalidate();
+		}
+		
+		GarScore&		fHandle;
+		Sguidoelement	fScore;
+		vector<std::pair<Sguidoelement, guido::guidoelement::branchs> > fContainers;
+		bool			fKept;
+};
+
+static std::atomic<bool> gCompactOutput(false);
+
+// An output stream buffer that hands the printed text to a write callback as it comes, so that
+// the score text doesn't need to be collected in a string and copied again.
+class callbackbuf : public std::streambuf {
+	GarWriteCallback	fWrite;
+	void*				fContext;
+	int					fSize;
+	
+	protected:
+		std::streamsize xsputn(const char* s, std::streamsize n) override {
+			fWrite(s, int(n), fContext);
+			fSize += int(n);
+			return n;
+		}
+		int overflow(int c) override {
+			if (c != EOF) { char ch = char(c); xsputn(&ch, 1); }
+			return c;
+		}
+	
+	public:
+		callbackbuf(GarWriteCallback write, void* context) : fWrite(write), fContext(context), fSize(0) {}
+		int size() const { return fSize; }
+};
+
+// Prints a score to a write callback and returns the size of the text
+static int printScore(const Sguidoelement& score, GarWriteCallback write, void* context) {
+	callbackbuf buf(write, context);
+	std::ostream os(&buf);
+	if (gCompactOutput) os << guido::gmncompact;
+	score->print(os);
+	return buf.size();
+}
+
+// A caller provided buffer, filled up to its size
+struct GarBuffer {
+	char*	fData;
+	int		fSize;
+	int		fUsed;
+};
+static void writeToBuffer(const char* data, int size, void* context) {
+	GarBuffer* buffer = static_cast<GarBuffer*>(context);
+	int n = std::min(size, buffer->fSize - buffer->fUsed);
+	if (n > 0) {
+		memcpy(buffer->fData + buffer->fUsed, data, n);
+		buffer->fUsed += n;
+	}
+}
+
+// A malloc'ed buffer that grows as needed, for the functions that return the score text
+// fData is null when an allocation failed: the buffer is released and the rest of the text is dropped
+struct GarText {
+	char*	fData;
+	size_t	fSize;
+	size_t	fCapacity;
+};
+static void writeToText(const char* data, int size, void* context) {
+	GarText* text = static_cast<GarText*>(context);
+	if (!text->fData) return;
+	if (text->fSize + size + 2 > text->fCapacity) {		// +2 to allow me to pad end
+		size_t capacity = std::max(text->fCapacity * 2, text->fSize + size + 2);
+		char* data = (char*)realloc(text->fData, capacity);
+		if (!data) {
+			free(text->fData);
+			text->fData = nullptr;
+			return;
+		}
+		text->fData = data;
+		text->fCapacity = capacity;
+	}
+	memcpy(text->fData + text->fSize, data, size);
+	text->fSize += size;
+}
+
+// Prints a score handle to a write callback, using the handle cache for the parts of the score
+// that have not been modified by the editor since the previous print
+static int printScore(GarScore& score, GarWriteCallback write, void* context) {
+	std::vector<size_t> modified;
+	if (score.fEditor.takeModified(modified)) {
+		for (size_t i = 0; i < modified.size(); i++) {
+			score.fCache.invalidate(i, modified[i]);
+		}
+	}
+	else score.fCache.invalidate();
+	
+	callbackbuf buf(write, context);
+	std::ostream os(&buf);
+	{
+		guido::gmnvisitor gv(os, false, gCompactOutput);
+		gv.print(score.fScore, score.fCache);
+	}		// the visitor output is flushed when it is destroyed
+	return buf.size();
+}
+
+// Prints a score or a score handle to a malloc'ed string
+template <typename T> static char* printScore(T& score) {
+	GarText text = { (char*)malloc(4096), 0, 4096 };
+	if (!text.fData) return nullptr;
+	printScore(score, writeToText, &text);
+	if (!text.fData) return nullptr;
+	text.fData[text.fSize] = 0;
+	text.fData[text.fSize+1] = 0;
+	return text.fData;
+}
+
+static char* errorResult(const char* what, int result) {
+	ostringstream oss;
+	oss << "ERROR Could not " << what << "!  Error code: " << result;
+	return getPersistentPointer(oss.str());
+}
+
+
+// -----------------------------------------[ Output Mode ]----------------------------------------------------
+
+void setCompactOutput(int compact) {
+	gCompactOutput = compact != 0;
+}
+
+void setVoiceThreads(int threads) {
+	guido::voicepool::setThreads (threads < 0 ? 1 : threads);
+}
+
+
+// ---------------------------------------[ Score Handle Definitions ]---------------------------------------------
+
+GarScoreHandle createScore(const char* scoreData) {
+	SARMusic score = read(scoreData);
+	if (!score) return nullptr;
+	GarScore* handle = new GarScore;
+	handle->fScore = score;
+	return handle;
+}
+
+void deleteScore(GarScoreHandle score) {
+	delete score;
+}
+
+char* scoreToString(GarScoreHandle score) {
+	if (!valid(score)) return nullptr;
+	return printScore(*score);
+}
+
+int scoreToBuffer(GarScoreHandle score, char* buffer, int bufferSize) {
+	if (!valid(score)) return -1;
+	GarBuffer out = { buffer, bufferSize - 1, 0 };		// -1 to keep room for the terminating null
+	int size = printScore(*score, writeToBuffer, &out);
+	if (bufferSize > 0) buffer[out.fUsed] = 0;
+	return size;
+}
+
+int scoreWrite(GarScoreHandle score, GarWriteCallback write, void* context) {
+	if (!valid(score) || !write) return -1;
+	return printScore(*score, write, context);
+}
 
 /**
- *  Reads in the file referenced as a Guido score, deletes the note in question,
- *  and then returns the text data for the new score.
+ *  Deletes the note in question from the score held by the handle.
  * 
  *  Voice is given in 1-based counting, and this method transfers it to 0-based counting.
  */
-char* deleteEvent(const char* scoreData, int num, int den, unsigned int voice, int midiPitch) {
-	// Read the score.  If that fails, return error code as a string.
-	SARMusic score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
-	
+int scoreDeleteEvent(GarScoreHandle score, int num, int den, unsigned int voice, int midiPitch) try {
+	if (!valid(score)) return OpResult::failure;
 	// Initialize the objects needed with raw parameter data
-	elementoperationvisitor visitor;
+	elementoperationvisitor& visitor = score->fEditor;
 	rational time = rational(num, den);
 	
 	// Run the delete routine
-	OpResult result = visitor.deleteEvent(score, time, voice-1, midiPitch);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not DELETE EVENT!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	return visitor.deleteEvent(score->fScore, time, voice-1, midiPitch);
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
 /**
- *  Reads in the file referenced as a Guido score, deletes the elements in the range
- *  given.  Returns the text data for the resulting score.
+ *  Deletes the elements in the range given from the score held by the handle.
  * 
  *  Voice is given in 1-based counting, and this method transfers it to 0-based counting.
  */
-char* deleteRange(const char* scoreData, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice) {
-	// Read the score.  If that fails, return error code as a string.
-	SARMusic score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
-	
+int scoreDeleteRange(GarScoreHandle score, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice) try {
+	if (!valid(score)) return OpResult::failure;
 	// Initialize the variables to pass in
-	elementoperationvisitor visitor;
+	elementoperationvisitor& visitor = score->fEditor;
 	rational startTime = rational(startNum, startDen);
 	rational endTime = rational(endNum, endDen);
 	
 	// Run the deleteRange method
-	OpResult result = visitor.deleteRange(score, startTime, endTime, startVoice-1, endVoice-1);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not DELETE RANGE!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	GarSnapshot snapshot(*score);
+	snapshot.save(startVoice-1, endVoice-1);
+	return snapshot.keep(visitor.deleteRange(score->fScore, startTime, endTime, startVoice-1, endVoice-1));
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
 /**
- *  Reads in the file referenced as a Guido score, inserts a note, and
- *  then returns the text data for the new score
+ *  Inserts a note in the score held by the handle, extending the score first if needed.
  * 
  *  Voice is given in 1-based counting, and this method transfers it to 0-based counting.
  */
-char* insertNote(const char* scoreData, int startNum, int startDen, int durNum, int durDen, int midiPitch, int voice, int dots, int insistedAccidental) {
-	// Read the score.  If that fails, return error code as a string.
-	Sguidoelement score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
-	
+int scoreInsertNote(GarScoreHandle score, int startNum, int startDen, int durNum, int durDen, int midiPitch, int voice, int dots, int insistedAccidental) try {
+	if (!valid(score)) return OpResult::failure;
 	// Initialize the objects needed with raw parameter data
-	elementoperationvisitor visitor;
+	elementoperationvisitor& visitor = score->fEditor;
 	// Create the note that we will insert
 	NewNoteInfo noteInfo;
 	noteInfo.durStartNum = startNum;
@@ -174,38 +384,27 @@ char* insertNote(const char* scoreData, int startNum, int startDen, int durNum,
 	noteInfo.dots = dots;
 	noteInfo.insistedAccidental = insistedAccidental;
 	
-	// If we need to, extend the base score
-	durationvisitor dvis;
-	rational scoreDur = dvis.duration(score);
+	// If we need to, extend the base score (the score duration is taken from the editor time index)
+	GarSnapshot snapshot(*score);
 	rational noteStartDur = rational(startNum, startDen);
 	rational insertNoteDur = rational(durNum, durDen);
-	if (scoreDur < noteStartDur + insertNoteDur) {
+	if (visitor.duration(score->fScore) < noteStartDur + insertNoteDur) {
+		snapshot.saveAll();
 		guido::extendVisitor extender;
-		score = extender.extend(score, noteStartDur + insertNoteDur);
+		score->fScore = extender.extend(score->fScore, noteStartDur + insertNoteDur);
+		visitor.invalidate();
 	}
+	else snapshot.save(voice-1);
 	
-	// Run the delete routine
-	OpResult result = visitor.insertNote(score, noteInfo);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not INSERT NOTE!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	// Run the insert routine
+	return snapshot.keep(visitor.insertNote(score->fScore, noteInfo));
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
-char* insertNoteWithNameOct(const char* scoreData, int startNum, int startDen, int durNum, int durDen, char* noteName, int octave, int voice) {
-	// Read the score.  If that fails, return error code as a string.
-	Sguidoelement score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
-	
+int scoreInsertNoteWithNameOct(GarScoreHandle score, int startNum, int startDen, int durNum, int durDen, char* noteName, int octave, int voice) try {
+	if (!valid(score)) return OpResult::failure;
 	// Initialize the objects needed with raw parameter data
-	elementoperationvisitor visitor;
+	elementoperationvisitor& visitor = score->fEditor;
 	// Create the note that we will insert
 	NamedNewNoteInfo info;
 	info.name = noteName;
@@ -216,138 +415,72 @@ char* insertNoteWithNameOct(const char* scoreData, int startNum, int startDen, i
 	info.durLengthDen = durDen;
 	info.voice = voice-1;
 	
-	// If we need to, extend the base score
-	durationvisitor dvis;
-	rational scoreDur = dvis.duration(score);
+	// If we need to, extend the base score (the score duration is taken from the editor time index)
+	GarSnapshot snapshot(*score);
 	rational noteStartDur = rational(startNum, startDen);
 	rational insertNoteDur = rational(durNum, durDen);
-	if (scoreDur < noteStartDur + insertNoteDur) {
+	if (visitor.duration(score->fScore) < noteStartDur + insertNoteDur) {
+		snapshot.saveAll();
 		guido::extendVisitor extender;
-		score = extender.extend(score, noteStartDur + insertNoteDur);
+		score->fScore = extender.extend(score->fScore, noteStartDur + insertNoteDur);
+		visitor.invalidate();
 	}
+	else snapshot.save(voice-1);
 	
-	// Run the delete routine
-	OpResult result = visitor.insertNamedNote(score, info);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not INSERT NAMED NOTE!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	// Run the insert routine
+	return snapshot.keep(visitor.insertNamedNote(score->fScore, info));
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
-char* setDurationAndDots(const char* scoreData, int elStartNum, int elStartDen, int voice, int newDurNum, int newDurDen, int newDots) {
-	// Read the score.  If that fails, return error code as a string.
-	SARMusic score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
-	
+int scoreSetDurationAndDots(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int newDurNum, int newDurDen, int newDots) try {
+	if (!valid(score)) return OpResult::failure;
 	rational desiredDur;
 	if (newDurNum == 0 || newDurDen == 0) desiredDur = rational(0, 1);
 	else desiredDur = rational(newDurNum, newDurDen);
 	
-	elementoperationvisitor visitor;
-	OpResult result = visitor.setDurationAndDots(score, rational(elStartNum, elStartDen), voice-1, desiredDur, newDots);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not SET DURATION AND DOTS!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	elementoperationvisitor& visitor = score->fEditor;
+	GarSnapshot snapshot(*score);
+	snapshot.save(voice-1);
+	return snapshot.keep(visitor.setDurationAndDots(score->fScore, rational(elStartNum, elStartDen), voice-1, desiredDur, newDots));
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
-char* setAccidental(const char* scoreData, int elStartNum, int elStartDen, int voice, int midiPitch, int newAccidental, int* resultPitch) {
-	if (elStartDen == 0) return "ERROR Start Duration denominator cannot be zero!";
-	if (voice < 0) return "ERROR Voice cannot be < 0!";
+int scoreSetAccidental(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int midiPitch, int newAccidental, int* resultPitch) try {
+	if (!valid(score)) return OpResult::failure;
+	if (elStartDen == 0 || voice < 0) return OpResult::failure;
 	
-	// Read the score.  If that fails, return error code as a string.
-	SARMusic score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
-	
-	elementoperationvisitor visitor;
-	
-	OpResult result = visitor.setAccidental(score, rational(elStartNum, elStartDen), voice-1, midiPitch, newAccidental, resultPitch);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not SET ACCIDENTAL!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	elementoperationvisitor& visitor = score->fEditor;
+	return visitor.setAccidental(score->fScore, rational(elStartNum, elStartDen), voice-1, midiPitch, newAccidental, resultPitch);
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
-char* setNotePitch(const char* scoreData, int elStartNum, int elStartDen, int voice, int oldPitch, int newPitch) {
-	if (elStartDen == 0) return "ERROR Start Duration denominator cannot be zero!";
-	if (voice < 0) return "ERROR Voice cannot be < 0!";
+int scoreSetNotePitch(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int oldPitch, int newPitch) try {
+	if (!valid(score)) return OpResult::failure;
+	if (elStartDen == 0 || voice < 0) return OpResult::failure;
 	
-	// Read the score.  If that fails, return error code as a string.
-	SARMusic score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
-	
-	elementoperationvisitor visitor;
-	OpResult result = visitor.setNotePitch(score, rational(elStartNum, elStartDen), voice-1, oldPitch, newPitch);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not SET NOTE PITCH!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	elementoperationvisitor& visitor = score->fEditor;
+	return visitor.setNotePitch(score->fScore, rational(elStartNum, elStartDen), voice-1, oldPitch, newPitch);
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
-char* shiftNotePitch(const char* scoreData, int elStartNum, int elStartDen, int voice, int midiPitch, int pitchShiftDirection, int octaveShift, int* resultPitch) {
-	if (elStartDen == 0) return "ERROR Start Duration denominator cannot be zero!";
-	if (voice < 0) return "ERROR Voice cannot be < 0!";
-	
-	// Read the score.  If that fails, return error code as a string.
-	SARMusic score = read(scoreData);
-	if (!score) return "ERROR Error reading score!  (No score operation performed)";
+int scoreShiftNotePitch(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int midiPitch, int pitchShiftDirection, int octaveShift, int* resultPitch) try {
+	if (!valid(score)) return OpResult::failure;
+	if (elStartDen == 0 || voice < 0) return OpResult::failure;
 	
 	// Normalize the pitch shift direction to be +/- 1, or zero
 	if (pitchShiftDirection != 0) {
 		pitchShiftDirection /= abs(pitchShiftDirection);
 	}
 	
-	elementoperationvisitor visitor;
-	
-	OpResult result = visitor.shiftNotePitch(score, rational(elStartNum, elStartDen), voice-1, midiPitch, pitchShiftDirection, octaveShift, resultPitch);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not SHIFT NOTE PITCH!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	elementoperationvisitor& visitor = score->fEditor;
+	return visitor.shiftNotePitch(score->fScore, rational(elStartNum, elStartDen), voice-1, midiPitch, pitchShiftDirection, octaveShift, resultPitch);
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
-char* shiftRangeNotePitch(const char* scoreData, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice, int pitchShiftDirection, int octaveShift) {
-	if (startDen == 0 || endDen == 0) return "ERROR Duration denominators cannot be zero!";
-	if (startVoice < 0 || endVoice < 0) return "ERROR Voices cannot be < 0!";
-	
-	// Read the score.  If that fails, return error code as a string.
-	SARMusic score = read(scoreData);
-	if (!score) return "ERROR Couldn't read score!  (No score operation performed)";
+int scoreShiftRangeNotePitch(GarScoreHandle score, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice, int pitchShiftDirection, int octaveShift) try {
+	if (!valid(score)) return OpResult::failure;
+	if (startDen == 0 || endDen == 0) return OpResult::failure;
+	if (startVoice < 0 || endVoice < 0) return OpResult::failure;
 	
 	// Normalize the pitch shift direction to be +/- 1, or zero
 	if (pitchShiftDirection != 0) {
@@ -358,10 +491,9 @@ char* shiftRangeNotePitch(const char* scoreData, int startNum, int startDen, int
 	rational startTime = rational(startNum, startDen);
 	rational endTime = rational(endNum, endDen);
 	
-	elementoperationvisitor visitor;
-	
-	OpResult result = visitor.shiftRangeNotePitch(
-		score,
+	elementoperationvisitor& visitor = score->fEditor;
+	return visitor.shiftRangeNotePitch(
+		score->fScore,
 		startTime,
 		endTime,
 		startVoice-1,
@@ -369,25 +501,16 @@ char* shiftRangeNotePitch(const char* scoreData, int startNum, int startDen, int
 		pitchShiftDirection,
 		octaveShift
 	);
-	ostringstream oss;
-	
-	// If an error happened, return info about what it was
-	if (result != OpResult::success) {
-		oss << "ERROR Could not SHIFT RANGE PITCH!  Error code: " << result;
-		return getPersistentPointer(oss.str());
-	}
-	
-	// Otherwise, return the score
-	score->print(oss);
-	return getPersistentPointer(oss.str());
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
 // Pass in voices in 1-based counting. This is adjust them.
-char* getSelection(const char* scoreData, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice) {
+char* scoreGetSelection(GarScoreHandle handle, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice) try {
+	if (!valid(handle)) return errorString("ERROR Invalid score handle");
 	// Read and verify times
 	rational startTime = rational(startNum, startDen);
 	rational endTime = rational(endNum, endDen);
-	if (startTime == endTime) return "ERROR selection was length of zero";
+	if (startTime == endTime) return errorString("ERROR selection was length of zero");
 	if (startTime > endTime) {
 		// Swap times so (start < end)
 		rational temp = endTime;
@@ -395,9 +518,8 @@ char* getSelection(const char* scoreData, int startNum, int startDen, int endNum
 		startTime = temp;
 	}
 	
-	// Read the score.  If that fails, return error code as a string.
-	Sguidoelement score = read(scoreData);
-	if (!score) return "ERROR Couldn't read score!  (No score operation performed)";
+	// The slice operation produces a new score: the handle is left unchanged
+	Sguidoelement score = handle->fScore;
 	
 	countvoicesvisitor voiceCounter;
 	int voices = voiceCounter.count(score);
@@ -410,35 +532,23 @@ char* getSelection(const char* scoreData, int startNum, int startDen, int endNum
 	if (startVoice < 0) startVoice = 0;
 	if (endVoice > voices) endVoice = voices;
 	
-	// Do cut operations
-	topOperation toperation;
-	score = toperation(score, endVoice+1);  // +1 because it keeps the top X voices, and we changed X to be 0-based counting
-	bottomOperation bottomOperation;
-	score = bottomOperation(score, startVoice);
-	
-	if (! score) return "ERROR Score didn't make it through the voice cutting operations";
-	
-	tailOperation tailOperator;
-	score = tailOperator(score, startTime, false);
-	headOperation headOperator;
-	score = headOperator(score, endTime - startTime);
+	// Extract the selection, without the tags in effect at the start time.  The slice seeks
+	// the start time using the time index kept by the handle editor
+	sliceOperation slice;
+	slice.setIndex(&handle->fEditor);
+	score = slice(score, startTime, endTime, startVoice, endVoice, false);
 	
-	if (! score) return "ERROR Score didn't make it through the duration cutting operations";
+	if (! score) return errorString("ERROR Score didn't make it through the slice operation");
 	
 	// Return string
-	ostringstream oss;
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	return printScore(score);
 }
+catch (const std::overflow_error&) { return errorString("ERROR Overflow while computing the selection"); }
 
-char* pasteToDuration(const char* scoreData, const char* selectionData, int startNum, int startDen, int startVoice) {
+// Returns noActionTaken when either the score or the selection has no voice
+static OpResult pasteSelection(GarScoreHandle handle, Sguidoelement selection, int startNum, int startDen, int startVoice) try {
 	rational startDur = rational(startNum, startDen);
-	
-	// Read the score and selection.  If that fails, return error code as a string.
-	Sguidoelement score = read(scoreData);
-	if (!score) return "ERROR Couldn't read SCORE!  (No score operation performed)";
-	Sguidoelement selection = read(selectionData);
-	if (!selection) return "ERROR Couldn't read SELECTION!  (No score operation performed)";
+	Sguidoelement& score = handle->fScore;
 	
 	// Count how many voices are in the score and selection
 	countvoicesvisitor voiceCounter;
@@ -446,7 +556,7 @@ char* pasteToDuration(const char* scoreData, const char* selectionData, int star
 	int selectionVoices = voiceCounter.count(selection);
 	
 	// If the voice counts don't line up, deal with it
-	if (scoreVoices == 0 || selectionVoices == 0) return "ERROR Either score or selection have zero voices";
+	if (scoreVoices == 0 || selectionVoices == 0) return OpResult::noActionTaken;
 	if (selectionVoices > scoreVoices) {
 		// Cut the bottom voices off of the selection so it fits into score
 		topOperation toperation;
@@ -459,58 +569,69 @@ char* pasteToDuration(const char* scoreData, const char* selectionData, int star
 	int largestPossibleStartVoice = scoreVoices - selectionVoices;
 	if (startVoice > largestPossibleStartVoice) startVoice = largestPossibleStartVoice;
 	
-	// Find how long the score and selection are
+	// Find how long the score and selection are (the score duration is taken from the editor time index)
+	elementoperationvisitor& visitor = handle->fEditor;
+	rational scoreDur = visitor.duration(score);
 	durationvisitor dvis;
-	rational scoreDur = dvis.duration(score);
 	rational selectionDur = dvis.duration(selection);
 	
+	// The paste may extend the score and edit several voices
+	GarSnapshot snapshot(*handle);
+	snapshot.saveAll();
+	
 	// If we need to, extend the base score
 	if (scoreDur < selectionDur + startDur) {
 		guido::extendVisitor extender;
 		score = extender.extend(score, selectionDur + startDur);
+		visitor.invalidate();
 	}
 	
 	getvoicesvisitor gvv;
 	vector<SARVoice> selectionVoiceList = gvv(selection);
-	elementoperationvisitor visitor;
 	for (int i = 0; i < selectionVoiceList.size(); i++) {
 		OpResult result = visitor.insertRange(score, selectionVoiceList.at(i), startDur, startVoice + i, selectionDur);
-		if (result != OpResult::success) {
-			ostringstream oss;
-			oss << "ERROR Could not INSERT RANGE!  Error code: " << result;
-			return getPersistentPointer(oss.str());
-		}
+		if (result != OpResult::success) return snapshot.keep(result);
 	}
-	
-	// Return string
-	ostringstream oss;
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	return snapshot.keep(OpResult::success);
 }
+catch (const std::overflow_error&) { return overflowed(handle); }
 
-VoiceInfo* getVoicesInfo(const char* scoreData, int* voiceCountOut) {
-	Sguidoelement score = read(scoreData);
-	if (!score) {
+int scorePasteToDuration(GarScoreHandle score, const char* selectionData, int startNum, int startDen, int startVoice) {
+	if (!valid(score)) return OpResult::failure;
+	Sguidoelement selection = read(selectionData);
+	if (!selection) return OpResult::failure;
+	return pasteSelection(score, selection, startNum, startDen, startVoice);
+}
+
+// The returned list is allocated with malloc and should be freed by the caller
+VoiceInfo* scoreGetVoicesInfo(GarScoreHandle score, int* voiceCountOut) {
+	if (voiceCountOut) *voiceCountOut = 0;
+	if (!valid(score) || !voiceCountOut) return nullptr;
+	getvoicesvisitor gvv;
+	tagvisitor tv;
+	vector<SARVoice> voices = gvv(score->fScore);
+	*voiceCountOut = int(voices.size());
+	if (*voiceCountOut == 0) return nullptr;
+	
+	VoiceInfo* outList = (VoiceInfo*)malloc(voices.size() * sizeof(VoiceInfo));
+	if (!outList) {
 		*voiceCountOut = 0;
 		return nullptr;
 	}
-	
-	getvoicesvisitor gvv;
-	tagvisitor tv;
-	vector<SARVoice> voices = gvv(score);
-	const int vals = voices.size();
-	std::vector<VoiceInfo> outList;
 	for (int i = 0; i < voices.size(); i++) {
 		guido::VoiceInitInfo vInfo = tv.getVoiceInfo(voices.at(i));
-		VoiceInfo info;
+		VoiceInfo& info = outList[i];
+		info.voiceNum = i + 1;
 		if (vInfo.clef) {
 			info.initClef = getPersistentPointer(vInfo.clef->getAttributeValue(0).c_str());
 		} else {
-			info.initClef = "none";
+			info.initClef = getPersistentPointer("none");
 		}
 		
-		guido::Sguidoattribute instrCodeAttr = vInfo.instr->getAttribute("MIDI");
 		info.initInstrCode = -1;
+		info.initInstrName = nullptr;
+		if (!vInfo.instr) continue;
+		guido::Sguidoattribute instrCodeAttr = vInfo.instr->getAttribute("MIDI");
 		if (instrCodeAttr) { info.initInstrCode = stoi(instrCodeAttr->getValue()); }
 		guido::Sguidoattribute instrNameAttr = vInfo.instr->getAttribute("name");
 		if (instrNameAttr) {
@@ -518,27 +639,19 @@ VoiceInfo* getVoicesInfo(const char* scoreData, int* voiceCountOut) {
 		} else {
 			info.initInstrName = getPersistentPointer(vInfo.instr->getAttributeValue(0));
 		}
-		outList.push_back(info);
 	}
-	// Output the information
-	*voiceCountOut = outList.size();
-	if (*voiceCountOut == 0) return nullptr;
-	return &outList.at(0);
+	return outList;
 }
 
-char* addBlankVoice(const char* scoreData) {
-	SARMusic score = read(scoreData);
-	if (!score) {
-		return "ERROR Could not parse score data! (No action performed)";
-	}
-	
+// Returns failure when the score has no voice to take the initial tags from
+int scoreAddBlankVoice(GarScoreHandle score) try {
+	if (!valid(score)) return OpResult::failure;
 	// Get score length
-	durationvisitor dvis;
-	rational scoreDur = dvis.duration(score);
+	rational scoreDur = score->fEditor.duration(score->fScore);
 	// Get the voices
 	getvoicesvisitor gvv;
-	vector<SARVoice> voices = gvv(score);
-	if (voices.size() == 0) return "ERROR Score has no voices!";
+	vector<SARVoice> voices = gvv(score->fScore);
+	if (voices.size() == 0) return OpResult::failure;
 	// Get the information about the reference voice
 	SARVoice reference = voices.at(voices.size()-1);
 	tagvisitor tv;
@@ -564,80 +677,261 @@ char* addBlankVoice(const char* scoreData) {
 	newVoice->push(tag);
 	newVoice->push(barFormat_tag);
 	lastAccoladeId += 1;
-	// Insert the Target's clef, key signature, meter, and instrument
-	if (vInfo.instr) newVoice->push(vInfo.instr);
-	if (vInfo.clef) newVoice->push(vInfo.clef);
+	// Insert copies of the Target's clef, key signature, meter, and instrument (the tags must not be
+	// shared: editing the instrument of one voice would change the other one)
+	guido::clonevisitor cv;
+	if (vInfo.instr) newVoice->push(cv.clone(vInfo.instr));
+	if (vInfo.clef) newVoice->push(cv.clone(vInfo.clef));
 	else newVoice->push(ARFactory().createTag("clef"));
-	if (vInfo.keySignature) newVoice->push(vInfo.keySignature);
-	if (vInfo.meter) newVoice->push(vInfo.meter);
+	if (vInfo.keySignature) newVoice->push(cv.clone(vInfo.keySignature));
+	if (vInfo.meter) newVoice->push(cv.clone(vInfo.meter));
 	// Pass Target to extend visitor
 	extendVisitor extV;
 	Sguidoelement extendedVoice = extV.extend(newVoice, scoreDur);
 	// Push Target to score
-	score->push(extendedVoice);
-	
-	ostringstream oss;
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	score->fScore->push(extendedVoice);
+	score->fEditor.invalidate();
+	return OpResult::success;
 }
+catch (const std::overflow_error&) { return overflowed(score); }
 
-char* deleteVoice(const char* scoreData, int voiceToDelete) {
-	Sguidoelement score = read(scoreData);
-	if (!score) {
-		return "ERROR Could not parse score data! (No action performed)";
-	}
-	
+// Returns noActionTaken when asked to delete the last voice of the score
+int scoreDeleteVoice(GarScoreHandle score, int voiceToDelete) try {
+	if (!valid(score)) return OpResult::failure;
 	countvoicesvisitor cvv;
-	int count = cvv.count(score);
-	if (count == 1) {
-		return "ERROR Cannot delete the last voice!";
-	}
+	int count = cvv.count(score->fScore);
+	if (count == 1) return OpResult::noActionTaken;
 	
 	guido::removeVoiceOperation rvo;
-	score = rvo(score, voiceToDelete);
+	Sguidoelement result = rvo(score->fScore, voiceToDelete);
+	if (!result) return OpResult::failure;
+	score->fScore = result;
+	return OpResult::success;
+}
+catch (const std::overflow_error&) { return overflowed(score); }
+
+int scoreSetVoiceInitInstrument(GarScoreHandle score, int voice, const char* instrumentName, int instrumentCode) try {
+	if (!valid(score)) return OpResult::failure;
+	elementoperationvisitor& visitor = score->fEditor;
+	return visitor.setVoiceInstrument(score->fScore, voice-1, instrumentName, instrumentCode);
+}
+catch (const std::overflow_error&) { return overflowed(score); }
+
+int scoreTranspose(GarScoreHandle score, int stepChange) try {
+	if (!valid(score)) return OpResult::failure;
+	guido::transposeOperation trop;
+	Sguidoelement result = trop(score->fScore, stepChange);
+	if (!result) return OpResult::failure;
+	score->fScore = result;
+	return OpResult::success;
+}
+catch (const std::overflow_error&) { return overflowed(score); }
+
+int scorePipeline(GarScoreHandle score, const char* pipeline) try {
+	if (!valid(score)) return OpResult::failure;
+	guido::pipelineOperation op;
+	if (!pipeline || !op.parse(pipeline)) return OpResult::failure;
+	Sguidoelement result = op(score->fScore);
+	if (!result) return OpResult::failure;
+	score->fScore = result;
+	return OpResult::success;
+}
+catch (const std::overflow_error&) { return overflowed(score); }
+
+
+// ---------------------------------------[ Public Method Definitions ]---------------------------------------------
+
+// The text based methods read the score into a temporary handle, run the corresponding handle
+// method and return the resulting score as text (or an error string).
+
+char* deleteEvent(const char* scoreData, int num, int den, unsigned int voice, int midiPitch) {
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
 	
-	// Return string
-	ostringstream oss;
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	int result = scoreDeleteEvent(&score, num, den, voice, midiPitch);
+	if (result != OpResult::success) return errorResult("DELETE EVENT", result);
+	return printScore(score.fScore);
 }
 
-char* setVoiceInitInstrument(const char* scoreData, int voice, const char* instrumentName, int instrumentCode) {
-	Sguidoelement score = read(scoreData);
-	if (!score) {
-		return "ERROR Could not parse score data! (No action performed)";
-	}
+char* deleteRange(const char* scoreData, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice) {
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
+	
+	int result = scoreDeleteRange(&score, startNum, startDen, endNum, endDen, startVoice, endVoice);
+	if (result != OpResult::success) return errorResult("DELETE RANGE", result);
+	return printScore(score.fScore);
+}
+
+char* insertNote(const char* scoreData, int startNum, int startDen, int durNum, int durDen, int midiPitch, int voice, int dots, int insistedAccidental) {
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
+	
+	int result = scoreInsertNote(&score, startNum, startDen, durNum, durDen, midiPitch, voice, dots, insistedAccidental);
+	if (result != OpResult::success) return errorResult("INSERT NOTE", result);
+	return printScore(score.fScore);
+}
+
+char* insertNoteWithNameOct(const char* scoreData, int startNum, int startDen, int durNum, int durDen, char* noteName, int octave, int voice) {
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
+	
+	int result = scoreInsertNoteWithNameOct(&score, startNum, startDen, durNum, durDen, noteName, octave, voice);
+	if (result != OpResult::success) return errorResult("INSERT NAMED NOTE", result);
+	return printScore(score.fScore);
+}
+
+char* setDurationAndDots(const char* scoreData, int elStartNum, int elStartDen, int voice, int newDurNum, int newDurDen, int newDots) {
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
+	
+	int result = scoreSetDurationAndDots(&score, elStartNum, elStartDen, voice, newDurNum, newDurDen, newDots);
+	if (result != OpResult::success) return errorResult("SET DURATION AND DOTS", result);
+	return printScore(score.fScore);
+}
+
+char* setAccidental(const char* scoreData, int elStartNum, int elStartDen, int voice, int midiPitch, int newAccidental, int* resultPitch) {
+	if (elStartDen == 0) return errorString("ERROR Start Duration denominator cannot be zero!");
+	if (voice < 0) return errorString("ERROR Voice cannot be < 0!");
+	
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
+	
+	int result = scoreSetAccidental(&score, elStartNum, elStartDen, voice, midiPitch, newAccidental, resultPitch);
+	if (result != OpResult::success) return errorResult("SET ACCIDENTAL", result);
+	return printScore(score.fScore);
+}
+
+char* setNotePitch(const char* scoreData, int elStartNum, int elStartDen, int voice, int oldPitch, int newPitch) {
+	if (elStartDen == 0) return errorString("ERROR Start Duration denominator cannot be zero!");
+	if (voice < 0) return errorString("ERROR Voice cannot be < 0!");
+	
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
 	
-	elementoperationvisitor visitor;
-	OpResult result = visitor.setVoiceInstrument(score, voice-1, instrumentName, instrumentCode);
+	int result = scoreSetNotePitch(&score, elStartNum, elStartDen, voice, oldPitch, newPitch);
+	if (result != OpResult::success) return errorResult("SET NOTE PITCH", result);
+	return printScore(score.fScore);
+}
+
+char* shiftNotePitch(const char* scoreData, int elStartNum, int elStartDen, int voice, int midiPitch, int pitchShiftDirection, int octaveShift, int* resultPitch) {
+	if (elStartDen == 0) return errorString("ERROR Start Duration denominator cannot be zero!");
+	if (voice < 0) return errorString("ERROR Voice cannot be < 0!");
+	
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Error reading score!  (No score operation performed)");
+	
+	int result = scoreShiftNotePitch(&score, elStartNum, elStartDen, voice, midiPitch, pitchShiftDirection, octaveShift, resultPitch);
+	if (result != OpResult::success) return errorResult("SHIFT NOTE PITCH", result);
+	return printScore(score.fScore);
+}
+
+char* shiftRangeNotePitch(const char* scoreData, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice, int pitchShiftDirection, int octaveShift) {
+	if (startDen == 0 || endDen == 0) return errorString("ERROR Duration denominators cannot be zero!");
+	if (startVoice < 0 || endVoice < 0) return errorString("ERROR Voices cannot be < 0!");
+	
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Couldn't read score!  (No score operation performed)");
+	
+	int result = scoreShiftRangeNotePitch(&score, startNum, startDen, endNum, endDen, startVoice, endVoice, pitchShiftDirection, octaveShift);
+	if (result != OpResult::success) return errorResult("SHIFT RANGE PITCH", result);
+	return printScore(score.fScore);
+}
+
+// Pass in voices in 1-based counting. This is adjust them.
+char* getSelection(const char* scoreData, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice) {
+	if (rational(startNum, startDen) == rational(endNum, endDen)) return errorString("ERROR selection was length of zero");
+	
+	// Read the score.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Couldn't read score!  (No score operation performed)");
 	
-	if (result != OpResult::success) {
-		ostringstream oss;
-		oss << "ERROR Could not set voice instrument!  Error code: " << result;
-		return getPersistentPointer(oss.str());
+	return scoreGetSelection(&score, startNum, startDen, endNum, endDen, startVoice, endVoice);
+}
+
+char* pasteToDuration(const char* scoreData, const char* selectionData, int startNum, int startDen, int startVoice) {
+	// Read the score and selection.  If that fails, return error code as a string.
+	GarScore score;
+	if (!read(scoreData, score)) return errorString("ERROR Couldn't read SCORE!  (No score operation performed)");
+	Sguidoelement selection = read(selectionData);
+	if (!selection) return errorString("ERROR Couldn't read SELECTION!  (No score operation performed)");
+	
+	OpResult result = pasteSelection(&score, selection, startNum, startDen, startVoice);
+	if (result == OpResult::noActionTaken) return errorString("ERROR Either score or selection have zero voices");
+	if (result != OpResult::success) return errorResult("INSERT RANGE", result);
+	return printScore(score.fScore);
+}
+
+VoiceInfo* getVoicesInfo(const char* scoreData, int* voiceCountOut) {
+	GarScore score;
+	if (!read(scoreData, score)) {
+		*voiceCountOut = 0;
+		return nullptr;
+	}
+	return scoreGetVoicesInfo(&score, voiceCountOut);
+}
+
+char* addBlankVoice(const char* scoreData) {
+	GarScore score;
+	if (!read(scoreData, score)) {
+		return errorString("ERROR Could not parse score data! (No action performed)");
 	}
 	
-	// Otherwise, return success!
-	ostringstream oss;
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	if (scoreAddBlankVoice(&score) != OpResult::success) return errorString("ERROR Score has no voices!");
+	return printScore(score.fScore);
 }
 
-char* transposeScore(const char* scoreData, int stepChange) {
-	Sguidoelement score = read(scoreData);
-	if (!score) {
-		return "ERROR Could not parse score data! (No action performed)";
+char* deleteVoice(const char* scoreData, int voiceToDelete) {
+	GarScore score;
+	if (!read(scoreData, score)) {
+		return errorString("ERROR Could not parse score data! (No action performed)");
 	}
 	
-	guido::transposeOperation trop;
-	score = trop(score, stepChange);
+	if (scoreDeleteVoice(&score, voiceToDelete) != OpResult::success) {
+		return errorString("ERROR Cannot delete the last voice!");
+	}
+	return printScore(score.fScore);
+}
+
+char* setVoiceInitInstrument(const char* scoreData, int voice, const char* instrumentName, int instrumentCode) {
+	GarScore score;
+	if (!read(scoreData, score)) {
+		return errorString("ERROR Could not parse score data! (No action performed)");
+	}
 	
-	if (!score) {
-		return "ERROR Failed to transpose score";
+	int result = scoreSetVoiceInitInstrument(&score, voice, instrumentName, instrumentCode);
+	if (result != OpResult::success) return errorResult("set voice instrument", result);
+	return printScore(score.fScore);
+}
+
+char* transposeScore(const char* scoreData, int stepChange) {
+	GarScore score;
+	if (!read(scoreData, score)) {
+		return errorString("ERROR Could not parse score data! (No action performed)");
 	}
 	
-	// Otherwise, return success!
-	ostringstream oss;
-	score->print(oss);
-	return getPersistentPointer(oss.str());
+	if (scoreTranspose(&score, stepChange) != OpResult::success) {
+		return errorString("ERROR Failed to transpose score");
+	}
+	return printScore(score.fScore);
+}
+
+char* applyPipeline(const char* scoreData, const char* pipeline) {
+	GarScore score;
+	if (!read(scoreData, score)) {
+		return errorString("ERROR Could not parse score data! (No action performed)");
+	}
+
+	if (scorePipeline(&score, pipeline) != OpResult::success) {
+		return errorString("ERROR Failed to apply the pipeline");
+	}
+	return printScore(score.fScore);
 }
@@ -17,6 +17,22 @@ typedef struct vinforaw VoiceInfo;
 
 #include "arexport.h"
 
+/*! \brief Selects how the functions below print the scores they return.
+
+	The compact form is intended for machine to machine exchanges: no indentation nor line breaks,
+	no redundant spaces, and the octaves and durations equal to the implicit ones are omitted.
+	The default is the human readable form.
+	
+	\param compact 1 for the compact form, 0 for the human readable form
+*/
+gar_export void setCompactOutput(int compact);
+
+/*! \brief Sets the number of threads used to process the voices of a score (see guidoSetVoiceThreads).
+
+	\param threads the threads count, 0 for the hardware threads count, 1 (the default) to disable the threads
+*/
+gar_export void setVoiceThreads(int threads);
+
 /*! \brief Deletes an event that starts at the given duration in the form num/den, on the given voice.
 
 	If midiPitch is not -1, the pitch will also be used to match to find the right event to
@@ -89,6 +105,95 @@ gar_export char* setVoiceInitInstrument(const char* scoreData, int voice, const
 
 gar_export char* transposeScore(const char* scoreData, int stepChange);
 
+/*! \brief Applies a sequence of operations to a score (see guidoPipeline).
+
+	\param scoreData The GMN data for the score
+	\param pipeline The operations, e.g. "transpose 2; head 1/2; top 1"
+	\return the resulting GMN data, or an error string
+*/
+gar_export char* applyPipeline(const char* scoreData, const char* pipeline);
+
+// Persistent Score Handles
+
+/*! \brief An opaque handle on a parsed score.
+
+	The functions above parse their input and print their result on every call. A score handle
+	keeps the parsed score in memory instead: edits are applied in place and the score is only
+	printed when \c scoreToString is called.
+	
+	Unless otherwise stated, the edit functions below take the same parameters as their text based
+	equivalent and return the resulting OpResult code (1 is success). They fail when given a NULL
+	handle. An edit that doesn't succeed leaves the score as it was before the call, and the
+	handle remains usable.
+*/
+typedef struct GarScore* GarScoreHandle;
+
+/*! \brief Parses GMN data into a new score handle.
+
+	\param scoreData The GMN data for the score
+	\return a handle on the score, or NULL if the data can't be parsed.  Release it with \c deleteScore.
+*/
+gar_export GarScoreHandle createScore(const char* scoreData);
+/*! \brief Releases a score handle and the score it holds. */
+gar_export void deleteScore(GarScoreHandle score);
+/*! \brief Prints the current state of a score.
+
+	\return the GMN data of the score, to be freed by the caller, or NULL when it can't be allocated.
+*/
+gar_export char* scoreToString(GarScoreHandle score);
+
+/*! \brief Prints the current state of a score into a caller provided buffer.
+
+	The buffer can be reused from one edit to the next. Like snprintf, the text is truncated to
+	bufferSize - 1 characters and is always null terminated (when bufferSize > 0).
+	
+	\param buffer the buffer that receives the GMN data (may be NULL when bufferSize is 0)
+	\param bufferSize the size of the buffer
+	\return the size of the complete GMN data, without the terminating null (the buffer is too small
+	when the result is >= bufferSize), or -1 for an invalid handle. Passing a size of 0 queries the
+	required size.
+*/
+gar_export int scoreToBuffer(GarScoreHandle score, char* buffer, int bufferSize);
+
+/*! \brief A callback that receives the GMN data of a score piece by piece.
+
+	\param data a chunk of the GMN data, not null terminated and only valid during the call
+	\param size the size of the chunk
+	\param context the context given to \c scoreWrite
+*/
+typedef void (*GarWriteCallback)(const char* data, int size, void* context);
+
+/*! \brief Prints the current state of a score to a callback, without any intermediate copy.
+
+	\return the total size of the GMN data, or -1 for an invalid handle or callback
+*/
+gar_export int scoreWrite(GarScoreHandle score, GarWriteCallback write, void* context);
+
+gar_export int scoreDeleteEvent(GarScoreHandle score, int num, int den, unsigned int voice, int midiPitch);
+gar_export int scoreDeleteRange(GarScoreHandle score, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice);
+gar_export int scoreInsertNote(GarScoreHandle score, int startNum, int startDen, int durNum, int durDen, int midiPitch, int voice, int dots, int insistedAccidental);
+gar_export int scoreInsertNoteWithNameOct(GarScoreHandle score, int startNum, int startDen, int durNum, int durDen, char* noteName, int octave, int voice);
+gar_export int scoreSetDurationAndDots(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int newDurNum, int newDurDen, int newDots);
+gar_export int scoreSetAccidental(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int midiPitch, int newAccidental, int* resultPitch);
+gar_export int scoreSetNotePitch(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int oldPitch, int newPitch);
+gar_export int scoreShiftNotePitch(GarScoreHandle score, int elStartNum, int elStartDen, int voice, int midiPitch, int pitchShiftDirection, int octaveShift, int* resultPitch);
+gar_export int scoreShiftRangeNotePitch(GarScoreHandle score, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice, int pitchShiftDirection, int octaveShift);
+
+/*! \brief Gives the GMN data of a time/voice selection of a score (the score itself is left unchanged).
+
+	\return the selection GMN data or an error string, to be freed by the caller.
+*/
+gar_export char* scoreGetSelection(GarScoreHandle score, int startNum, int startDen, int endNum, int endDen, int startVoice, int endVoice);
+gar_export int scorePasteToDuration(GarScoreHandle score, const char* selectionData, int startNum, int startDen, int startVoice);
+
+gar_export VoiceInfo* scoreGetVoicesInfo(GarScoreHandle score, int* voiceCountOut);
+gar_export int scoreAddBlankVoice(GarScoreHandle score);
+gar_export int scoreDeleteVoice(GarScoreHandle score, int voiceToDelete);
+gar_export int scoreSetVoiceInitInstrument(GarScoreHandle score, int voice, const char* instrumentName, int instrumentCode);
+
+gar_export int scoreTranspose(GarScoreHandle score, int stepChange);
+gar_export int scorePipeline(GarScoreHandle score, const char* pipeline);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,7 @@
 #include <stack>
 #include <vector>
 #include <iterator>
+#include <utility>
 #include "gar_smartpointer.h"
 #include "visitable.h"
 
@@ -94,7 +95,7 @@ template <typename T> class treeIterator : public std::iterator<std::input_itera
 				 treeIterator(const treeIterator& a)  { *this = a; }
 		virtual ~treeIterator() {}
 		
-		T operator  *() const	{ return *fCurrentIterator; }
+		const T& operator  *() const	{ return *fCurrentIterator; }
 		T operator ->() const	{ return *fCurrentIterator; } 
 		treeIterator& operator ++()		{ forward(); return *this; }
 		treeIterator& operator ++(int)	{ forward(); return *this; }
@@ -150,9 +151,12 @@ template <typename T> class ctree : virtual public smartable
 		branchs& elements()						{ return fElements; }		
 		const branchs& elements() const			{ return fElements; }		
 		virtual void push (const treePtr& t)	{ fElements.push_back(t); }
-		virtual void push (const branchs& b)	{ const_literator i;
-			for (i = b.begin(); i != b.end(); i++)
-				fElements.push_back(*i); 
+		virtual void push (treePtr&& t)			{ fElements.push_back(std::move(t)); }
+		virtual void push (const branchs& b)	{ fElements.insert(fElements.end(), b.begin(), b.end()); }
+		//! transfers the elements of b: b is left in an unspecified state
+		virtual void push (branchs&& b)	{
+			if (fElements.empty()) fElements.swap(b);
+			else fElements.insert(fElements.end(), std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
 		}
 		virtual int  size  () const				{ return int(fElements.size()); }
 		virtual bool empty () const				{ return fElements.size()==0; }
@@ -34,35 +34,79 @@
 #else
 
 #include <cassert>
+#include <cstddef>
+
+// the configuration generated by the cmake build, when available
+#if defined(__has_include)
+# if __has_include("garconfig.h")
+#  include "garconfig.h"
+# endif
+#endif
+
+#ifdef GAR_ATOMIC_REFCOUNT
+#include <atomic>
+#endif
 #include "arexport.h"
 
 namespace guido
 {
 
+class garena;
+
 /*!
 \brief the base class for smart pointers implementation
 
 	Any object that want to support smart pointers should
 	inherit from the smartable class which provides reference counting
 	and automatic delete when the reference count drops to zero.
+\n	When GAR_ATOMIC_REFCOUNT is defined (see the ATOMICREFS cmake option), the
+	reference count is atomic and objects that are not modified any more (e.g. a
+	parsed score) may be shared between threads. The cmake build records the
+	setting in the installed garconfig.h, so that the client code is compiled
+	with the library layout. Other builds must define the symbol the same way
+	for the library and for the client code.
+\n	An object may also be allocated in an arena (see garena): it is then
+	destroyed in place and its memory is released with the arena.
 */
 class gar_export smartable {
 	private:
+#ifdef GAR_ATOMIC_REFCOUNT
+		std::atomic<unsigned> refCount;
+#else
 		unsigned 	refCount;		
+#endif
+		garena*		fArena;			// the arena that holds the object memory (if any)
+		void		release();
 	public:
 		//! gives the reference count of the object
+#ifdef GAR_ATOMIC_REFCOUNT
+		unsigned refs() const         { return refCount.load(std::memory_order_relaxed); }
+		//! addReference increments the ref count and checks for refCount overflow
+		void addReference()           { unsigned n = refCount.fetch_add(1, std::memory_order_relaxed); assert(n + 1 != 0); (void)n; }
+		//! removeReference delete the object when refCount is zero		
+		void removeReference()		  { if (refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) { if (fArena) release(); else delete this; } }
+#else
 		unsigned refs() const         { return refCount; }
 		//! addReference increments the ref count and checks for refCount overflow
 		void addReference()           { refCount++; assert(refCount != 0); }
 		//! removeReference delete the object when refCount is zero		
-		void removeReference()		  { if (--refCount == 0) delete this; }
+		void removeReference()		  { if (--refCount == 0) { if (fArena) release(); else delete this; } }
+#endif
+
+		//! allocates an object in an arena, or on the heap when the arena is null
+		static void* operator new (size_t size, garena* arena);
+		static void  operator delete (void* ptr, garena* arena);
+		static void* operator new (size_t size)		{ return ::operator new(size); }
+		static void  operator delete (void* ptr)	{ ::operator delete(ptr); }
 		
 	protected:
-		smartable() : refCount(0) {}
-		smartable(const smartable&): refCount(0) {}
+		smartable() : refCount(0), fArena(0) {}
+		smartable(const smartable&): refCount(0), fArena(0) {}
 		//! destructor checks for non-zero refCount
 		virtual ~smartable()    { assert (refCount == 0); }
 		smartable& operator=(const smartable&) { return *this; }
+		//! to be called on objects allocated with the arena operator new
+		void setArena (garena* arena);
 };
 
 /*!
@@ -76,6 +120,7 @@ class gar_export smartable {
 	methods in a consistent way).
 */
 template<class T> class SMARTP {
+	template<class T2> friend class SMARTP;
 	private:
 		//! the actual pointer to the class
 		T* fSmartPtr;
@@ -90,6 +135,11 @@ template<class T> class SMARTP {
 		SMARTP(const SMARTP<T2>& ptr) : fSmartPtr((T*)ptr) { if (fSmartPtr) fSmartPtr->addReference(); }
 		//! build a smart pointer from another smart pointer reference
 		SMARTP(const SMARTP& ptr) : fSmartPtr((T*)ptr)     { if (fSmartPtr) fSmartPtr->addReference(); }
+		//! build a smart pointer from a temporary smart pointer: takes over its reference
+		SMARTP(SMARTP&& ptr) noexcept : fSmartPtr(ptr.fSmartPtr) { ptr.fSmartPtr = 0; }
+		//! build a smart pointer from a temporary convertible smart pointer: takes over its reference
+		template<class T2>
+		SMARTP(SMARTP<T2>&& ptr) noexcept : fSmartPtr((T*)ptr.fSmartPtr) { ptr.fSmartPtr = 0; }
 
 		//! the smart pointer destructor: simply removes one reference count
 		~SMARTP()  { if (fSmartPtr) fSmartPtr->removeReference(); }
@@ -132,6 +182,16 @@ template<class T> class SMARTP {
 		bool operator<(const SMARTP<T>& p_)	const			  { return fSmartPtr < ((T *) p_); }
 		//! operator = to support inherited class reference
 		SMARTP& operator=(const SMARTP<T>& p_)                { return operator=((T *) p_); }
+		//! operator = that takes over the reference of a temporary smart pointer
+		SMARTP& operator=(SMARTP<T>&& p_) noexcept {
+			if (this != &p_) {
+				T* old = fSmartPtr;
+				fSmartPtr = p_.fSmartPtr;
+				p_.fSmartPtr = 0;
+				if (old != 0) old->removeReference();
+			}
+			return *this;
+		}
 		//! dynamic cast support
 		template<class T2> SMARTP& cast(T2* p_)               { return operator=(dynamic_cast<T*>(p_)); }
 		//! dynamic cast support
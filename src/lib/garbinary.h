@@ -0,0 +1,118 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifndef __garbinary__
+#define __garbinary__
+
+#include <string>
+
+namespace guido
+{
+
+/*!
+\addtogroup generic
+@{
+*/
+
+//______________________________________________________________________________
+/*!
+\brief	The binary form of a guido abstract representation.
+
+	The binary form is written by binaryvisitor and read by binaryreader.
+	It starts with the 4 bytes kMagic followed by the format version and the
+	root element. An element is written as:
+	- its kind (see node) and flags (see flags)
+	- its name, as a string reference
+	- the kind specific data: the duration, dots, octave and accidental of
+	  notes, the id of tags, the tick base and header of the music, the
+	  comments before a voice
+	- its attributes and sub elements, when the corresponding flags are set
+	- the kind specific trailing data: the music footer, the comments after a voice
+
+	All the integers are written as variable length numbers: 7 bits per byte,
+	the least significant first, the high bit set on all bytes but the last one.
+	The signed integers are zigzag encoded first (0, -1, 1, -2...).
+	The strings are interned: a string reference is the index of the string in
+	the table of the strings already read. An index equal to the table size
+	introduces a new string, followed by its length and its bytes.
+	An attribute is written as its name and unit references, its type (see
+	attribute) and its value: a string reference, a signed integer or the 8
+	bytes of a double (little endian).
+*/
+namespace garbinary
+{
+	static const char	kMagic[] = "GARB";
+	enum { kMagicSize = 4, kVersion = 1 };
+
+	//! the kinds of elements
+	enum node { kElement, kMusic, kVoice, kChord, kNote, kTag, kComment, kVariable, kNodeEnd };
+	//! the element flags
+	enum flags { kAuto = 1, kAttributes = 2, kElements = 4 };
+	//! the attribute type (the guidoattribute type) and flags
+	enum attribute { kTypeMask = 3, kQuote = 4 };
+
+	//! appends an unsigned number
+	inline void putnum (std::string& out, unsigned long v)
+	{
+		while (v >= 0x80) {
+			out += char((v & 0x7f) | 0x80);
+			v >>= 7;
+		}
+		out += char(v);
+	}
+
+	//! appends a signed number
+	inline void putsigned (std::string& out, long v)
+	{
+		putnum (out, (v < 0) ? ((~(unsigned long)v) << 1) | 1 : (unsigned long)v << 1);
+	}
+
+	/*! \brief reads an unsigned number
+		\param data the data pointer, moved after the number
+		\param end the data end
+		\param v on output, the number
+		\return false when the number is invalid or truncated
+	*/
+	inline bool getnum (const unsigned char*& data, const unsigned char* end, unsigned long& v)
+	{
+		v = 0;
+		for (int shift = 0; (shift < 64) && (data < end); shift += 7) {
+			unsigned char c = *data++;
+			v |= (unsigned long)(c & 0x7f) << shift;
+			if (!(c & 0x80)) return true;
+		}
+		return false;
+	}
+
+	//! reads a signed number
+	inline bool getsigned (const unsigned char*& data, const unsigned char* end, long& v)
+	{
+		unsigned long n;
+		if (!getnum (data, end, n)) return false;
+		v = (n & 1) ? long(~(n >> 1)) : long(n >> 1);
+		return true;
+	}
+}
+
+/*! @} */
+
+} // namespace
+
+#endif
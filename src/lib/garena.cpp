@@ -0,0 +1,87 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#include <new>
+
+#include "garena.h"
+
+namespace guido
+{
+
+//______________________________________________________________________________
+// smartable arena support
+//______________________________________________________________________________
+void* smartable::operator new (size_t size, garena* arena)
+{
+	return arena ? arena->allocate(size) : ::operator new(size);
+}
+
+// only called when a constructor throws
+void smartable::operator delete (void* ptr, garena* arena)
+{
+	if (!arena) ::operator delete(ptr);
+}
+
+void smartable::setArena (garena* arena)
+{
+	fArena = arena;
+	if (arena) arena->addReference();
+}
+
+// destroys an object allocated in an arena: the memory stays in the arena
+// until the arena itself is deleted
+void smartable::release ()
+{
+	garena* arena = fArena;
+	this->~smartable();
+	arena->removeReference();
+}
+
+//______________________________________________________________________________
+// garena
+//______________________________________________________________________________
+SMARTP<garena> garena::create(size_t blocksize)
+	{ garena* o = new garena(blocksize); assert(o!=0); return o; }
+
+garena::~garena()
+{
+	for (size_t i=0; i < fBlocks.size(); i++)
+		::operator delete (fBlocks[i]);
+}
+
+//______________________________________________________________________________
+void* garena::allocate (size_t size)
+{
+	const size_t align = alignof(std::max_align_t);
+	size = (size + align - 1) & ~(align - 1);
+	if (size > fLeft) {
+		size_t blocksize = (size > fBlockSize) ? size : fBlockSize;
+		fCurrent = (char*)::operator new (blocksize);
+		fBlocks.push_back (fCurrent);
+		fLeft = blocksize;
+		fSize += blocksize;
+	}
+	void* ptr = fCurrent;
+	fCurrent += size;
+	fLeft -= size;
+	return ptr;
+}
+
+} // namespace
@@ -0,0 +1,79 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifndef __garena__
+#define __garena__
+
+#include <cstddef>
+#include <vector>
+
+#include "arexport.h"
+#include "gar_smartpointer.h"
+
+namespace guido
+{
+
+/*!
+\addtogroup generic
+@{
+*/
+
+//______________________________________________________________________________
+/*!
+\brief	A memory arena for smartable objects.
+
+	Objects allocated in an arena are taken from large memory blocks instead
+	of being allocated one by one on the heap. They are still reference counted:
+	when an object count drops to zero, it is destroyed but its memory is not
+	released. The memory blocks are released in one shot when the arena and all
+	the objects it contains are gone (each object holds a reference to its arena).
+
+	An arena is typically used to hold a parsed score (see guidoparser).
+	Like the reference counting, an arena is not thread safe.
+*/
+class gar_export garena : public smartable {
+	public:
+		enum { kDefaultBlockSize = 64*1024 };
+
+		static SMARTP<garena> create(size_t blocksize = kDefaultBlockSize);
+
+		//! allocates size bytes in the arena
+		void*	allocate (size_t size);
+		//! the total size of the memory blocks
+		size_t	size () const		{ return fSize; }
+
+	protected:
+				 garena(size_t blocksize) : fCurrent(0), fLeft(0), fBlockSize(blocksize), fSize(0) {}
+		virtual ~garena();
+
+	private:
+		std::vector<char*>	fBlocks;
+		char*	fCurrent;
+		size_t	fLeft;
+		size_t	fBlockSize;
+		size_t	fSize;
+};
+typedef SMARTP<garena> Sgarena;
+
+/*! @} */
+
+} // namespace
+
+#endif
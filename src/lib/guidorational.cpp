@@ -21,9 +21,12 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <climits>
 #include <sstream>
+#include <stdexcept>
 #include <cmath>
 #include "guidorational.h"
+#include "strnum.h"
 
 using namespace std;
 
@@ -32,9 +35,11 @@ namespace guido
 
 string rational::toString() const
 {
-    ostringstream res;
-    res << fNumerator << "/" << fDenominator;
-    return res.str();
+	string res;
+	appendnum (res, fNumerator);
+	res += '/';
+	appendnum (res, fDenominator);
+	return res;
 }
 
 rational::operator string() const
@@ -66,7 +71,8 @@ rational::rational(const string &str)
     denom = strstr(cstr,"/");
     if (denom) ++denom;
     fNumerator = atol(cstr);
-    if (denom) fDenominator = atol(denom);
+    fDenominator = denom ? atol(denom) : 1;
+    if (fDenominator == 0) fDenominator = 1;
 }
 
 rational::rational(long int num, long int denom) : fNumerator(num), fDenominator(denom)
@@ -81,89 +87,187 @@ rational::rational(const rational& d)
     fDenominator = d.fDenominator;
 }
 
-rational rational::operator +(const rational &dur) const {
-    return rational(fNumerator * dur.fDenominator + dur.fNumerator * fDenominator, fDenominator * dur.fDenominator);
-}
+//______________________________________________________________________________
+// overflow checked arithmetic
+//______________________________________________________________________________
+static void overflow ()		{ throw overflow_error("guido::rational overflow"); }
 
-rational rational::operator -(const rational &dur) const {
-    return rational(fNumerator * dur.fDenominator - dur.fNumerator * fDenominator, fDenominator * dur.fDenominator);
+#if defined(__GNUC__) || defined(__clang__)
+static inline long mul (long a, long b)	{ long r; if (__builtin_mul_overflow(a, b, &r)) overflow(); return r; }
+static inline long add (long a, long b)	{ long r; if (__builtin_add_overflow(a, b, &r)) overflow(); return r; }
+static inline long sub (long a, long b)	{ long r; if (__builtin_sub_overflow(a, b, &r)) overflow(); return r; }
+static inline int  ctz (unsigned long v)	{ return __builtin_ctzl(v); }
+#else
+static inline long mul (long a, long b)
+{
+	if (a > 0) {
+		if ((b > 0) ? (a > LONG_MAX / b) : (b < LONG_MIN / a)) overflow();
+	}
+	else if (a < 0) {
+		if ((b > 0) ? (a < LONG_MIN / b) : (b && (b < LONG_MAX / a))) overflow();
+	}
+	return a * b;
+}
+static inline long add (long a, long b)
+{
+	if (((b > 0) && (a > LONG_MAX - b)) || ((b < 0) && (a < LONG_MIN - b))) overflow();
+	return a + b;
 }
+static inline long sub (long a, long b)
+{
+	if (((b < 0) && (a > LONG_MAX + b)) || ((b > 0) && (a < LONG_MIN + b))) overflow();
+	return a - b;
+}
+static inline int ctz (unsigned long v)	{ int n = 0; while (!(v & 1)) { v >>= 1; n++; } return n; }
+#endif
+
+static inline bool powerOf2 (long v)	{ return (v > 0) && !(v & (v - 1)); }
 
-rational rational::operator *(const rational &dur) const {
-    return rational(fNumerator * dur.fNumerator, fDenominator * dur.fDenominator);
+//______________________________________________________________________________
+// compares a/b and c/d (b and d > 0) without multiplying (i.e. without overflow)
+// using their continued fraction expansion
+static int compare (long a, long b, long c, long d)
+{
+	long q1 = a / b, r1 = a % b;
+	if (r1 < 0) { q1--; r1 += b; }
+	long q2 = c / d, r2 = c % d;
+	if (r2 < 0) { q2--; r2 += d; }
+	if (q1 != q2) return (q1 < q2) ? -1 : 1;
+	if (!r1 || !r2) return (r1 == r2) ? 0 : (r1 ? 1 : -1);
+	return compare (d, r2, b, r1);		// r1/b < r2/d if and only if d/r2 < b/r1
 }
 
-rational rational::operator /(const rational &dur) const {
-    return rational(fNumerator * dur.fDenominator, fDenominator * dur.fNumerator);
+static int compare (const rational& r1, const rational& r2)
+{
+	long a = r1.getNumerator(), b = r1.getDenominator();
+	long c = r2.getNumerator(), d = r2.getDenominator();
+	if (b == d) return (a == c) ? 0 : ((a < c) == (b > 0) ? -1 : 1);
+	if (!b || !d) {						// invalid values: compared as before
+		long ad = a * d, bc = b * c;
+		return (ad == bc) ? 0 : ((ad < bc) ? -1 : 1);
+	}
+	if (b < 0) { a = -a; b = -b; }
+	if (d < 0) { c = -c; d = -d; }
+#if defined(__GNUC__) || defined(__clang__)
+	long ad, bc;
+	if (!__builtin_mul_overflow(a, d, &ad) && !__builtin_mul_overflow(b, c, &bc))
+		return (ad == bc) ? 0 : ((ad < bc) ? -1 : 1);
+#endif
+	return compare (a, b, c, d);
+}
+
+//______________________________________________________________________________
+// binary gcd of the absolute values of a and b
+static inline long bgcd (long a1, long b1)
+{
+	unsigned long a = (a1 < 0) ? 0UL - (unsigned long)a1 : (unsigned long)a1;
+	unsigned long b = (b1 < 0) ? 0UL - (unsigned long)b1 : (unsigned long)b1;
+	if (!a || !b) return (a | b) ? long(a | b) : 1;
+
+	int shift = ctz(a | b);
+	a >>= ctz(a);
+	do {
+		b >>= ctz(b);
+		if (a > b) { unsigned long t = a; a = b; b = t; }
+		b -= a;
+	} while (b);
+	return long(a << shift);
 }
 
-rational rational::operator *(int num) const {
-	return rational(fNumerator * num, fDenominator);
+long int rational::gcd(long int a, long int b)	{ return bgcd(a, b); }
+
+//______________________________________________________________________________
+// sets r to the normalized value of n/d
+static inline rational& normalize (rational& r, long n, long d)
+{
+	if (!n) d = 1;
+	else if (powerOf2(d)) {				// the common case of durations: no gcd needed
+		int shift = ctz(n < 0 ? 0UL - (unsigned long)n : (unsigned long)n);
+		int dshift = ctz(d);
+		if (dshift < shift) shift = dshift;
+		n >>= shift;					// exact: n is a multiple of 2^shift
+		d >>= shift;
+	}
+	else if (d) {
+		if (d < 0) { n = sub(0, n); d = sub(0, d); }
+		long g = bgcd(n, d);
+		n /= g;
+		d /= g;
+	}
+	r.set (n, d ? d : 1);				// don't allow zero denominators!
+	return r;
 }
 
-rational rational::operator /(int num) const {
-	return rational(fNumerator, fDenominator * num);
+rational& rational::rationalise()
+{
+	return normalize (*this, fNumerator, fDenominator);
 }
 
+//______________________________________________________________________________
+// arithmetic operators
+//______________________________________________________________________________
 rational& rational::operator +=(const rational &dur)
 {
-    if(fDenominator == dur.fDenominator) {
-		fNumerator += dur.fNumerator;
-	} else {
-		fNumerator = fNumerator * dur.fDenominator + dur.fNumerator * fDenominator;
-		fDenominator *= dur.fDenominator;
+	long b = fDenominator, d = dur.fDenominator;
+	if (b == d)
+		return normalize (*this, add(fNumerator, dur.fNumerator), b);
+	if (powerOf2(b) && powerOf2(d)) {		// the common denominator is the greatest one
+		if (b > d) return normalize (*this, add(fNumerator, mul(dur.fNumerator, 1L << (ctz(b) - ctz(d)))), b);
+		return normalize (*this, add(mul(fNumerator, 1L << (ctz(d) - ctz(b))), dur.fNumerator), d);
 	}
-    return (*this);
+	// general case: a/b + c/d = (a * d/g + c * b/g) / (b/g * d) where g = gcd(b,d)
+	long g = bgcd(b, d);
+	b /= g;
+	long n = add(mul(fNumerator, d / g), mul(dur.fNumerator, b));
+	return normalize (*this, n, mul(b, d));
 }
 
 rational& rational::operator -=(const rational &dur)
 {
-	if(fDenominator == dur.fDenominator) {
-		fNumerator -= dur.fNumerator;
-	} else {
-		fNumerator = fNumerator * dur.fDenominator - dur.fNumerator * fDenominator;
-		fDenominator *= dur.fDenominator;
-    }
-	return (*this);
+	if (dur.fNumerator == LONG_MIN) overflow();
+	return *this += rational(-dur.fNumerator, dur.fDenominator);
 }
 
 rational& rational::operator *=(const rational &dur)
 {
-	fNumerator   *= dur.fNumerator;
-    fDenominator *= dur.fDenominator;
-    return (*this);
+	// cross reduction before multiplying limits the risk of overflow
+	long g1 = bgcd(fNumerator, dur.fDenominator);
+	long g2 = bgcd(dur.fNumerator, fDenominator);
+	return normalize (*this, mul(fNumerator / g1, dur.fNumerator / g2), mul(fDenominator / g2, dur.fDenominator / g1));
 }
 
 rational& rational::operator /=(const rational &dur)
 {
-    fNumerator   *= dur.fDenominator;
-    fDenominator *= dur.fNumerator;
-    return (*this);
+	if (!dur.fNumerator) {				// division by zero: the denominator is set to 1
+		fNumerator = mul (fNumerator, dur.fDenominator);
+		fDenominator = 1;
+		return *this;
+	}
+	return *this *= rational(dur.fDenominator, dur.fNumerator);
 }
 
+rational& rational::operator *=(long int num)	{ return *this *= rational(num, 1); }
+rational& rational::operator /=(long int num)	{ return *this /= rational(num, 1); }
+
+rational rational::operator +(const rational &dur) const	{ rational r(*this); return r += dur; }
+rational rational::operator -(const rational &dur) const	{ rational r(*this); return r -= dur; }
+rational rational::operator *(const rational &dur) const	{ rational r(*this); return r *= dur; }
+rational rational::operator /(const rational &dur) const	{ rational r(*this); return r /= dur; }
+rational rational::operator *(int num) const				{ rational r(*this); return r *= long(num); }
+rational rational::operator /(int num) const				{ rational r(*this); return r /= long(num); }
+
 rational& rational::operator =(const rational& dur) {
     fNumerator   = dur.fNumerator;
     fDenominator = dur.fDenominator;
     return (*this);
 }
 
-bool rational::operator >(const rational &dur) const
-{
-    // a/b > c/d if and only if a * d > b * c.
-    return ((fNumerator * dur.fDenominator) > (fDenominator * dur.fNumerator));
-}
-
-bool rational::operator <(const rational &dur) const
-{
-    // a/b < c/d if and only if a * d < b * c.
-    return ((fNumerator * dur.fDenominator) < (fDenominator * dur.fNumerator));
-}
-
-bool rational::operator ==(const rational &dur) const
-{
-    // a/b < c/d if and only if a * d < b * c.
-    return ((fNumerator * dur.fDenominator) == (fDenominator * dur.fNumerator));
-}
+//______________________________________________________________________________
+// comparison operators
+//______________________________________________________________________________
+bool rational::operator >(const rational &dur) const	{ return compare(*this, dur) > 0; }
+bool rational::operator <(const rational &dur) const	{ return compare(*this, dur) < 0; }
+bool rational::operator ==(const rational &dur) const	{ return compare(*this, dur) == 0; }
 
 bool rational::operator >(double num) const
 {	
@@ -190,42 +294,92 @@ bool rational::operator ==(double num) const
 	return (toDouble() == num);
 }
 
-// gcd(a, b) calculates the gcd of a and b using Euclid's algorithm.
-long int rational::gcd(long int a1, long int b1)
+double rational::toDouble() const
 {
-    long int r;
+    return (fDenominator != 0) ? ((double)fNumerator/(double)fDenominator) : 0;
+}
 
-    long int a = (long int)abs(double(a1));
-    long int b = (long int)abs(double(b1));
+float rational::toFloat() const
+{
+    return (fDenominator != 0) ? ((float)fNumerator/(float)fDenominator) : 0;
+}
 
-    if (!(a == 0) || (b == 0)){
-        while (b > 0){
-            r = a % b;
-            a = b;
-            b = r;
-        }
-        return a;
-    }
-    return 1;
+//______________________________________________________________________________
+// base note values decomposition
+//______________________________________________________________________________
+basedurations::basedurations(const rational& duration, bool useDot)
+	: fRest(0), fOdd(1), fShift(0), fLevel(0), fDot(useDot)
+{
+	rational r = duration;
+	r.rationalise();
+	if (r.getNumerator() <= 0) return;
+	fRest = r.getNumerator();
+	fShift = ctz (r.getDenominator());
+	fOdd = r.getDenominator() >> fShift;
+	// a dotted value may leave a remainder of half the smallest unit
+	if (fDot && (fShift < 62) && (fRest <= LONG_MAX / 2)) {
+		fRest *= 2;
+		fShift++;
+	}
 }
 
-rational& rational::rationalise()
+//______________________________________________________________________________
+// the values at a given level can be counted with divisions, since only the
+// whole note level may repeat a value
+size_t basedurations::size() const
 {
-    long int g = gcd(fNumerator, fDenominator);
-    fNumerator /= g;
-    fDenominator /= g;
-    if (fNumerator == 0) fDenominator = 1;
-	return *this;
+	size_t n = 0;
+	long rest = fRest;
+	for (int level = fLevel; rest && (level <= fShift); level++) {
+		long plain = 1L << (fShift - level);
+		if (fDot && (level < fShift)) {
+			long dotted = plain + plain / 2;
+			n += rest / dotted;
+			rest %= dotted;
+		}
+		n += rest / plain;
+		rest %= plain;
+	}
+	return n;
 }
 
-double rational::toDouble() const
+//______________________________________________________________________________
+bool basedurations::next(rational& dur, int& dots)
 {
-    return (fDenominator != 0) ? ((double)fNumerator/(double)fDenominator) : 0;
+	while (fRest && (fLevel <= fShift)) {
+		long plain = 1L << (fShift - fLevel);
+		if (fDot && (fLevel < fShift) && (fRest >= plain + plain / 2)) {
+			fRest -= plain + plain / 2;
+			dots = 1;
+		}
+		else if (fRest >= plain) {
+			fRest -= plain;
+			dots = 0;
+		}
+		else {
+			fLevel++;
+			continue;
+		}
+		dur.set (1, (1L << fLevel) * fOdd);
+		return true;
+	}
+	return false;
 }
 
-float rational::toFloat() const
+//______________________________________________________________________________
+vector<rational> rational::getBaseRationals(const rational& input, bool useDot, vector<int>* dotsOutput)
 {
-    return (fDenominator != 0) ? ((float)fNumerator/(float)fDenominator) : 0;
+	vector<rational> output;
+	if (useDot && !dotsOutput) return output;	// the dots must go somewhere
+
+	basedurations values (input, useDot);
+	output.reserve (values.size());
+	rational dur; int dots;
+	while (values.next (dur, dots)) {
+		output.push_back (dur);
+		if (dotsOutput) dotsOutput->push_back (dots);
+	}
+	return output;
 }
 
 ostream& operator << (ostream& os, rational r) {
@@ -25,7 +25,7 @@
 #ifndef __singleton__
 #define __singleton__
 
-// warning: this is NOT a thread safe implementation
+// the instance initialization is thread safe with C++11 compilers (static local variables)
 template <typename T> class singleton {
 	public:
 		static T& instance () {
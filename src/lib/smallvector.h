@@ -0,0 +1,208 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifndef __smallvector__
+#define __smallvector__
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace guido
+{
+
+/*!
+\addtogroup generic
+@{
+*/
+
+//______________________________________________________________________________
+/*!
+\brief	A vector that stores up to N elements inline.
+
+	The elements are stored in the object itself as long as there are no more
+	than N, which avoids a heap allocation for small lists (typically the
+	attributes of an element). Beyond N elements, they move to the heap.
+	The interface is the subset of std::vector used in the library.
+	Iterators are plain pointers, invalidated by any insertion or removal.
+*/
+template <typename T, unsigned N> class smallvector
+{
+	public:
+		typedef T			value_type;
+		typedef size_t		size_type;
+		typedef T*			iterator;
+		typedef const T*	const_iterator;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+
+				 smallvector() : fSize(0), fCapacity(N) {}
+				 smallvector(const smallvector& v) : fSize(0), fCapacity(N)	{ insert (end(), v.begin(), v.end()); }
+				 smallvector(smallvector&& v) : fSize(0), fCapacity(N)		{ take (v); }
+				~smallvector()		{ clear(); release(); }
+
+		smallvector& operator= (const smallvector& v) {
+			if (this != &v) {
+				clear();
+				insert (end(), v.begin(), v.end());
+			}
+			return *this;
+		}
+		smallvector& operator= (smallvector&& v) {
+			if (this != &v) {
+				clear();
+				release();
+				take (v);
+			}
+			return *this;
+		}
+
+		iterator		begin()			{ return data(); }
+		iterator		end()			{ return data() + fSize; }
+		const_iterator	begin() const	{ return data(); }
+		const_iterator	end() const		{ return data() + fSize; }
+
+		size_type	size() const		{ return fSize; }
+		size_type	capacity() const	{ return fCapacity; }
+		bool		empty() const		{ return fSize == 0; }
+
+		reference		operator[] (size_type i)		{ return data()[i]; }
+		const_reference	operator[] (size_type i) const	{ return data()[i]; }
+		reference		at (size_type i)				{ check(i); return data()[i]; }
+		const_reference	at (size_type i) const			{ check(i); return data()[i]; }
+		reference		front()			{ return data()[0]; }
+		const_reference	front() const	{ return data()[0]; }
+		reference		back()			{ return data()[fSize-1]; }
+		const_reference	back() const	{ return data()[fSize-1]; }
+
+		void reserve (size_type n)		{ if (n > fCapacity) grow (n); }
+
+		void push_back (const T& elt) {
+			if (fSize == fCapacity) {
+				T copy(elt);			// elt may be an element of the vector
+				grow (fCapacity * 2);
+				new (end()) T(std::move(copy));
+			}
+			else new (end()) T(elt);
+			fSize++;
+		}
+		void push_back (T&& elt) {
+			if (fSize == fCapacity) {
+				T moved(std::move(elt));
+				grow (fCapacity * 2);
+				new (end()) T(std::move(moved));
+			}
+			else new (end()) T(std::move(elt));
+			fSize++;
+		}
+		void pop_back ()				{ data()[--fSize].~T(); }
+
+		template <typename It> iterator insert (iterator pos, It first, It last) {
+			size_type index = pos - begin();
+			size_type n = 0;
+			for (It i = first; i != last; i++) n++;
+			if (!n) return pos;
+			if (fSize + n > fCapacity) {
+				smallvector tmp;		// the source range may belong to the vector
+				tmp.reserve (fSize + n);
+				for (iterator i = begin(); i != begin() + index; i++) tmp.push_back (std::move(*i));
+				for (It i = first; i != last; i++) tmp.push_back (*i);
+				for (iterator i = begin() + index; i != end(); i++) tmp.push_back (std::move(*i));
+				*this = std::move(tmp);
+			}
+			else {
+				for (It i = first; i != last; i++) push_back (*i);
+				rotate (begin() + index, end() - n);
+			}
+			return begin() + index;
+		}
+
+		iterator erase (iterator pos) {
+			for (iterator i = pos; i+1 != end(); i++) *i = std::move(*(i+1));
+			pop_back();
+			return pos;
+		}
+
+		void clear () {
+			for (iterator i = begin(); i != end(); i++) i->~T();
+			fSize = 0;
+		}
+
+	private:
+		typedef typename std::aligned_storage<N * sizeof(T), alignof(T)>::type storage;
+
+		bool		onHeap() const	{ return fCapacity > N; }
+		T*			data()			{ return onHeap() ? fStore.fHeap : reinterpret_cast<T*>(&fStore.fInline); }
+		const T*	data() const	{ return onHeap() ? fStore.fHeap : reinterpret_cast<const T*>(&fStore.fInline); }
+
+		void check (size_type i) const	{ if (i >= fSize) throw std::out_of_range("smallvector"); }
+
+		// moves the elements to a heap block of n elements
+		void grow (size_type n) {
+			T* block = static_cast<T*>(::operator new (n * sizeof(T)));
+			T* src = data();
+			for (size_type i = 0; i < fSize; i++) {
+				new (block + i) T(std::move(src[i]));
+				src[i].~T();
+			}
+			release();
+			fStore.fHeap = block;
+			fCapacity = unsigned(n);
+		}
+		// frees the heap block (the elements must have been destroyed)
+		void release () {
+			if (onHeap()) ::operator delete (fStore.fHeap);
+			fCapacity = N;
+		}
+		// takes the content of v (this vector must be empty)
+		void take (smallvector& v) {
+			if (v.onHeap()) {
+				fStore.fHeap = v.fStore.fHeap;
+				fCapacity = v.fCapacity;
+				fSize = v.fSize;
+				v.fCapacity = N;
+				v.fSize = 0;
+			}
+			else {
+				for (iterator i = v.begin(); i != v.end(); i++) push_back (std::move(*i));
+				v.clear();
+			}
+		}
+		// moves the elements [from, end) to the position pos
+		void rotate (iterator pos, iterator from) {
+			for (; from != end(); from++, pos++)
+				for (iterator i = from; i != pos; i--) std::swap (*i, *(i-1));
+		}
+
+		unsigned	fSize;
+		unsigned	fCapacity;
+		union {
+			T*		fHeap;
+			storage	fInline;
+		} fStore;
+};
+
+/*! @} */
+
+} // namespace
+
+#endif
@@ -22,41 +22,73 @@
 */
 
 #include "streambeautifuller.h"
+#include "strnum.h"
 
 using namespace std;
 
 streambeautifuller::streambeautifuller (ostream& stream, int max, int indentSize) 
-		: fStream(stream), fSize(0), fMaxSize(max), fIndent(0), fIndentSize(indentSize)
-{}
+		: fStream(stream), fSize(0), fMaxSize(max), fIndent(0), fIndentSize(indentSize), fHold(false)
+{
+	fBuffer.reserve (kBufferSize + 1024);
+}
+
+void streambeautifuller::flush ()
+{
+	fStream.write (fBuffer.data(), fBuffer.size());
+	fBuffer.clear();
+}
+
+void streambeautifuller::hold (bool state)
+{
+	fHold = state;
+	if (!fHold && (fBuffer.size() > kBufferSize)) flush();
+}
+
+void streambeautifuller::append (const string& text, size_t n, int column)
+{
+	fBuffer.append (text, 0, n);
+	fSize = column;
+	if (!fHold && (fBuffer.size() > kBufferSize)) flush();
+}
 
 void streambeautifuller::newline ()
 {
-	int n = fIndent;
-	fStream << '\n';
-	while (n--) fStream << ' ';
+	fBuffer += '\n';
+	fBuffer.append (fIndent, ' ');
 	fSize = fIndent;
 }
 
 void streambeautifuller::pbreak ()
 {
-	if (fSize > fMaxSize) newline();	
+	if ((fMaxSize > 0) && (fSize > fMaxSize)) newline();	
 }
 
-void streambeautifuller::print (const string& s)
+void streambeautifuller::print (const char* s, size_t n)
 {
-	size_t n = s.size();
-	for (int i=0; i<n; i++) {
-		if (s[i] == '\n') newline();
-		else {
-			fStream << s[i];
-			fSize++;
-		}
+	const char* end = s + n;
+	while (s < end) {
+		const char* nl = (const char*)memchr (s, '\n', end - s);
+		size_t len = (nl ? nl : end) - s;
+		fBuffer.append (s, len);
+		fSize += int(len);
+		if (!nl) break;
+		newline();
+		s = nl + 1;
 	}
+	if (!fHold && (fBuffer.size() > kBufferSize)) flush();
+}
+
+streambeautifuller& streambeautifuller::operator << (long n)
+{
+	size_t size = fBuffer.size();
+	guido::appendnum (fBuffer, n);
+	fSize += int(fBuffer.size() - size);
+	return *this;
 }
 
 streambeautifuller& streambeautifuller::operator << (char p)
 { 
 	if (p == '\n') newline();
-	else fStream << p;
+	else fBuffer += p;
 	return *this;
 }
@@ -24,6 +24,7 @@
 #ifndef __streambeautifuller__
 #define __streambeautifuller__
 
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -32,20 +33,32 @@
 
 /*!
 \brief An output stream decorateur
+
+	Takes care of the indentation and breaks the lines longer than a maximum
+	size (a maximum size <= 0 disables the line breaks).
+	The output is collected in a buffer that is written to the stream when
+	it is large enough, when flush() is called and at destruction. Strings,
+	characters and integers are added to the buffer directly; other types
+	go through a stringstream.
 */
 class gar_export streambeautifuller {
 	std::ostream&	fStream;
+	std::string		fBuffer;
 	int				fSize;
 	int				fMaxSize;
 	int				fIndent;
 	int				fIndentSize;
+	bool			fHold;
+
+	enum { kBufferSize = 16*1024 };
 
 	void	newline ();
-	void	print (const std::string& s);
+	void	print (const char* s, size_t n);
+	void	print (const std::string& s)	{ print (s.data(), s.size()); }
 
 	public:
 				 streambeautifuller (std::ostream& stream, int max, int indentSize=4);
-		virtual ~streambeautifuller () {}
+		virtual ~streambeautifuller () { flush(); }
 
 		template <typename T>
 		streambeautifuller& operator << (T p) { 
@@ -54,6 +67,10 @@ class gar_export streambeautifuller {
 			print(s.str());
 			return *this;
 		}
+		streambeautifuller& operator << (const std::string& s)	{ print(s); return *this; }
+		streambeautifuller& operator << (const char* s)			{ print(s, strlen(s)); return *this; }
+		streambeautifuller& operator << (long n);
+		streambeautifuller& operator << (int n)					{ return *this << long(n); }
 		streambeautifuller& operator << (char p);		
 		streambeautifuller& operator++ (int)	{ fIndent += fIndentSize; return *this; }
 		streambeautifuller& operator-- (int)	{ fIndent -= fIndentSize; if (fIndent <  0) fIndent = 0; return *this; }
@@ -61,6 +78,21 @@ class gar_export streambeautifuller {
 		streambeautifuller& operator-- ()	{ fIndent -= fIndentSize; if (fIndent <  0) fIndent = 0; return *this; }
 
 		void	pbreak ();
+		//! writes the buffered output to the stream
+		void	flush ();
+
+		/*! \brief prevents the buffer from being written to the stream (until hold(false) is called)
+			so that a part of the output can be retrieved using mark() and pending()
+		*/
+		void	hold (bool state);
+		//! the current position in the pending output
+		size_t	mark () const						{ return fBuffer.size(); }
+		//! the output not written to the stream yet
+		const std::string& pending () const			{ return fBuffer; }
+		//! the size of the current line
+		int		column () const						{ return fSize; }
+		//! appends the n first characters of text as is, column is the size of the line at the end
+		void	append (const std::string& text, size_t n, int column);
 };
 
 
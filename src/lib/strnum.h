@@ -0,0 +1,58 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifndef __strnum__
+#define __strnum__
+
+#include <string>
+
+namespace guido
+{
+
+/*!
+\addtogroup generic
+@{
+*/
+
+//______________________________________________________________________________
+/*!
+\brief	Appends the decimal representation of an integer to a string.
+
+	Used by the gmn output instead of a stringstream, which is far too costly
+	to build for each printed token.
+*/
+inline void appendnum (std::string& s, long n)
+{
+	char buff[24];
+	char* ptr = buff + sizeof(buff);
+	unsigned long v = (n < 0) ? 0UL - (unsigned long)n : (unsigned long)n;
+	do {
+		*--ptr = char('0' + (v % 10));
+		v /= 10;
+	} while (v);
+	if (n < 0) *--ptr = '-';
+	s.append (ptr, buff + sizeof(buff) - ptr);
+}
+
+/*! @} */
+
+} // namespace
+
+#endif
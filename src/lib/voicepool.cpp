@@ -0,0 +1,129 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "ARFactory.h"
+#include "AROthers.h"
+#include "clonevisitor.h"
+#include "scorestore.h"
+#include "voicepool.h"
+
+using namespace std;
+
+namespace guido
+{
+
+static atomic<unsigned> gThreads (1);
+
+//______________________________________________________________________________
+void voicepool::setThreads (unsigned n)		{ gThreads = n; }
+
+unsigned voicepool::threads ()
+{
+#ifdef GAR_ATOMIC_REFCOUNT
+	unsigned n = gThreads;
+	if (!n) n = thread::hardware_concurrency();
+	return n ? n : 1;
+#else
+	return 1;
+#endif
+}
+
+//______________________________________________________________________________
+vector<Sguidoelement> voicepool::voices (const Sguidoelement& score)
+{
+	vector<Sguidoelement> list;
+	const ARMusic* music = dynamic_cast<const ARMusic*>((const guidoelement*)score);
+	if (music && (threads() > 1)) {
+		for (const auto& elt: music->elements())
+			if (dynamic_cast<const ARVoice*>((const guidoelement*)elt)) list.push_back (elt);
+		if (list.size() < 2) list.clear();
+	}
+	return list;
+}
+
+//______________________________________________________________________________
+Sguidoelement voicepool::apply (const Sguidoelement& score, const voicetask& task)
+{
+	vector<Sguidoelement> list = voices (score);
+	if (list.empty()) return 0;
+	for (const auto& voice: list) {
+		ARStoredVoice* stored = dynamic_cast<ARStoredVoice*>((guidoelement*)voice);
+		if (stored) stored->load();		// a score store is not thread safe
+	}
+
+	vector<Sguidoelement> results (list.size());
+	run (list.size(), [&] (size_t i) { results[i] = task (list[i], i); });
+
+	const ARMusic* music = dynamic_cast<const ARMusic*>((const guidoelement*)score);
+	SARMusic out = ARFactory::instance().createMusic();
+	for (const auto& h: music->getHeader()) out->addHeader (h);
+	for (const auto& f: music->getFooter()) out->addFooter (f);
+	clonevisitor cv;
+	size_t i = 0;
+	for (const auto& elt: music->elements()) {
+		if ((i < list.size()) && ((guidoelement*)elt == (guidoelement*)list[i])) {
+			if (!results[i]) return 0;
+			out->push (results[i++]);
+		}
+		else out->push (cv.clone (elt));
+	}
+	return out;
+}
+
+//______________________________________________________________________________
+// the calling thread takes its share of the tasks
+// a task exception is thrown again to the caller once all the threads are done
+void voicepool::run (size_t count, const function<void (size_t)>& task)
+{
+#ifdef GAR_ATOMIC_REFCOUNT
+	size_t n = min (size_t(threads()), count);
+	if (n > 1) {
+		atomic<size_t> next (0);
+		exception_ptr failure;
+		mutex failureLock;
+		auto worker = [&] () {
+			try {
+				for (size_t i = next++; i < count; i = next++) task (i);
+			}
+			catch (...) {			// an exception can't leave a thread: it is passed to the caller
+				lock_guard<mutex> lock (failureLock);
+				if (!failure) failure = current_exception();
+				next = count;		// and the remaining tasks are dropped
+			}
+		};
+		vector<thread> pool;
+		for (size_t t = 1; t < n; t++) pool.emplace_back (worker);
+		worker();
+		for (auto& t: pool) t.join();
+		if (failure) rethrow_exception (failure);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < count; i++) task (i);
+}
+
+} // namespace
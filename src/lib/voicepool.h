@@ -0,0 +1,92 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+
+#ifndef __voicepool__
+#define __voicepool__
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "arexport.h"
+#include "guidoelement.h"
+
+namespace guido
+{
+
+/*!
+\addtogroup generic
+@{
+*/
+
+//______________________________________________________________________________
+/*!
+\brief	Runs tasks on the voices of a score using several threads.
+
+	Operations that process the voices of a score independently (e.g. transpose
+	or mirror) may run a task per voice. The voices are handed to the threads on
+	demand and the results are kept in the voices order, thus the output doesn't
+	depend on the threads scheduling.
+
+	Tasks run concurrently: they must not share any state, and the voices must
+	not share elements. The threads are used only when the reference counting is
+	atomic (see GAR_ATOMIC_REFCOUNT), otherwise the operations browse the score
+	as a whole.
+*/
+class gar_export voicepool
+{
+	public:
+		typedef std::function<Sguidoelement (const Sguidoelement& voice, size_t index)> voicetask;
+
+		/*! sets the number of threads used to process the voices
+			\param n the threads count, 0 for the hardware threads count, 1 (the default) to process the voices in sequence
+		*/
+		static void		setThreads (unsigned n);
+		//! the number of threads used to process the voices, always 1 when the reference counting is not atomic
+		static unsigned	threads ();
+
+		/*! \brief gives the voices of a score to be processed concurrently
+			\return the voices, or an empty vector when the score is not an ARMusic,
+			when it has less than 2 voices or when a single thread is used
+		*/
+		static std::vector<Sguidoelement> voices (const Sguidoelement& score);
+
+		/*! \brief applies a task to each voice of a score
+			\param score the score
+			\param task the task, which gives the new voice
+			\return a new score made of the tasks results and of copies of the other
+			score elements, null when the voices are not processed concurrently (see voices())
+			or when a task fails: the caller should then process the score as a whole
+		*/
+		static Sguidoelement apply (const Sguidoelement& score, const voicetask& task);
+
+		/*! \brief runs count tasks, possibly concurrently, the task index is passed to the task
+			When a task throws an exception, the remaining tasks are dropped and the exception
+			is thrown again by run() once the running tasks are done.
+		*/
+		static void run (size_t count, const std::function<void (size_t)>& task);
+};
+
+/*! @} */
+
+} // namespace
+
+#endif
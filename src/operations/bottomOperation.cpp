@@ -69,7 +69,12 @@ bool bottomOperation::copy  ()	{ return fCurrentVoice > fVoiceNum; }
 void bottomOperation::visitStart ( SARVoice& elt )
 {
 	fCurrentVoice++;
-	if (copy())
+	if (copy() && fShare) {			// the voice is shared with the input score
+		Sguidoelement voice = elt;
+		push (voice, false);
+		fBrowser.stop();
+	}
+	else if (copy())
 		clonevisitor::visitStart (elt);
 	else fBrowser.stop();
 }
@@ -78,7 +83,7 @@ void bottomOperation::visitStart ( SARVoice& elt )
 void bottomOperation::visitEnd ( SARVoice& elt )
 {
 	fBrowser.stop(false);
-	if (copy())
+	if (copy() && !fShare)
 		clonevisitor::visitEnd (elt);
 }
 
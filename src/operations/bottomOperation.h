@@ -40,6 +40,9 @@ namespace guido
 
 /*!
 \brief A visitor that cuts the head of a score voices.
+
+	When sharing is enabled (see clonevisitor::share()), the preserved voices
+	are shared with the input score instead of being copied.
 */
 class gar_export bottomOperation :
 	public operation,
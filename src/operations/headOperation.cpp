@@ -26,6 +26,7 @@
 # pragma warning (disable : 4786)
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -59,6 +60,7 @@ Sguidoelement headOperation::operator() ( const Sguidoelement& score, const rati
 	fCutPoint = duration;
 	Sguidoelement outscore;
 	if (score) {
+		fBrowser.stop (false);
 		fBrowser.browse (*score);
 		outscore = fStack.top();
 		fStack.pop();
@@ -69,8 +71,10 @@ Sguidoelement headOperation::operator() ( const Sguidoelement& score, const rati
 //________________________________________________________________________
 void headOperation::checkOpenedTags()
 {
-	for (map<std::string,Sguidotag>::iterator i = fOpenedTagsMap.begin(); i != fOpenedTagsMap.end(); i++) {
-		Sguidotag tag = i->second;
+	vector<int> types = fOpenedTagsMap.types();
+	sort (types.begin(), types.end());		// tags are closed in tag type order
+	for (size_t i = 0; i < types.size(); i++) {
+		const Sguidotag& tag = fOpenedTagsMap[types[i]];
 		if (tag) {			// only Begin tags are stored to this map
 			string match = tag->matchTag();
 			Sguidotag endtag = ARFactory::instance().createTag(match);
@@ -83,13 +87,26 @@ void headOperation::checkOpenedTags()
 	}
 	fOpenedTagsMap.clear();
 
-	for (map<std::string,Sguidotag>::iterator i = fRangeTagsMap.begin(); i != fRangeTagsMap.end(); i++) {
-		Sguidotag tag = i->second;
+	const vector<int>& ranges = fRangeTagsMap.types();
+	for (size_t i = 0; i < ranges.size(); i++) {
+		Sguidotag tag = fRangeTagsMap[ranges[i]];
 		if (tag) markers::markOpened (tag, true);
 	}
 	fRangeTagsMap.clear();
 }
 
+//________________________________________________________________________
+// called for the elements at or after the cut point: the opened tags are closed
+// and the voice browsing stops once an element after the cut point is reached,
+// since the remaining elements can't be copied
+void headOperation::cut (const rational& remain)
+{
+	fCopy = false;
+	checkOpenedTags();
+	if ((remain.getNumerator() < 0) && !fDuration.inChord())
+		fBrowser.stop();
+}
+
 //________________________________________________________________________
 Sguidoelement headOperation::makeOpenedTie() const
 {
@@ -117,7 +134,8 @@ void headOperation::visitStart ( SARChord& elt )
 {
 	rational remain = fCutPoint - fDuration.currentVoiceDate();
 	int dots = fDuration.currentDots();
-	rational dur = elt->totalduration(fDuration.currentNoteDuration(), dots);
+	rational current = fDuration.currentNoteDuration();
+	rational dur = elt->totalduration(current, dots);
 	if (remain.getNumerator() > 0) {
 		if (remain < dur) {
 			push(makeOpenedTie(), true);		// push an opened tie tag to the current copy
@@ -126,8 +144,7 @@ void headOperation::visitStart ( SARChord& elt )
 		clonevisitor::visitStart (elt);
 	}
 	else {
-		fCopy = false;
-		checkOpenedTags();		// and close any opened tag
+		cut (remain);			// and close any opened tag
 	}
 	fDuration.visitStart (elt);
 }
@@ -135,6 +152,7 @@ void headOperation::visitStart ( SARChord& elt )
 //________________________________________________________________________
 void headOperation::visitStart ( SARNote& elt )
 {
+	SARNote note = elt;
 	rational remain = fCutPoint - fDuration.currentVoiceDate();
 	bool tie = false;
 	if (remain.getNumerator() > 0) {
@@ -144,46 +162,43 @@ void headOperation::visitStart ( SARNote& elt )
 		int currentDots = fDuration.currentDots();
 		rational dur = elt->totalduration(currentDur, currentDots);
 		if (dur > remain) {
-			*elt = remain;
-			elt->SetDots(0);
+			note = copy (elt);				// the input note is left unchanged
+			*note = remain;
+			note->SetDots(0);
 			// force an explicit octave - makes the merge more easy to do when putting back in sequence
-			if (elt->implicitOctave()) elt->SetOctave (fCurrentOctave);
+			if (note->implicitOctave()) note->SetOctave (fCurrentOctave);
 			tie = !fDuration.inChord();		// tie already inserted before the chord
 		}
 
-		if (tie && !elt->isEmpty()) {		// notes splitted by the operation are marked using an opened tie
+		if (tie && !note->isEmpty()) {		// notes splitted by the operation are marked using an opened tie
 			push(makeOpenedTie(), true);
-			clonevisitor::visitStart (elt);
+			clonevisitor::visitStart (note);
 			fStack.pop();
 		}
-		else clonevisitor::visitStart (elt);
+		else clonevisitor::visitStart (note);
 	}
 	else {
-		fCopy = false;
-		checkOpenedTags();		// and close any opened tag
+		cut (remain);			// and close any opened tag
 	}
-	fDuration.visitStart (elt);
+	fDuration.visitStart (note);
 }
 
 //________________________________________________________________________
 void headOperation::visitStart ( Sguidotag& elt )
 {
-	long remain = (fCutPoint - fDuration.currentVoiceDate()).getNumerator();
-	if ((remain > 0) || ((remain==0) && elt->endTag())) {	//  gives a chance to close Begin tags
+	rational remain = fCutPoint - fDuration.currentVoiceDate();
+	if ((remain.getNumerator() > 0) || ((remain.getNumerator() == 0) && elt->endTag())) {	//  gives a chance to close Begin tags
 		clonevisitor::visitStart (elt);
-		string name = elt->getName();
+		int type = elt->getType();
 		if (elt->beginTag())
-			fOpenedTagsMap[name] = elt;
+			fOpenedTagsMap.set (type, elt);
 		else if (elt->endTag())
-			fOpenedTagsMap[elt->matchTag()] = (void*)0;
+			fOpenedTagsMap.reset (elt->matchType());
 		else if (elt->size()) {
-			fRangeTagsMap[name] = dynamic_cast<guidotag*>((guidoelement*)fStack.top());
+			fRangeTagsMap.set (type, dynamic_cast<guidotag*>((guidoelement*)fStack.top()));
 		}
 	}
-	else {
-		fCopy = false;
-		checkOpenedTags();		// and close any opened tag
-	}
+	else cut (remain);		// and close any opened tag
 }
 
 //________________________________________________________________________
@@ -192,7 +207,7 @@ void headOperation::visitEnd ( Sguidotag& elt )
 	if (fCopy) {
 		clonevisitor::visitEnd (elt);
 		if (elt->size())
-			fRangeTagsMap[elt->getName()] = (void*)0;
+			fRangeTagsMap.reset (elt->getType());
 	}
 }
 
@@ -212,6 +227,7 @@ void headOperation::visitEnd ( SARChord& elt )
 //________________________________________________________________________
 void headOperation::visitEnd ( SARVoice& elt )
 {
+	fBrowser.stop (false);
 	clonevisitor::visitEnd (elt);
 	// adjusts the stack - necessary due to potential end inside range tags
 	while (fStack.size() > 1)
@@ -23,10 +23,10 @@
 #ifndef __headOperation__
 #define __headOperation__
 
-#include <map>
 #include <string>
 
 #include "arexport.h"
+#include "ARTag.h"
 #include "guidoelement.h"
 #include "clonevisitor.h"
 #include "durationvisitor.h"
@@ -42,6 +42,11 @@ namespace guido
 
 /*!
 \brief A visitor that cuts the tail of a score.
+
+	When sharing is enabled (see clonevisitor::share()), the notes and tags
+	before the cut point are shared with the input score, a note cut by the
+	operation is copied.
+	The browsing of a voice stops at the first element after the cut point.
 */
 class gar_export headOperation :
 	public operation,
@@ -82,10 +87,11 @@ class gar_export headOperation :
 		virtual void visitEnd  ( Sguidotag& elt );
 
 		Sguidoelement makeOpenedTie() const;
+		void cut (const rational& remain);
 
      private:
-		std::map<std::string,Sguidotag> fRangeTagsMap;
-		std::map<std::string,Sguidotag> fOpenedTagsMap;
+		tagsmap	fRangeTagsMap;
+		tagsmap	fOpenedTagsMap;
 		void checkOpenedTags ();
 		tree_browser<guidoelement> fBrowser;
 };
@@ -38,6 +38,7 @@
 #include "mirrorOperation.h"
 #include "transposeOperation.h"
 #include "tree_browser.h"
+#include "voicepool.h"
 
 using namespace std;
 
@@ -66,6 +67,12 @@ SARMusic mirrorOperation::operator() ( const SARMusic& score1, const SARMusic& s
 //_______________________________________________________________________________
 Sguidoelement mirrorOperation::operator() ( const Sguidoelement& score, int midipitch )
 {
+	Sguidoelement out = voicepool::apply (score, [midipitch] (const Sguidoelement& voice, size_t) {
+		mirrorOperation op;
+		return op (voice, midipitch);
+	});
+	if (out) return out;		// the voices have been mirrored concurrently
+
 	fFixedPoint = midipitch;
 	fCurrentOctave = ARNote::kDefaultOctave;	// the default octave
 	fCurrentKey = 0;
@@ -36,6 +36,7 @@
 #include "clonevisitor.h"
 #include "normalizeOperation.h"
 #include "tree_browser.h"
+#include "voicepool.h"
 
 using namespace std;
 
@@ -45,6 +46,12 @@ namespace guido
 //_______________________________________________________________________________
 Sguidoelement normalizeOperation::operator() ( const Sguidoelement& score )
 {
+	Sguidoelement out = voicepool::apply (score, [] (const Sguidoelement& voice, size_t) {
+		normalizeOperation op;
+		return op (voice);
+	});
+	if (out) return out;		// the voices have been normalized concurrently
+
 	Sguidoelement outscore;
 	if (score) {
 		tree_browser<guidoelement> tb(this);
@@ -0,0 +1,217 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifdef WIN32
+# pragma warning (disable : 4786)
+#endif
+
+#include <cstdio>
+#include <locale>
+#include <sstream>
+
+#include "AROthers.h"
+#include "bottomOperation.h"
+#include "durationOperation.h"
+#include "eheadOperation.h"
+#include "etailOperation.h"
+#include "guidoparser.h"
+#include "headOperation.h"
+#include "mirrorOperation.h"
+#include "parOperation.h"
+#include "pipelineOperation.h"
+#include "seqOperation.h"
+#include "tailOperation.h"
+#include "topOperation.h"
+#include "transposeOperation.h"
+
+using namespace std;
+
+namespace guido
+{
+
+//_______________________________________________________________________________
+// the steps names, in the type order
+static const char* gStepNames[] = { "transpose", "top", "bottom", "mirror", "head", "ehead", "tail", "etail",
+									"setduration", "multduration", "seq", "par", "rpar" };
+
+//_______________________________________________________________________________
+pipelineOperation& pipelineOperation::add (type t, int i, const rational& d, float f, const SARMusic& score)
+{
+	step s = { t, i, d, f, score };
+	fSteps.push_back (s);
+	return *this;
+}
+
+pipelineOperation& pipelineOperation::transpose	(int steps)				{ return add (kTranspose, steps, rational(0,1), 0, 0); }
+pipelineOperation& pipelineOperation::top		(int nvoices)			{ return add (kTop, nvoices, rational(0,1), 0, 0); }
+pipelineOperation& pipelineOperation::bottom	(int nvoices)			{ return add (kBottom, nvoices, rational(0,1), 0, 0); }
+pipelineOperation& pipelineOperation::mirror	(int midipitch)			{ return add (kMirror, midipitch, rational(0,1), 0, 0); }
+pipelineOperation& pipelineOperation::head		(const rational& d)		{ return add (kHead, 0, d, 0, 0); }
+pipelineOperation& pipelineOperation::ehead		(int events)			{ return add (kEHead, events, rational(0,1), 0, 0); }
+pipelineOperation& pipelineOperation::tail		(const rational& d)		{ return add (kTail, 0, d, 0, 0); }
+pipelineOperation& pipelineOperation::etail		(int events)			{ return add (kETail, events, rational(0,1), 0, 0); }
+pipelineOperation& pipelineOperation::setDuration (const rational& d)	{ return add (kSetDuration, 0, d, 0, 0); }
+pipelineOperation& pipelineOperation::multDuration (float factor)		{ return add (kMultDuration, 0, rational(0,1), factor, 0); }
+pipelineOperation& pipelineOperation::seq		(const SARMusic& score)	{ return add (kSeq, 0, rational(0,1), 0, score); }
+pipelineOperation& pipelineOperation::par		(const SARMusic& score)	{ return add (kPar, 0, rational(0,1), 0, score); }
+pipelineOperation& pipelineOperation::rpar		(const SARMusic& score)	{ return add (kRPar, 0, rational(0,1), 0, score); }
+
+//_______________________________________________________________________________
+// the steps are separated with ';' or new lines, except inside the gmn code
+// given to seq, par and rpar i.e. inside brackets, braces and quoted strings
+static size_t stepEnd (const string& steps, size_t start)
+{
+	int depth = 0;
+	bool quoted = false;
+	for (size_t i = start; i < steps.size(); i++) {
+		char c = steps[i];
+		if (quoted)							quoted = (c != '"');
+		else if (c == '"')					quoted = true;
+		else if ((c == '[') || (c == '{'))	depth++;
+		else if ((c == ']') || (c == '}'))	{ if (depth) depth--; }
+		else if (!depth && ((c == ';') || (c == '\n'))) return i;
+	}
+	return steps.size();
+}
+
+//_______________________________________________________________________________
+bool pipelineOperation::parse (const string& steps)
+{
+	fError.clear();
+	bool ret = true;
+	size_t start = 0;
+	while (start <= steps.size()) {
+		size_t end = stepEnd (steps, start);
+		if (!parseStep (steps.substr (start, end - start))) ret = false;
+		start = end + 1;
+	}
+	return ret;
+}
+
+//_______________________________________________________________________________
+// a step is an operation name followed by its argument, empty steps are ignored
+bool pipelineOperation::parseStep (const string& text)
+{
+	istringstream stream (text);
+	string name, arg, extra;
+	if (!(stream >> name)) return true;
+
+	int n = sizeof(gStepNames) / sizeof(gStepNames[0]);
+	int t = 0;
+	while ((t < n) && (name != gStepNames[t])) t++;
+	if (t == n) {
+		fError = "pipeline: unknown operation '" + name + "'";
+		return false;
+	}
+
+	if ((t == kSeq) || (t == kPar) || (t == kRPar)) {
+		string gmn;
+		getline (stream, gmn, '\0');		// the rest of the step is the score gmn code
+		guidoparser p;
+		SARMusic score = p.parseString (gmn.c_str());
+		if (!score) {
+			ostringstream msg;
+			msg << "pipeline: " << name << ": invalid gmn code (line " << p.getError().line << " col " << p.getError().col << ": " << p.getError().msg << ")";
+			fError = msg.str();
+			return false;
+		}
+		add (type(t), 0, rational(0,1), 0, score);
+		return true;
+	}
+
+	stream >> arg;
+	if (arg.empty() || (stream >> extra)) {
+		fError = "pipeline: '" + text + "': one argument expected";
+		return false;
+	}
+
+	int i; long num, denum; float f; char c;
+	bool valid = false;
+	switch (t) {
+		case kTranspose: case kTop: case kBottom: case kMirror: case kEHead: case kETail:
+			valid = sscanf (arg.c_str(), "%d%c", &i, &c) == 1;
+			if (valid) add (type(t), i, rational(0,1), 0, 0);
+			break;
+		case kHead: case kTail: case kSetDuration:
+			if (sscanf (arg.c_str(), "%ld/%ld%c", &num, &denum, &c) == 2) valid = denum != 0;
+			else if (sscanf (arg.c_str(), "%ld%c", &num, &c) == 1) { denum = 1; valid = true; }
+			if (valid) add (type(t), 0, rational(num, denum), 0, 0);
+			break;
+		case kMultDuration: {
+			istringstream s (arg);			// sscanf depends on the C numeric locale
+			s.imbue (locale::classic());
+			valid = (s >> f) && s.eof();
+			if (valid) add (type(t), 0, rational(0,1), f, 0);
+			}
+			break;
+		default: break;
+	}
+	if (!valid) fError = "pipeline: '" + text + "': invalid argument";
+	return valid;
+}
+
+//_______________________________________________________________________________
+// share tells whether the step may share the elements of its input score (see clonevisitor)
+Sguidoelement pipelineOperation::apply (const step& s, const Sguidoelement& score, bool share) const
+{
+	switch (s.fType) {
+		case kTranspose:	{ transposeOperation op; return op (score, s.fInt); }
+		case kTop:			{ topOperation op; op.share (share); return op (score, s.fInt); }
+		case kBottom:		{ bottomOperation op; op.share (share); return op (score, s.fInt); }
+		case kMirror:		{ mirrorOperation op; return op (score, s.fInt); }
+		case kHead:			{ headOperation op; op.share (share); return op (score, s.fDuration); }
+		case kEHead:		{ eheadOperation op; return op (score, s.fInt); }
+		case kTail:			{ tailOperation op; return op (score, s.fDuration); }
+		case kETail:		{ etailOperation op; return op (score, s.fInt); }
+		case kSetDuration:	{ durationOperation op; return op (score, s.fDuration); }
+		case kMultDuration:	{ durationOperation op; return op (score, s.fFloat); }
+		default: break;
+	}
+
+	SARMusic music = dynamic_cast<ARMusic*>((guidoelement*)score);
+	if (!music || !s.fScore) return 0;
+	switch (s.fType) {
+		case kSeq:	{ seqOperation op; return op (music, s.fScore); }
+		case kPar:	{ parOperation op; return op (music, s.fScore); }
+		case kRPar:	{ rparOperation op; return op (music, s.fScore); }
+		default: break;
+	}
+	return 0;
+}
+
+//_______________________________________________________________________________
+Sguidoelement pipelineOperation::operator() ( const Sguidoelement& score )
+{
+	Sguidoelement result = score;
+	for (size_t i = 0; result && (i < fSteps.size()); i++) {
+		// the intermediate results are dropped by the next step, which may thus share their
+		// elements, but the result must not share the elements of the caller score
+		bool share = (guidoelement*)result != (guidoelement*)score;
+		result = apply (fSteps[i], result, share);
+		if (!result) {
+			ostringstream msg;
+			msg << "pipeline: step " << (i + 1) << " (" << gStepNames[fSteps[i].fType] << ") failed";
+			fError = msg.str();
+		}
+	}
+	return result;
+}
+
+} // namespace
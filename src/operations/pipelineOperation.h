@@ -0,0 +1,124 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifndef __pipelineOperation__
+#define __pipelineOperation__
+
+#include <string>
+#include <vector>
+
+#include "arexport.h"
+#include "ARTypes.h"
+#include "guidorational.h"
+
+namespace guido
+{
+
+/*!
+\addtogroup operations
+@{
+*/
+
+/*!
+\brief A sequence of operations applied to a score in memory.
+
+	Each step takes the result of the previous one as input, thus a pipeline
+	is equivalent to chaining the corresponding library functions, but the
+	score is parsed and printed only once.
+
+	A pipeline may be built with the step methods or from a text form, made
+	of steps separated with ';' or new lines (outside of the gmn code given to
+	seq, par and rpar). A step is an operation name followed by its argument:
+	- \c transpose \c n: transposes the score of n semitones
+	- \c top \c n: keeps the n first voices of the score
+	- \c bottom \c n: drops the n first voices of the score
+	- \c mirror \c p: mirrors the pitches around the midi pitch p
+	- \c head \c d: keeps the score up to the date d ('n/d' where 1 is a whole note)
+	- \c tail \c d: keeps the score from the date d
+	- \c ehead \c n: keeps the n first events of the score
+	- \c etail \c n: drops the n first events of the score
+	- \c setduration \c d: stretches the score to the duration d
+	- \c multduration \c f: stretches the score by the factor f ('1.5', read independently of the C locale)
+	- \c seq \c gmn, \c par \c gmn, \c rpar \c gmn: puts the score in sequence,
+	  in parallel or in parallel right aligned with a score given as gmn code
+	  e.g. 'seq [c d e]'. The gmn code is never taken as a file name: a text form
+	  coming from a user can't make the library read files.
+*/
+class gar_export pipelineOperation
+{
+    public:
+		enum type { kTranspose, kTop, kBottom, kMirror, kHead, kEHead, kTail, kETail,
+					kSetDuration, kMultDuration, kSeq, kPar, kRPar };
+
+				 pipelineOperation() {}
+		virtual ~pipelineOperation() {}
+
+		pipelineOperation&	transpose	(int steps);
+		pipelineOperation&	top			(int nvoices);
+		pipelineOperation&	bottom		(int nvoices);
+		pipelineOperation&	mirror		(int midipitch);
+		pipelineOperation&	head		(const rational& duration);
+		pipelineOperation&	ehead		(int events);
+		pipelineOperation&	tail		(const rational& duration);
+		pipelineOperation&	etail		(int events);
+		pipelineOperation&	setDuration	(const rational& duration);
+		pipelineOperation&	multDuration(float factor);
+		pipelineOperation&	seq			(const SARMusic& score);
+		pipelineOperation&	par			(const SARMusic& score);
+		pipelineOperation&	rpar		(const SARMusic& score);
+
+		/*! adds the steps of a pipeline text form
+			\param steps the text form
+			\return false in case of syntax error (see getError()), the valid steps are added anyway
+		*/
+		bool	parse (const std::string& steps);
+		//! the message of the last error
+		const std::string& getError () const	{ return fError; }
+
+		size_t	size () const					{ return fSteps.size(); }
+		void	clear ()						{ fSteps.clear(); }
+
+		/*! applies the pipeline steps
+			\param score the input score
+			\return the resulting score, or null when a step fails (see getError())
+		*/
+		Sguidoelement operator() ( const Sguidoelement& score );
+
+    protected:
+		struct step {
+			type		fType;
+			int			fInt;
+			rational	fDuration;
+			float		fFloat;
+			SARMusic	fScore;
+		};
+		std::vector<step>	fSteps;
+		std::string			fError;
+
+		pipelineOperation&	add (type t, int i, const rational& d, float f, const SARMusic& score);
+		bool				parseStep (const std::string& text);
+		Sguidoelement		apply (const step& s, const Sguidoelement& score, bool share) const;
+};
+
+/*! @} */
+
+} // namespace
+
+#endif
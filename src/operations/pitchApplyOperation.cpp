@@ -26,6 +26,7 @@
 # pragma warning (disable : 4786)
 #endif
 
+#include "counteventsvisitor.h"
 #include "pitchApplyOperation.h"
 
 using namespace std;
@@ -82,9 +83,23 @@ void octaveVisitor::visitStart( SARNote& elt )
 		fCurrentOctave = octave;
 }
 
+//_______________________________________________________________________________
+// counts the events that use a pitch: the rests and empty notes are ignored
+class pitchedeventsvisitor : public counteventsvisitor
+{
+	public:
+		virtual void visitStart( SARNote& elt )		{ if (elt->isPitched()) counteventsvisitor::visitStart (elt); }
+};
+
 //_______________________________________________________________________________
 // pitchApplyBaseOperation
 //_______________________________________________________________________________
+int pitchApplyBaseOperation::pitchedEvents( const Sguidoelement& voice )
+{
+	pitchedeventsvisitor pev;
+	return pev.count (voice);
+}
+
 Sguidoelement pitchApplyBaseOperation::browse( const Sguidoelement& score ) {
 	fInChord = false;
 	Sguidoelement outscore;
@@ -36,6 +36,7 @@
 #include "pitchvisitor.h"
 #include "transposeOperation.h"
 #include "tree_browser.h"
+#include "voicepool.h"
 
 namespace guido 
 {
@@ -69,6 +70,8 @@ class gar_export pitchApplyBaseOperation :
 		int		fChordBase;				// used to transpose chords		
 
 		Sguidoelement browse		( const Sguidoelement& score );
+		//! the number of pitches used by a voice i.e. the pitched notes outside chords and the chords
+		static int	pitchedEvents	( const Sguidoelement& voice );
 		virtual void visitStart		( SARVoice& elt );
 		virtual void setPitch		( SARNote& note, const pitchvisitor::TPitch& pitch, int& currentOctave ) const;
 		virtual void startChord		( SARChord& elt, bool clone );
@@ -95,6 +98,22 @@ template <typename T> class gar_export pitchApplyOperation : public pitchApplyBa
 			\return a new score
 		*/
 		Sguidoelement operator() ( const Sguidoelement& score, pitchIterator start, pitchIterator end ) {
+			std::vector<Sguidoelement> voices = voicepool::voices (score);
+			if (voices.size()) {
+				// each voice starts with the pitches left by the previous voices
+				std::vector<pitchIterator> starts;
+				pitchIterator pos = start;
+				for (const auto& voice: voices) {
+					starts.push_back (pos);
+					for (int n = pitchedEvents (voice); n && (pos != end); n--) pos++;
+				}
+				chordPitchMode mode = fMode;
+				Sguidoelement out = voicepool::apply (score, [&starts, end, mode] (const Sguidoelement& voice, size_t i) {
+					pitchApplyOperation<T> op (mode);
+					return op (voice, starts[i], end);
+				});
+				if (out) return out;
+			}
 			fPos = start;
 			fEndPos = end;
 			return browse(score);
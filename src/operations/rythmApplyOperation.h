@@ -30,10 +30,12 @@
 #include "AROthers.h"
 #include "arexport.h"
 #include "clonevisitor.h"
+#include "counteventsvisitor.h"
 #include "operation.h"
 #include "guidorational.h"
 #include "rythmvisitor.h"
 #include "tree_browser.h"
+#include "voicepool.h"
 
 namespace guido 
 {
@@ -87,6 +89,22 @@ template <typename T> class gar_export rythmApplyOperation : public rythmApplyBa
 			\return a new score
 		*/
 		Sguidoelement operator() ( const Sguidoelement& score, durIterator start, durIterator end ) {
+			std::vector<Sguidoelement> voices = voicepool::voices (score);
+			if (voices.size()) {
+				// each voice starts with the durations left by the previous voices
+				std::vector<durIterator> starts;
+				counteventsvisitor cev;
+				durIterator pos = start;
+				for (const auto& voice: voices) {
+					starts.push_back (pos);
+					for (int n = cev.count (voice); n && (pos != end); n--) pos++;
+				}
+				Sguidoelement out = voicepool::apply (score, [&starts, end] (const Sguidoelement& voice, size_t i) {
+					rythmApplyOperation<T> op;
+					return op (voice, starts[i], end);
+				});
+				if (out) return out;
+			}
 			fRPos = start;
 			fEndPos = end;
 			return browse(score);
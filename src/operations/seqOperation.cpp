@@ -70,7 +70,7 @@ class gar_export seqCleaner : public clonevisitor
 	protected:
 		SARNote			fFirstTied;			// used for merging tied notes carrying begin-end markers
 		Sguidoelement	fFirstCTied;		// used for merging chords notes carrying begin-end markers
-		std::map<std::string,Sguidoelement>	fEndTags; // used for cancelling xxxEnd|Begin sequence carrying end-begin markers
+		tagsmap			fEndTags;			// used for cancelling xxxEnd|Begin sequence carrying end-begin markers
 		rational		fCurrentDuration;
 		bool	fInTie;		
 		bool	fTieChord;		
@@ -101,17 +101,17 @@ void seqCleaner::visitStart ( Sguidotag& elt )
 		Sguidoelement end = ARFactory::instance().createTag(elt->getName(), elt->getID());
 		end = copy(elt, end);
 		clonevisitor::push (end, false);
-		fEndTags[end->getName()] = end;
+		fEndTags.set (elt->getType(), dynamic_cast<guidotag*>((guidoelement*)end));
 		done = true;			// manual copy to keep the element in the end map
 	}
 	// check if it corresponds to a previous end tag
 	else if (elt->beginTag() && (status == markers::kOpenedBegin)) {
-		string name = elt->matchTag();
-		Sguidoelement end = fEndTags[name];
+		int match = elt->matchType();
+		Sguidoelement end = fEndTags[match];
 		if (end) {
 			markers::setMark (elt, markers::kClosed);		// mark both as close
 			markers::setMark (end, markers::kClosed);		// they should be removed
-			fEndTags[name] = (void*)0;
+			fEndTags.reset (match);
 		}
 	}
 	if (!fInTie && !done) clonevisitor::visitStart (elt);
@@ -204,7 +204,7 @@ Sguidoelement seqOperation::operator() ( const Sguidoelement score1, const Sguid
 			if (s2i != sc2->lend()) {
 				fState = kInSecondScore;
                 countvisitor<SARKey> keys;
-				if (fPosTags["key"] && !keys.count(*s2i)) {
+				if (fPosTags[kTKey] && !keys.count(*s2i)) {
 					Sguidotag k = ARFactory::instance().createTag("key");
 					Sguidoattribute attr = guidoattribute::create();
 					attr->setValue(0L);
@@ -239,8 +239,8 @@ Sguidoelement seqOperation::operator() ( const Sguidoelement score1, const Sguid
 SARMusic seqOperation::operator() ( const SARMusic& score1, const SARMusic& score2 )
 {
 	Sguidoelement result = (*this)(
-		score1 ? Sguidoelement(score1) : score1,
-		score2 ? Sguidoelement(score2) : score2
+		Sguidoelement(score1),
+		Sguidoelement(score2)
 	);
 	return dynamic_cast<ARMusic*>((guidoelement*)result);
 }
@@ -248,15 +248,14 @@ SARMusic seqOperation::operator() ( const SARMusic& score1, const SARMusic& scor
 //________________________________________________________________________
 void seqOperation::storeTag(Sguidotag tag)
 {
-	const string& name = tag->getName();
+	int type = tag->getType();
 	if (tag->beginTag())
-		fRangeTags[name] = tag;
+		fRangeTags.set (type, tag);
 	else if (tag->endTag())
-		fRangeTags[tag->matchTag()] = (void*)0;
+		fRangeTags.reset (tag->matchType());
 	else if (tag->size())
-		fRangeTags[name] = tag;
+		fRangeTags.set (type, tag);
 	else {
-		int type = tag->getType();
 		bool store = 
 			(type == kTBarFormat ) || 
 			(type == kTBeamsAuto ) || 
@@ -273,19 +272,19 @@ void seqOperation::storeTag(Sguidotag tag)
 			((type >= kTStaff) && (type <= kTTempo)) ||
 			(type == kTTitle ) || 
 			(type == kTUnits );
-		if (store) 	fPosTags[name] = tag;
+		if (store) 	fPosTags.set (type, tag);
 	}
 }
 
 //________________________________________________________________________
 void seqOperation::endTag(Sguidotag tag)
 {
-	const string& name = tag->getName();
+	int type = tag->getType();
 	if (tag->size()) {
-		fRangeTags[name] = (void*)0;
+		fRangeTags.reset (type);
 		if (markers::opened (tag) > 1) {
 			Sguidotag copy = dynamic_cast<guidotag*>((guidoelement*)fStack.top());
-			fOpenedTags[name] = copy;
+			fOpenedTags.set (type, copy);
 		}
 	}
 }
@@ -295,12 +294,12 @@ void seqOperation::endTag(Sguidotag tag)
 bool seqOperation::currentTag(Sguidotag tag, bool end)
 {
 	bool ret = false;
-	const string& name = tag->getName();
+	int type = tag->getType();
 	if (!tag->size()) {						// for position tags only
-		Sguidotag cur = fPosTags[name];		// look for an previous similar tag
+		const Sguidotag& cur = fPosTags[type];	// look for an previous similar tag
 		if (cur) {
 			ret = (*cur == tag);			// check if equal
-			if (end) fPosTags[name] = (void*)0;	// in case this is the tag end, remove the current one
+			if (end) fPosTags.reset (type);	// in case this is the tag end, remove the current one
 		}
 	}
 	return ret;
@@ -361,20 +360,20 @@ bool seqOperation::matchOpenedTag(Sguidotag tag, bool end)
 {
 	int type = markers::opened (tag);
 	if (type & markers::kOpenedBegin) {					// first check the tag openness status
-		Sguidotag match = fOpenedTags[tag->getName()];	// and look for a previously similar opened tag
+		Sguidotag match = fOpenedTags[tag->getType()];	// and look for a previously similar opened tag
 		if (match) {									// we've found one
 
 			if (checkmatch (tag, match)) {				// and we check if they match i.e. if their openness match (begin<->end)
 				if (end) {								// done with the current match
 														// the opened marker should be updated
 					markers::setMark (match, (markers::opened (match)==markers::kOpenedEnd) ? markers::kClosed : markers::kOpenedBegin);
-					fOpenedTags[tag->getName()] = (void*)0;	// the tag is removed from the opened tag list
+					fOpenedTags.reset (tag->getType());	// the tag is removed from the opened tag list
 					fCurrentMatch = (void*)0;				// and the current match is cleared
 					fFirstInSecondScore = false;
 				}
 				else {									// that's the beginning of a match
 					fCurrentMatch = tag;				// store the first tag of the matching pair
-					match->push (tag->elements());		// transfer elements to matched tag
+					match->push (std::move(tag->elements()));	// transfer elements to matched tag
 					tag->clear();						// clears the current tag
 				}
 				return true;
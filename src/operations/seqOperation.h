@@ -24,8 +24,6 @@
 #ifndef __seqOperation__
 #define __seqOperation__
 
-#include <map>
-
 #include "arexport.h"
 #include "ARTypes.h"
 #include "ARTag.h"
@@ -52,9 +50,9 @@ class gar_export seqOperation :
 	public visitor<SAREndBar>
 {
     private:
-		std::map<std::string,Sguidotag> fRangeTags;
-		std::map<std::string,Sguidotag> fPosTags;
-		std::map<std::string,Sguidotag> fOpenedTags;
+		tagsmap	fRangeTags;
+		tagsmap	fPosTags;
+		tagsmap	fOpenedTags;
 		Sguidotag fCurrentMatch;
 
 		rational fCurrentDuration;
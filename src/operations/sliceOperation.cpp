@@ -0,0 +1,118 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+
+#ifdef WIN32
+# pragma warning (disable : 4786)
+#endif
+
+#include "ARNote.h"
+#include "AROthers.h"
+#include "headOperation.h"
+#include "sliceOperation.h"
+
+using namespace std;
+
+namespace guido
+{
+
+//_______________________________________________________________________________
+Sguidoelement sliceOperation::operator() ( const Sguidoelement& score, const rational& start, const rational& end, int startVoice, int endVoice, bool pushTags )
+{
+	fCurrentOctave = ARNote::kDefaultOctave;
+	fCurrentNoteDots = 0;
+	fStartPoint = start;
+	fEndPoint = end;
+	fStartVoice = startVoice;
+	fEndVoice = endVoice;
+	fCurrentVoice = 0;
+	fPushTags = pushTags;
+
+	Sguidoelement part;
+	if (score) {
+		fScore = score;
+		fBrowser.stop (false);
+		fBrowser.browse (*score);
+		fScore = Sguidoelement();
+		if (fStack.size()) {
+			part = fStack.top();
+			fStack.pop();
+		}
+	}
+	fPushTags = true;
+	if (!part) return part;
+
+	headOperation head;
+	head.share (true);			// part is an intermediate result, dropped once cut
+	return head (part, end - start);
+}
+
+//________________________________________________________________________
+// the voices are counted from 1 while the range is 0 based
+bool sliceOperation::copy () const	{ return (fCurrentVoice > fStartVoice) && (fCurrentVoice <= fEndVoice + 1); }
+
+//________________________________________________________________________
+// The visit methods
+//________________________________________________________________________
+void sliceOperation::visitStart ( SARVoice& elt )
+{
+	fCurrentVoice++;
+	if (copy()) {
+		fVoice = fCurrentVoice - 1;		// the voices out of the range are not counted by the tail operation
+		tailOperation::visitStart (elt);
+	}
+	else fBrowser.stop();		// the voice is not browsed
+}
+
+//________________________________________________________________________
+void sliceOperation::visitEnd ( SARVoice& elt )
+{
+	if (copy()) tailOperation::visitEnd (elt);
+	fBrowser.stop (fCurrentVoice > fEndVoice);		// the next voices are out of the range
+}
+
+//________________________________________________________________________
+// once the start point is passed, the tail operation doesn't maintain the
+// voice date anymore: it is maintained here to stop at the end point
+void sliceOperation::visitStart ( SARChord& elt )
+{
+	bool copying = fCopy;
+	rational date = fDuration.currentVoiceDate();
+	tailOperation::visitStart (elt);
+	if (copying) {
+		fDuration.visitStart (elt);
+		if (date > fEndPoint) fBrowser.stop();	// the first event after the end point is kept for the end cut
+	}
+}
+
+//________________________________________________________________________
+void sliceOperation::visitStart ( SARNote& elt )
+{
+	rational date = fDuration.currentVoiceDate();
+	bool copying = fStartPoint < date;
+	tailOperation::visitStart (elt);
+	if (copying) {
+		bool inChord = fDuration.inChord();
+		fDuration.visitStart (elt);
+		if (!inChord && (date > fEndPoint)) fBrowser.stop();
+	}
+}
+
+} // namespace
@@ -0,0 +1,79 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+
+#ifndef __sliceOperation__
+#define __sliceOperation__
+
+#include "arexport.h"
+#include "ARTypes.h"
+#include "guidorational.h"
+#include "tailOperation.h"
+
+namespace guido
+{
+
+/*!
+\addtogroup operations
+@{
+*/
+
+/*!
+\brief A visitor that extracts a time and voice range of a score.
+
+	The result is the same as cutting the score with topOperation, bottomOperation,
+	tailOperation and headOperation, but the voices out of the range are not visited
+	and the other voices are browsed once, up to the range end: the end cut is then
+	applied to the extracted part only.
+*/
+class gar_export sliceOperation : public tailOperation
+{
+    public:
+ 				 sliceOperation()	{}
+		virtual ~sliceOperation()	{}
+
+		/*! extracts a range of a score
+			\param score the score
+			\param start the range start date
+			\param end the range end date
+			\param startVoice the first voice of the range (0 based)
+			\param endVoice the last voice of the range
+			\param pushTags whether the tags in effect at the start date (e.g. clef, key, meter or opened slurs) are carried into the result
+			\return a new score
+		*/
+		Sguidoelement operator() ( const Sguidoelement& score, const rational& start, const rational& end, int startVoice, int endVoice, bool pushTags=true );
+
+    protected:
+		rational	fEndPoint;
+		int			fStartVoice, fEndVoice, fCurrentVoice;
+
+		virtual bool copy () const;
+
+		virtual void visitStart( SARVoice& elt );
+		virtual void visitStart( SARChord& elt );
+		virtual void visitStart( SARNote& elt );
+		virtual void visitEnd  ( SARVoice& elt );
+};
+
+/*! @} */
+
+} // namespace
+
+#endif
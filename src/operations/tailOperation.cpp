@@ -30,13 +30,16 @@
 #include <string>
 
 #include "ARChord.h"
+#include "ARFactory.h"
 #include "ARNote.h"
 #include "AROthers.h"
 #include "ARTag.h"
 #include "clonevisitor.h"
+#include "elementoperationvisitor.h"
 #include "markers.h"
 #include "tailOperation.h"
 #include "tree_browser.h"
+#include "voiceindexvisitor.h"
 
 using namespace std;
 
@@ -44,7 +47,7 @@ namespace guido
 {
 
 //_______________________________________________________________________________
-tailOperation::tailOperation()	{}
+tailOperation::tailOperation() : fIndex(0), fVoice(0)	{ fBrowser.set(this); }
 tailOperation::~tailOperation()	{}
 
 //_______________________________________________________________________________
@@ -61,11 +64,14 @@ Sguidoelement tailOperation::operator() ( const Sguidoelement& score, const rati
 	fCurrentOctave = ARNote::kDefaultOctave;
 	fCurrentNoteDots = 0;
 	fStartPoint = duration;
+	fVoice = 0;
 
 	Sguidoelement outscore;
 	if (score) {
-		tree_browser<guidoelement> tb(this);
-		tb.browse (*score);
+		fScore = score;
+		fBrowser.stop (false);
+		fBrowser.browse (*score);
+		fScore = Sguidoelement();
 		if (fStack.size()) {
 			outscore = fStack.top();
 			fStack.pop();
@@ -87,10 +93,13 @@ void tailOperation::flushTags()
 	for (unsigned int i = 0; i < fCurrentTags.size(); i++) {
 		Sguidotag tag = fCurrentTags[i];
 		if (tag) {
-			if (tag->beginTag()) markers::markOpened (tag, false);
-			else if (tag->size()) markers::markOpened (tag, false);
-			else if (ornament(tag)) continue;		// don't flush empty ornaments
-			clonevisitor::visitStart (tag);
+			bool opened = tag->beginTag() || tag->size();
+			if (!opened && ornament(tag)) continue;		// don't flush empty ornaments
+			// the input tag is left unchanged: the marker is set to its copy
+			Sguidoelement elt = ARFactory::instance().createTag(tag->getName(), tag->getID());
+			Sguidotag ctag = dynamic_cast<guidotag*>((guidoelement*)clonevisitor::copy (tag, elt));
+			if (opened) markers::markOpened (ctag, false);
+			push (elt, tag->size() ? true : false);
 		}
 	}
 	fCurrentTags.clear();
@@ -112,11 +121,33 @@ void tailOperation::visitStart ( SARVoice& elt )
 {
 //cerr << "start voice --------------" << endl;
 	fCurrentTags.clear();
+	fSkippedTags.clear();
 	fCopy = fPopTie = false;
 	fCurrentOctave = ARNote::kDefaultOctave;
 	fCurrentNoteDots = 0;
 	clonevisitor::visitStart (elt);
 	fDuration.visitStart (elt);
+	if (fIndex) seek (elt);
+	fVoice++;
+}
+
+//________________________________________________________________________
+// the voice children before the last index snapshot that precedes the start
+// point are not browsed: the operation state is restored from the snapshot
+void tailOperation::seek ( SARVoice& elt )
+{
+	voiceindexvisitor* index = fIndex->voiceIndex (fScore, fVoice);
+	if (!index || ((ARVoice*)index->voice() != (ARVoice*)elt)) return;
+	const voicesnapshot& snapshot = index->seek (fStartPoint);
+	if (!snapshot.fTop) return;
+
+	fDuration.resume (snapshot.fState.fDate, snapshot.fState.fNoteDuration, snapshot.fState.fDots);
+	fCurrentOctave = snapshot.fPitchOctave;
+	if (fPushTags) fCurrentTags = snapshot.fTags;
+	const ctree<guidoelement>::branchs& children = elt->elements();
+	for (size_t i = snapshot.fTop; (i < children.size()) && !fBrowser.done(); i++)
+		fBrowser.browse (*children[i]);
+	fBrowser.stop();			// the voice children have been browsed
 }
 
 //________________________________________________________________________
@@ -126,7 +157,8 @@ void tailOperation::visitStart ( SARChord& elt )
 	else {						// check if startpoint is reached
 		rational remain = fStartPoint - fDuration.currentVoiceDate();
 		int dots = fDuration.currentDots();
-		rational dur = elt->totalduration(fDuration.currentNoteDuration(), dots);
+		rational current = fDuration.currentNoteDuration();
+		rational dur = elt->totalduration(current, dots);
 		if (remain < dur) {
 			flushTags();
 			push(makeOpenedTie(), true);					// push the tag to the current copy
@@ -141,17 +173,18 @@ void tailOperation::visitStart ( SARChord& elt )
 void tailOperation::visitStart ( SARNote& elt )
 {
 	if (fStartPoint < fDuration.currentVoiceDate()) {
-		if (!elt->isRest()) {
-			if (fForceOctave && elt->implicitOctave())
-				elt->SetOctave (fCurrentOctave);
-			fForceOctave = false;
-		}
-		if (fForceDuration && elt->implicitDuration()) {
-			*elt = fDuration.currentNoteDuration();
-			elt->SetDots (fDuration.currentDots());
+		SARNote note = elt;
+		bool forceOctave = fForceOctave && !elt->isRest() && elt->implicitOctave();
+		bool forceDuration = fForceDuration && elt->implicitDuration();
+		if (forceOctave || forceDuration) note = copy (elt);	// the input note is left unchanged
+		if (forceOctave) note->SetOctave (fCurrentOctave);
+		if (!elt->isRest()) fForceOctave = false;
+		if (forceDuration) {
+			*note = fDuration.currentNoteDuration();
+			note->SetDots (fDuration.currentDots());
 		}
 		fForceDuration = false;
-		clonevisitor::visitStart (elt);
+		clonevisitor::visitStart (note);
 	}
 	else {												// check if startpoint will be reached
 		rational remain = fStartPoint - fDuration.currentVoiceDate();
@@ -168,23 +201,24 @@ void tailOperation::visitStart ( SARNote& elt )
 		else {
 			fDuration.visitStart (elt);
 			fCopy = true;
-			*elt = dur - remain;
-			elt->SetDots(0);
-			fForceDuration = (elt->duration() != fDuration.currentNoteDuration());
+			SARNote note = copy (elt);					// the input note is left unchanged
+			*note = dur - remain;
+			note->SetDots(0);
+			fForceDuration = (note->duration() != fDuration.currentNoteDuration());
 			fForceOctave = false;
-			if (elt->implicitOctave()) {
-				if (!elt->isRest()) elt->SetOctave (fCurrentOctave);
+			if (note->implicitOctave()) {
+				if (!note->isRest()) note->SetOctave (fCurrentOctave);
 				else fForceOctave = true;
 			}
 
 			flushTags();
 			// notes splitted by the operation are marked using an opened tie
-			if (remain.getNumerator() && !fDuration.inChord() && !elt->isEmpty()) {
+			if (remain.getNumerator() && !fDuration.inChord() && !note->isEmpty()) {
 				push(makeOpenedTie(), true);
-				clonevisitor::visitStart (elt);
+				clonevisitor::visitStart (note);
 				fStack.pop();
 			}
-			else clonevisitor::visitStart (elt);
+			else clonevisitor::visitStart (note);
 		}
 	}
 }
@@ -192,8 +226,9 @@ void tailOperation::visitStart ( SARNote& elt )
 //________________________________________________________________________
 void tailOperation::pushTag ( Sguidotag& elt )
 {
+	int type = elt->getType();
 	for (unsigned int i=0; i < fCurrentTags.size(); i++) {
-		if (fCurrentTags[i] && (fCurrentTags[i]->getName() == elt->getName())) {
+		if (fCurrentTags[i] && (fCurrentTags[i]->getType() == type)) {
 			fCurrentTags[i] = elt;
 			return;
 		}
@@ -222,12 +257,14 @@ bool tailOperation::ornament ( Sguidotag& elt )
 void tailOperation::popTag ( Sguidotag& elt )
 {
 	if (elt->endTag() || elt->size()) {
+		int type = elt->getType();
+		int match = elt->matchType();
 		for (unsigned int i=0; i < fCurrentTags.size(); i++) {
 			if (fCurrentTags[i]) {
-				if (fCurrentTags[i]->getName() == elt->getName()) {
+				if (fCurrentTags[i]->getType() == type) {
 					fCurrentTags[i] = (void*)0;
 				}
-				else if (fCurrentTags[i]->getName() == elt->matchTag()) {
+				else if (match && (fCurrentTags[i]->getType() == match)) {
 					fCurrentTags[i] = (void*)0;
 				}
 			}
@@ -253,6 +290,7 @@ void tailOperation::visitEnd ( SARVoice& elt )
 {
 	flushTags();
 	clonevisitor::visitEnd (elt);
+	fBrowser.stop (false);
 	// adjusts the stack
 	// may be necessary due to potential end inside range tags
 	while (fStack.size() > 1)
@@ -267,8 +305,9 @@ void tailOperation::visitStart ( Sguidotag& elt )
 	}
 	else {
 		int type = elt->getType();
-		if ((!fPushTags) || (type == kTText) ||(type == kTLyrics))		// skip text and lyrics
-			elt->setID (-1);							// to prevent the tag from being popped by visitEnd
+		if ((!fPushTags) || (type == kTText) ||(type == kTLyrics)) {		// skip text and lyrics
+			if (elt->size()) fSkippedTags.push_back (elt);		// to prevent the tag from being popped by visitEnd
+		}
 		else pushTag (elt);
 	}
 }
@@ -276,12 +315,11 @@ void tailOperation::visitStart ( Sguidotag& elt )
 //________________________________________________________________________
 void tailOperation::visitEnd ( Sguidotag& elt )
 {
-	if (fCopy) {
-		int type = elt->getType();
-		if ((type == kTText) ||(type == kTLyrics))		// skip text and lyrics
-			if (elt->getID () == -1) return;			// when previously skipped by visitStart
-		clonevisitor::visitEnd (elt);
+	if (fSkippedTags.size() && ((guidotag*)fSkippedTags.back() == (guidotag*)elt)) {
+		fSkippedTags.pop_back();						// previously skipped by visitStart
+		return;
 	}
+	if (fCopy) clonevisitor::visitEnd (elt);
 	else popTag (elt);
 }
 
@@ -33,10 +33,13 @@
 #include "clonevisitor.h"
 #include "durationvisitor.h"
 #include "operation.h"
+#include "tree_browser.h"
 
 namespace guido 
 {
 
+class elementoperationvisitor;
+
 /*!
 \addtogroup operations
 @{
@@ -44,6 +47,9 @@ namespace guido
 
 /*!
 \brief A visitor that cuts the tail of a score.
+
+	When a time index of the score is available (see setIndex), each voice is
+	browsed from the last index snapshot before the cut point instead of its start.
 */
 class gar_export tailOperation :
 	public operation,
@@ -75,6 +81,12 @@ class gar_export tailOperation :
 			\return a new score
 		*/
 		SARMusic operator() ( const SARMusic& score1, const SARMusic& score2 );
+
+		/*! sets the time index used to seek the cut point (see voiceindexvisitor)
+			\param editor the editor that keeps the time index of the score to be cut,
+			null to browse the voices from their start
+		*/
+		void	setIndex (elementoperationvisitor* editor)	{ fIndex = editor; }
   
      protected:
 		enum state  { kSkip, kStartPending, kCopy };
@@ -89,6 +101,11 @@ class gar_export tailOperation :
 		int				fCurrentOctave;
 		int				fCurrentNoteDots;
 
+		tree_browser<guidoelement> fBrowser;
+		elementoperationvisitor* fIndex;	// the editor that keeps the score time index (if any)
+		Sguidoelement	fScore;				// the score being cut, used to get the voices index
+		unsigned int	fVoice;				// the index of the voice being browsed
+
 		virtual void visitStart( SARVoice& elt );
 		virtual void visitStart( SARChord& elt );
 		virtual void visitStart( SARNote& elt );
@@ -99,6 +116,7 @@ class gar_export tailOperation :
 		virtual void visitEnd  ( Sguidotag& elt );
 
 		Sguidoelement makeOpenedTie() const;
+		void seek (SARVoice& elt);
 
      private:
 		bool ornament (Sguidotag& elt );
@@ -106,6 +124,7 @@ class gar_export tailOperation :
 		void popTag (Sguidotag& elt );
 		
 		std::vector<Sguidotag> fCurrentTags;
+		std::vector<Sguidotag> fSkippedTags;	// the skipped range tags being browsed
 		void flushTags ();
 };
 
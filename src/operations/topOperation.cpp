@@ -45,6 +45,7 @@ Sguidoelement topOperation::operator() ( const Sguidoelement& score, int voicenu
 {
 	fVoiceNum = voicenum;
 	fCurrentVoice = 0;
+	fBrowser.stop (false);
 	Sguidoelement outscore;
 	if (score) {
 		fBrowser.browse (*score);
@@ -70,14 +71,20 @@ bool topOperation::copy  () const	{ return fCurrentVoice <= fVoiceNum; }
 void topOperation::visitStart ( SARVoice& elt )
 {
 	fCurrentVoice++;
-	clonevisitor::visitStart (elt);
+	if (fShare && copy()) {			// the voice is shared with the input score
+		Sguidoelement voice = elt;
+		push (voice, false);
+		fBrowser.stop();
+	}
+	else clonevisitor::visitStart (elt);
 }
 
 //________________________________________________________________________
 void topOperation::visitEnd ( SARVoice& elt )	
 { 	
-	clonevisitor::visitEnd (elt); 
-	if (fCurrentVoice > fVoiceNum) fBrowser.stop(); 
+	if (fShare) fBrowser.stop (false);
+	else clonevisitor::visitEnd (elt); 
+	if (fCurrentVoice >= fVoiceNum) fBrowser.stop();	// the next voices are not browsed
 }
 
 }
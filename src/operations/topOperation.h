@@ -39,6 +39,9 @@ namespace guido
 
 /*!
 \brief A visitor that cuts the tail of a score voices.
+
+	When sharing is enabled (see clonevisitor::share()), the preserved voices
+	are shared with the input score instead of being copied.
 */
 class gar_export topOperation :
 	public operation,
@@ -37,6 +37,7 @@
 #include "firstpitchvisitor.h"
 #include "transposeOperation.h"
 #include "tree_browser.h"
+#include "voicepool.h"
 
 using namespace std;
 
@@ -70,6 +71,12 @@ SARMusic transposeOperation::operator() ( const SARMusic& score1, const SARMusic
 //_______________________________________________________________________________
 Sguidoelement transposeOperation::operator() ( const Sguidoelement& score, int steps )
 {
+	Sguidoelement out = voicepool::apply (score, [steps] (const Sguidoelement& voice, size_t) {
+		transposeOperation op;
+		return op (voice, steps);
+	});
+	if (out) return out;		// the voices have been transposed concurrently
+
 	fCurrentOctaveIn = fCurrentOctaveOut = ARNote::kDefaultOctave;			// default current octave
 	fChromaticSteps = steps;
 	fOctaveChange = getOctave(fChromaticSteps);
@@ -0,0 +1,246 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#include <cstring>
+#include <stdexcept>
+
+#include "binaryreader.h"
+#include "ARFactory.h"
+#include "ARChord.h"
+#include "ARNote.h"
+#include "AROthers.h"
+#include "ARTag.h"
+#include "garbinary.h"
+#include "guidocomment.h"
+#include "guidovariable.h"
+
+using namespace std;
+
+namespace guido
+{
+
+using namespace garbinary;
+
+//______________________________________________________________________________
+bool binaryreader::isBinary (const char* data, size_t size)
+{
+	return data && (size >= kMagicSize) && !memcmp (data, kMagic, kMagicSize);
+}
+
+//______________________________________________________________________________
+Sguidoelement binaryreader::read (const char* data, size_t size)
+{
+	fError.clear();
+	if (!isBinary (data, size)) {
+		fError = "not a binary score";
+		return 0;
+	}
+	fData = (const unsigned char*)data + kMagicSize;
+	fEnd = (const unsigned char*)data + size;
+	fDepth = 0;
+	Sguidoelement elt;
+	try {
+		if (num() != kVersion) throw runtime_error ("unsupported binary score version");
+		elt = element();
+	}
+	catch (const exception& e) {
+		fError = e.what();
+		elt = Sguidoelement();
+	}
+	fStrings.clear();
+	fData = fEnd = nullptr;
+	return elt;
+}
+
+//______________________________________________________________________________
+SARMusic binaryreader::readMusic (const char* data, size_t size)
+{
+	Sguidoelement elt = read (data, size);
+	SARMusic music = dynamic_cast<ARMusic*>((guidoelement*)elt);
+	if (elt && !music) fError = "not a binary score";
+	return music;
+}
+
+//______________________________________________________________________________
+unsigned long binaryreader::num ()
+{
+	unsigned long v;
+	if (!getnum (fData, fEnd, v)) throw runtime_error ("unexpected end of binary score");
+	return v;
+}
+
+long binaryreader::snum ()
+{
+	long v;
+	if (!getsigned (fData, fEnd, v)) throw runtime_error ("unexpected end of binary score");
+	return v;
+}
+
+// a count of items that are at least one byte long each
+unsigned long binaryreader::count ()
+{
+	unsigned long n = num();
+	if (n > (unsigned long)(fEnd - fData)) throw runtime_error ("invalid count in binary score");
+	return n;
+}
+
+//______________________________________________________________________________
+const string& binaryreader::str ()
+{
+	unsigned long index = num();
+	if (index < fStrings.size()) return fStrings[index];
+	if (index > fStrings.size()) throw runtime_error ("invalid string in binary score");
+	unsigned long size = num();
+	if (size > (unsigned long)(fEnd - fData)) throw runtime_error ("unexpected end of binary score");
+	fStrings.emplace_back ((const char*)fData, size);
+	fData += size;
+	return fStrings.back();
+}
+
+//______________________________________________________________________________
+Sguidoattribute binaryreader::attribute ()
+{
+	Sguidoattribute attr = guidoattribute::create (fArena);
+	const string& name = str();
+	if (name.size()) attr->setName (name);
+	const string& unit = str();
+	if (unit.size()) attr->setUnit (unit);
+	if (fData >= fEnd) throw runtime_error ("unexpected end of binary score");
+	int type = *fData++;
+	bool quote = (type & kQuote) != 0;
+	switch (type & kTypeMask) {
+		case guidoattribute::kLong:
+			attr->setValue (snum());
+			attr->setQuoteVal (quote);
+			break;
+		case guidoattribute::kFloat: {
+			if (fEnd - fData < 8) throw runtime_error ("unexpected end of binary score");
+			unsigned long long bits = 0;
+			for (int i = 7; i >= 0; i--) bits = (bits << 8) | fData[i];
+			fData += 8;
+			double value;
+			memcpy (&value, &bits, sizeof(value));
+			attr->setValue (value);
+			attr->setQuoteVal (quote);
+			}
+			break;
+		case guidoattribute::kString:
+			attr->setValue (str(), quote);
+			break;
+		default:
+			throw runtime_error ("invalid attribute in binary score");
+	}
+	return attr;
+}
+
+//______________________________________________________________________________
+void binaryreader::elements (Sguidoelement& elt)
+{
+	unsigned long n = count();
+	elt->elements().reserve (n);
+	while (n--) elt->push (element());
+}
+
+template <typename T> void binaryreader::elements (T& elt, void (T::*add)(Sguidoelement))
+{
+	unsigned long n = count();
+	while (n--) (elt.*add)(element());
+}
+
+//______________________________________________________________________________
+Sguidoelement binaryreader::element ()
+{
+	if (fEnd - fData < 2) throw runtime_error ("unexpected end of binary score");
+	if (++fDepth > kMaxDepth) throw runtime_error ("elements nested too deeply in binary score");
+	int kind = *fData++;
+	int flags = *fData++;
+	const string& name = str();
+
+	const ARFactory& factory = ARFactory::instance();
+	garena* arena = fArena;
+	Sguidoelement elt;
+	switch (kind) {
+		case kMusic: {
+			SARMusic music = factory.createMusic (arena);
+			long base = snum();		// 0 when the tick base is unknown
+			if ((base < 0) || (base > ARMusic::kMaxTickBase)) throw runtime_error ("invalid tick base in binary score");
+			music->setTickBase (base);
+			elements (*music, &ARMusic::addHeader);
+			elt = music;
+			}
+			break;
+		case kVoice: {
+			SARVoice voice = factory.createVoice (arena);
+			elements (*voice, &ARVoice::addBefore);
+			elt = voice;
+			}
+			break;
+		case kChord:
+			elt = factory.createChord (arena);
+			break;
+		case kNote: {
+			SARNote note = factory.createNote (name, arena);
+			long num = snum();
+			long den = snum();
+			rational duration (num, den);
+			if (!ARNote::implicitDuration (duration)) *note = duration;
+			note->SetDots (int(snum()));
+			note->SetOctave (int(snum()));
+			note->SetAccidental (int(snum()));
+			elt = note;
+			}
+			break;
+		case kTag:
+			elt = factory.createTag (name, snum(), arena);
+			if (!elt) throw runtime_error ("unknown tag in binary score");
+			break;
+		case kComment:
+			elt = guidocomment::create (arena);
+			break;
+		case kVariable:
+			elt = factory.createVariable (name, arena);
+			break;
+		case kElement:
+			elt = guidoelement::create (arena);
+			break;
+		default:
+			throw runtime_error ("invalid element in binary score");
+	}
+	if (elt->getName() != name) elt->setName (name);
+	if (flags & kAuto) elt->setAuto (true);
+	if (flags & kAttributes) {
+		unsigned long n = count();
+		while (n--) elt->add (attribute());
+	}
+	if (flags & kElements) elements (elt);
+
+	if (kind == kMusic) {
+		SARMusic music = dynamic_cast<ARMusic*>((guidoelement*)elt);
+		elements (*music, &ARMusic::addFooter);
+	}
+	else if (kind == kVoice) {
+		SARVoice voice = dynamic_cast<ARVoice*>((guidoelement*)elt);
+		elements (*voice, &ARVoice::addAfter);
+	}
+	fDepth--;
+	return elt;
+}
+
+} // namespace
@@ -0,0 +1,87 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#pragma once
+
+#include <deque>
+#include <string>
+
+#include "arexport.h"
+#include "ARTypes.h"
+#include "garena.h"
+
+namespace guido
+{
+
+/*!
+\brief	A reader for the binary form of the scores (see garbinary and binaryvisitor).
+
+	The tree is rebuilt directly from the binary data, without the gmn parser.
+	As for the parser, independent readers can be used concurrently from
+	different threads, and the tree is allocated in an arena when one is set.
+	The elements nesting is limited to kMaxDepth, which keeps the reader
+	recursion from exhausting the stack on invalid data.
+*/
+class gar_export binaryreader
+{
+	Sgarena						fArena;		// optional arena for the read scores
+	const unsigned char*		fData = nullptr;
+	const unsigned char*		fEnd = nullptr;
+	std::deque<std::string>		fStrings;	// the strings already read
+	std::string					fError;
+	int							fDepth = 0;	// the elements nesting depth
+
+	unsigned long		num ();
+	long				snum ();
+	unsigned long		count ();
+	const std::string&	str ();
+	Sguidoattribute		attribute ();
+	Sguidoelement		element ();
+	void				elements (Sguidoelement& elt);
+	template <typename T> void elements (T& elt, void (T::*add)(Sguidoelement));
+
+	public:
+		enum { kMaxDepth = 1000 };
+
+				 binaryreader() {}
+		virtual ~binaryreader() {}
+
+		//! sets the arena used to allocate the next read scores, null to allocate them on the heap
+		void			setArena (const Sgarena& arena)	{ fArena = arena; }
+		const Sgarena&	getArena () const				{ return fArena; }
+
+		/*! \brief reads the binary form of an element
+			\param data the binary data
+			\param size the data size
+			\return the element, or null when the data are not a valid binary form (see getError())
+		*/
+		Sguidoelement	read (const char* data, size_t size);
+		/*! \brief reads the binary form of a score
+			\return the score, or null when the data are not a valid binary form of a score
+		*/
+		SARMusic		readMusic (const char* data, size_t size);
+		//! the error message of the last read
+		const std::string& getError () const			{ return fError; }
+
+		//! checks whether data start like a binary form
+		static bool		isBinary (const char* data, size_t size);
+};
+
+} // namespace
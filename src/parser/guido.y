@@ -43,8 +43,27 @@ using namespace guido;
 
 static void vadd (std::vector<guido::Sguidoelement>* v1, std::vector<guido::Sguidoelement>* v2)
 {
-	for (auto elt: *v2)
-		v1->push_back(elt);
+	for (auto& elt: *v2)
+		v1->push_back(std::move(elt));
+}
+
+// converts a FLOAT token ([+-]?[0-9]*.[0-9]+) to a float
+// unlike atof, the conversion doesn't depend on the C numeric locale
+static float str2float (const char* str)
+{
+	bool negative = (*str == '-');
+	if ((*str == '-') || (*str == '+')) str++;
+	double intpart = 0;
+	while ((*str >= '0') && (*str <= '9'))
+		intpart = intpart * 10 + (*str++ - '0');
+	double fracpart = 0, scale = 1;
+	if (*str == '.') str++;
+	while ((*str >= '0') && (*str <= '9')) {
+		fracpart = fracpart * 10 + (*str++ - '0');
+		scale *= 10;
+	}
+	double value = intpart + fracpart / scale;
+	return float(negative ? -value : value);
 }
 
 namespace guido
@@ -92,7 +111,7 @@ namespace guido
 	guido::Sguidoelement *		elt;
 	guido::Sguidoattribute*		attr;
 	std::vector<guido::Sguidoelement>*	 velt;
-	std::vector<guido::Sguidoattribute>* vattr;
+	guido::Sguidoattributes* vattr;
 	guido::rational *		r;
 }
 
@@ -115,41 +134,41 @@ namespace guido
 %% 
 
 //_______________________________________________
-gmn			: score
-			| header score							        { debug("header score"); context->setHeader($1); delete $2; } 
+gmn			: score											{ debug("score"); delete $1; }
+			| header score							        { debug("header score"); context->setHeader($1); delete $1; delete $2; } 
 			;
 
-header      : comment							   	 		{ debug("header comment"); $$ = new vector<Sguidoelement>; $$->push_back(*$1); delete $1;}
-			| vardecl							  			{ debug("header variable"); $$ = new vector<Sguidoelement>; $$->push_back(*$1); delete $1;}
-			| header vardecl							  	{ debug("header + variable"); $$=$1; $1->push_back(*$2); delete $2; }
-			| header comment							  	{ debug("header + comment"); $$=$1; $1->push_back(*$2); delete $2; }
+header      : comment							   	 		{ debug("header comment"); $$ = new vector<Sguidoelement>; $$->push_back(std::move(*$1)); delete $1;}
+			| vardecl							  			{ debug("header variable"); $$ = new vector<Sguidoelement>; $$->push_back(std::move(*$1)); delete $1;}
+			| header vardecl							  	{ debug("header + variable"); $$=$1; $1->push_back(std::move(*$2)); delete $2; }
+			| header comment							  	{ debug("header + comment"); $$=$1; $1->push_back(std::move(*$2)); delete $2; }
 			;
 
 score		: STARTCHORD ENDCHORD							{ debug("new score"); $$ = context->newScore(); }
-			| STARTCHORD voicelist ENDCHORD					{ debug("score voicelist"); $$ = context->newScore(); (*$$)->push( *$2); delete $2; }
-			| voice											{ debug("score voice"); $$ = context->newScore(); (*$$)->push( *$1); delete $1; }
+			| STARTCHORD voicelist ENDCHORD					{ debug("score voicelist"); $$ = context->newScore(); (*$$)->push(std::move(*$2)); delete $2; }
+			| voice											{ debug("score voice"); $$ = context->newScore(); (*$$)->push(std::move(*$1)); delete $1; }
 			| score comment									{ debug("score comment"); $$ = $1; context->addFooter(*$2); delete $2; } 
 			;
 
-voicelist	: voice											{ debug("new voicelist"); $$ = new vector<Sguidoelement>; $$->push_back (*$1); delete $1; }
-			| comments voice							    { debug("add voicelist"); $$ = new vector<Sguidoelement>; if ($1) { for (auto c: *$1) context->beforeVoice($2, c); }; $$->push_back (*$2); delete $2; }
-			| voicelist sep voice							{ debug("add voicelist"); $$ = $1; $$->push_back (*$3); delete $3; }
+voicelist	: voice											{ debug("new voicelist"); $$ = new vector<Sguidoelement>; $$->push_back(std::move(*$1)); delete $1; }
+			| comments voice							    { debug("add voicelist"); $$ = new vector<Sguidoelement>; if ($1) { for (auto c: *$1) context->beforeVoice($2, c); }; $$->push_back(std::move(*$2)); delete $2; }
+			| voicelist sep voice							{ debug("add voicelist"); $$ = $1; $$->push_back(std::move(*$3)); delete $3; }
 			;
 
 sep			: SEP											{ debug("SEP"); $$=0; }
 			| SEP comments 									{ debug("SEP comments"); $$=$2; }
 			; 
 
-voice		: STARTSEQ symbols ENDSEQ						{ debug("new voice"); $$ = context->newVoice(); (*$$)->push( *$2); delete $2; }
+voice		: STARTSEQ symbols ENDSEQ						{ debug("new voice"); $$ = context->newVoice(); (*$$)->push(std::move(*$2)); delete $2; }
 			| voice comment									{ debug("voice comment"); $$ = $1; context->afterVoice($$, *$2); delete $2; } 
 			;
 
 symbols		:												{ debug("new symbols"); $$ = new vector<Sguidoelement>; }
-			| symbols music									{ debug("add music"); $$ = $1; $$->push_back(*$2); delete $2; }
-			| symbols tag									{ debug("add tag"); $$ = $1; $$->push_back(*$2); delete $2; }
-			| symbols chord									{ debug("add chord"); $$ = $1; $$->push_back(*$2); delete $2; }
-			| symbols varname								{ debug("add varname"); $$ = $1; $$->push_back(*$2); delete $2; }
-			| symbols comment								{ debug("add comment"); $$ = $1; $$->push_back(*$2); delete $2; }
+			| symbols music									{ debug("add music"); $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
+			| symbols tag									{ debug("add tag"); $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
+			| symbols chord									{ debug("add chord"); $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
+			| symbols varname								{ debug("add varname"); $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
+			| symbols comment								{ debug("add comment"); $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
 			;
 
 vardecl 	: varname EQUAL STRING ENDVAR					{ vdebug("vardecl string", *$1); $$ = $1; context->variableDecl (*$1, context->fText.c_str(), guidoparser::kString);  }
@@ -167,10 +186,10 @@ tag			: positiontag									{ debug("position tag "); $$ = $1; }
 			;
 
 positiontag	: tagid											{ debug("new position tag "); $$ = $1; }
-			| tagid STARTPARAM tagparams ENDPARAM			{ debug("new tag + params"); $$ = $1; (*$1)->add (*$3); delete $3; }
+			| tagid STARTPARAM tagparams ENDPARAM			{ debug("new tag + params"); $$ = $1; (*$1)->add (std::move(*$3)); delete $3; }
 			;
 
-rangetag	: positiontag  STARTRANGE symbols ENDRANGE		{ debug("new range tag "); $$ = $1; (*$1)->push (*$3); delete $3; }
+rangetag	: positiontag  STARTRANGE symbols ENDRANGE		{ debug("new range tag "); $$ = $1; (*$1)->push(std::move(*$3)); delete $3; }
 			;
 
 tagname		: TAGNAME										{ debug("tag name "); $$ = new string(context->fText); }
@@ -194,14 +213,14 @@ tagparam	: tagarg										{ debug("tagparam"); $$ = $1; }
 			| id EQUAL tagarg								{ debug("tagparam"); $$ = $3; (*$3)->setName(*$1); delete $1; }
 			;
 
-tagparams	: tagparam										{ $$ = new vector<Sguidoattribute>; $$->push_back(*$1); delete $1; }
-			| tagparams SEP tagparam						{ $$ = $1; $$->push_back(*$3); delete $3; }
+tagparams	: tagparam										{ $$ = new Sguidoattributes; $$->push_back(std::move(*$1)); delete $1; }
+			| tagparams SEP tagparam						{ $$ = $1; $$->push_back(std::move(*$3)); delete $3; }
 			;
 
 //_______________________________________________
 // chord description
 
-chord		: STARTCHORD chordsymbols ENDCHORD				{ debug("new chord"); $$ = context->newChord(); (*$$)->push(*$2); delete $2; }
+chord		: STARTCHORD chordsymbols ENDCHORD				{ debug("new chord"); $$ = context->newChord(); (*$$)->push(std::move(*$2)); delete $2; }
 			;
 
 chordsymbols: tagchordsymbol								{ $$ = new vector<Sguidoelement>; vadd($$, $1); delete $1; }
@@ -214,17 +233,17 @@ tagchordsymbol: chordsymbol									{ $$ = $1;}
 			| taglist chordsymbol taglist					{ $$ = $1; vadd($$, $2); delete $2; vadd($$, $3); delete $3; }
 			;
 
-chordsymbol	: music											{ $$ = new vector<Sguidoelement>; $$->push_back(*$1); delete $1; }
-			| rangechordtag									{ $$ = new vector<Sguidoelement>; $$->push_back(*$1); delete $1; }
-			| chordsymbol comment							{ $$ = $1; $$->push_back(*$2); delete $2; }
-			| comment chordsymbol							{ debug("comment chord"); $$ = $2; $$->push_back(*$1); delete $1; }
+chordsymbol	: music											{ $$ = new vector<Sguidoelement>; $$->push_back(std::move(*$1)); delete $1; }
+			| rangechordtag									{ $$ = new vector<Sguidoelement>; $$->push_back(std::move(*$1)); delete $1; }
+			| chordsymbol comment							{ $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
+			| comment chordsymbol							{ debug("comment chord"); $$ = $2; $$->push_back(std::move(*$1)); delete $1; }
 			;
 
-rangechordtag : positiontag  STARTRANGE tagchordsymbol ENDRANGE	{ debug("range chord tag"); $$ = $1; (*$$)->push(*$3); delete $3; }
+rangechordtag : positiontag  STARTRANGE tagchordsymbol ENDRANGE	{ debug("range chord tag"); $$ = $1; (*$$)->push(std::move(*$3)); delete $3; }
 			;
 
-taglist		: positiontag									{ debug("new taglist 1"); $$ = new vector<Sguidoelement>; $$->push_back(*$1); delete $1; }
-			| taglist positiontag							{ debug("new taglist 2"); $$ = $1; $$->push_back(*$2); delete $2; }
+taglist		: positiontag									{ debug("new taglist 1"); $$ = new vector<Sguidoelement>; $$->push_back(std::move(*$1)); delete $1; }
+			| taglist positiontag							{ debug("new taglist 2"); $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
 			;
 
 //_______________________________________________
@@ -281,8 +300,8 @@ dots		:										{ debug("dots 0"); $$ = 0; }
 comment		: COMMENT								{ vdebug("comment", context->fText);  $$ = context->newComment(context->fText); }
 			;
 
-comments	: comment								{ vdebug("comments", context->fText);  $$ = new vector<Sguidoelement>; $$->push_back(*$1); delete $1; }
-			| comments comment						{ vdebug("comments", context->fText);  $$ = $1; $$->push_back(*$2); delete $2; }
+comments	: comment								{ vdebug("comments", context->fText);  $$ = new vector<Sguidoelement>; $$->push_back(std::move(*$1)); delete $1; }
+			| comments comment						{ vdebug("comments", context->fText);  $$ = $1; $$->push_back(std::move(*$2)); delete $2; }
 			;
 
 id			: IDT									{ $$ = new string(context->fText); }
@@ -293,7 +312,7 @@ pnumber		: PNUMBER								{ vdebug("PNUMBER", context->fText); $$ = atol(context
 			;
 nnumber		: NNUMBER								{ vdebug("NNUMBER", context->fText); $$ = atol(context->fText.c_str()); }
 			;
-floatn		: FLOAT									{ vdebug("FLOAT", context->fText); $$ = atof(context->fText.c_str()); }
+floatn		: FLOAT									{ vdebug("FLOAT", context->fText); $$ = str2float(context->fText.c_str()); }
 			;
 signednumber: number								{ $$ = $1; }
 			| pnumber								{ $$ = $1; } 
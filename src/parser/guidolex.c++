@@ -1,6 +1,6 @@
-#line 1 "guidolex.c++"
+#line 2 "guidolex.c++"
 
-#line 3 "guidolex.c++"
+#line 4 "guidolex.c++"
 
 #define  YY_INT_ALIGNED short int
 
@@ -830,17 +830,10 @@ using namespace std;
 
 #define YY_INPUT(buf,result,max_size)  \
    {                                   \
-	char c;                            \
-	if (!yyextra->get(c) )             \
-		result =  YY_NULL;             \
-      else {                               \
-         buf[0] = c;                       \
-         result = 1;                       \
-         if (c == '\n') yylloc->first_column=0;  \
-      }                                    \
+	result = int(yyextra->read(buf, max_size)); \
    }
 
-static int nested;
+// the comments nesting level is kept by the parser (fNested) to be reentrant
 
 #define YY_NO_UNISTD_H
 #define register		// this is to avoid deprecated register declarations
@@ -884,13 +877,13 @@ static  char* unquote (char * str) {
 	return str;
 }
 
-#line 887 "guidolex.c++"
-#line 91 "guido.l"
+#line 881 "guidolex.c++"
+#line 83 "guido.l"
   /* %x CMNTLINE */
 
 
 
-#line 893 "guidolex.c++"
+#line 887 "guidolex.c++"
 
 #define INITIAL 0
 #define COMMENTSECTION 1
@@ -1175,9 +1168,9 @@ YY_DECL
 		}
 
 	{
-#line 104 "guido.l"
+#line 96 "guido.l"
 
-#line 1180 "guidolex.c++"
+#line 1174 "guidolex.c++"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -1250,267 +1243,267 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 105 "guido.l"
+#line 97 "guido.l"
 yyextra->fText = yytext; return NUMBER;
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 106 "guido.l"
+#line 98 "guido.l"
 yyextra->fText = yytext; return PNUMBER;
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 107 "guido.l"
+#line 99 "guido.l"
 yyextra->fText = yytext; return NNUMBER;
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 109 "guido.l"
+#line 101 "guido.l"
 yyextra->fText = yytext; return FLOAT;
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 110 "guido.l"
+#line 102 "guido.l"
 yyextra->fText = yytext; return FLOAT;
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 111 "guido.l"
+#line 103 "guido.l"
 yyextra->fText = yytext; return FLOAT;
 	YY_BREAK
 case 7:
 /* rule 7 can match eol */
 YY_RULE_SETUP
-#line 113 "guido.l"
+#line 105 "guido.l"
 yyextra->fText = yytext; return COMMENT;
 	YY_BREAK
 case 8:
 /* rule 8 can match eol */
 YY_RULE_SETUP
-#line 115 "guido.l"
-nested=1; yyextra->fText = yytext; BEGIN COMMENTSECTION;
+#line 107 "guido.l"
+yyextra->fNested=1; yyextra->fText = yytext; BEGIN COMMENTSECTION;
 	YY_BREAK
 case 9:
 /* rule 9 can match eol */
 YY_RULE_SETUP
-#line 116 "guido.l"
+#line 108 "guido.l"
 yyextra->fText += yytext;
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 117 "guido.l"
+#line 109 "guido.l"
 yyextra->fText += yytext;
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 118 "guido.l"
-nested++; yyextra->fText += yytext;
+#line 110 "guido.l"
+yyextra->fNested++; yyextra->fText += yytext;
 	YY_BREAK
 case 12:
 /* rule 12 can match eol */
 YY_RULE_SETUP
-#line 119 "guido.l"
-yyextra->fText += yytext; if (--nested==0) { BEGIN INITIAL; return COMMENT; }
+#line 111 "guido.l"
+yyextra->fText += yytext; if (--yyextra->fNested==0) { BEGIN INITIAL; return COMMENT; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 121 "guido.l"
+#line 113 "guido.l"
 return STARTCHORD;
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 122 "guido.l"
+#line 114 "guido.l"
 return ENDCHORD;
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 123 "guido.l"
+#line 115 "guido.l"
 return SEP;
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 124 "guido.l"
+#line 116 "guido.l"
 return IDSEP;
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 125 "guido.l"
+#line 117 "guido.l"
 return STARTSEQ;
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 126 "guido.l"
+#line 118 "guido.l"
 return ENDSEQ;
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 127 "guido.l"
+#line 119 "guido.l"
 return STARTRANGE;
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 128 "guido.l"
+#line 120 "guido.l"
 return ENDRANGE;
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 129 "guido.l"
+#line 121 "guido.l"
 return BAR;
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 131 "guido.l"
+#line 123 "guido.l"
 return DOT;
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 132 "guido.l"
+#line 124 "guido.l"
 return DDOT;
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 133 "guido.l"
+#line 125 "guido.l"
 return TDOT;
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 134 "guido.l"
+#line 126 "guido.l"
 return SHARPT;
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 135 "guido.l"
+#line 127 "guido.l"
 return FLATT;
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 136 "guido.l"
+#line 128 "guido.l"
 return MULT;
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 137 "guido.l"
+#line 129 "guido.l"
 return DIV;
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 138 "guido.l"
+#line 130 "guido.l"
 return EQUAL;
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 139 "guido.l"
+#line 131 "guido.l"
 return ENDVAR;			/* end of variable declaration */
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 142 "guido.l"
+#line 134 "guido.l"
 return MLS;
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 143 "guido.l"
+#line 135 "guido.l"
 return SEC;
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 144 "guido.l"
+#line 136 "guido.l"
 yyextra->fText = yytext; return UNIT;
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 147 "guido.l"
+#line 139 "guido.l"
 BEGIN PARAM; return STARTPARAM;
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 148 "guido.l"
+#line 140 "guido.l"
 yyextra->fText = yytext; return IDT;
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 149 "guido.l"
+#line 141 "guido.l"
 BEGIN INITIAL; return ENDPARAM;
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 151 "guido.l"
+#line 143 "guido.l"
 yyextra->fText = yytext; return TAGNAME;
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 153 "guido.l"
+#line 145 "guido.l"
 yyextra->fText = yytext; return VARNAME;
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 156 "guido.l"
+#line 148 "guido.l"
 yyextra->fText = yytext; return SOLFEGE;
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 157 "guido.l"
+#line 149 "guido.l"
 yyextra->fText = yytext; return CHROMATIC;
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 158 "guido.l"
+#line 150 "guido.l"
 yyextra->fText = yytext; return DIATONIC;
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 159 "guido.l"
+#line 151 "guido.l"
 yyextra->fText = yytext; return EMPTYT;
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 160 "guido.l"
+#line 152 "guido.l"
 yyextra->fText = yytext; return TAB;
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 161 "guido.l"
+#line 153 "guido.l"
 return RESTT;
 	YY_BREAK
 case 45:
 /* rule 45 can match eol */
 YY_RULE_SETUP
-#line 163 "guido.l"
+#line 155 "guido.l"
 unescape(yytext); unquote(yytext); yyextra->fText = yytext; return STRING;
 	YY_BREAK
 case 46:
 /* rule 46 can match eol */
 YY_RULE_SETUP
-#line 164 "guido.l"
+#line 156 "guido.l"
 unescape(yytext); unquote(yytext); yyextra->fText = yytext; return STRING;
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 165 "guido.l"
+#line 157 "guido.l"
 unescape(yytext); unquote(yytext); yyextra->fText = yytext; return FRETTE;
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 167 "guido.l"
+#line 159 "guido.l"
 /* eat up space */
 	YY_BREAK
 case 49:
 /* rule 49 can match eol */
 YY_RULE_SETUP
-#line 169 "guido.l"
+#line 161 "guido.l"
 yylloc->first_column=1; /* ignore */
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 171 "guido.l"
+#line 163 "guido.l"
 fprintf(stderr, "extra text is : %s\n", yytext); return EXTRA;
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
-#line 173 "guido.l"
+#line 165 "guido.l"
 ECHO;
 	YY_BREAK
-#line 1513 "guidolex.c++"
+#line 1507 "guidolex.c++"
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(COMMENTSECTION):
 case YY_STATE_EOF(PARAM):
@@ -2676,7 +2669,7 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 173 "guido.l"
+#line 165 "guido.l"
 
 
 void guido::guidoparser::initScanner()
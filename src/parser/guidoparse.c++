@@ -118,15 +118,34 @@ using namespace guido;
 
 static void vadd (std::vector<guido::Sguidoelement>* v1, std::vector<guido::Sguidoelement>* v2)
 {
-	for (auto elt: *v2)
-		v1->push_back(elt);
+	for (auto& elt: *v2)
+		v1->push_back(std::move(elt));
+}
+
+// converts a FLOAT token ([+-]?[0-9]*.[0-9]+) to a float
+// unlike atof, the conversion doesn't depend on the C numeric locale
+static float str2float (const char* str)
+{
+	bool negative = (*str == '-');
+	if ((*str == '-') || (*str == '+')) str++;
+	double intpart = 0;
+	while ((*str >= '0') && (*str <= '9'))
+		intpart = intpart * 10 + (*str++ - '0');
+	double fracpart = 0, scale = 1;
+	if (*str == '.') str++;
+	while ((*str >= '0') && (*str <= '9')) {
+		fracpart = fracpart * 10 + (*str++ - '0');
+		scale *= 10;
+	}
+	double value = intpart + fracpart / scale;
+	return float(negative ? -value : value);
 }
 
 namespace guido
 {
 
 
-#line 130 "guidoparse.c++"
+#line 149 "guidoparse.c++"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -613,16 +632,16 @@ static const yytype_int8 yytranslate[] =
   /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   118,   118,   119,   122,   123,   124,   125,   128,   129,
-     130,   131,   134,   135,   136,   139,   140,   143,   144,   147,
-     148,   149,   150,   151,   152,   155,   156,   157,   160,   165,
-     166,   169,   170,   173,   176,   179,   180,   181,   184,   185,
-     186,   187,   188,   189,   190,   193,   194,   197,   198,   204,
-     207,   208,   211,   212,   213,   214,   217,   218,   219,   220,
-     223,   226,   227,   233,   234,   237,   238,   241,   242,   245,
-     246,   249,   250,   251,   252,   255,   256,   259,   260,   263,
-     264,   267,   268,   269,   270,   273,   274,   275,   281,   284,
-     285,   288,   290,   292,   294,   296,   298,   299,   300
+       0,   137,   137,   138,   141,   142,   143,   144,   147,   148,
+     149,   150,   153,   154,   155,   158,   159,   162,   163,   166,
+     167,   168,   169,   170,   171,   174,   175,   176,   179,   184,
+     185,   188,   189,   192,   195,   198,   199,   200,   203,   204,
+     205,   206,   207,   208,   209,   212,   213,   216,   217,   223,
+     226,   227,   230,   231,   232,   233,   236,   237,   238,   239,
+     242,   245,   246,   252,   253,   256,   257,   260,   261,   264,
+     265,   268,   269,   270,   271,   274,   275,   278,   279,   282,
+     283,   286,   287,   288,   289,   292,   293,   294,   300,   303,
+     304,   307,   309,   311,   313,   315,   317,   318,   319
 };
 #endif
 
@@ -1681,584 +1700,590 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
+  case 2: /* gmn: score  */
+#line 137 "guido.y"
+                                                                                                                { debug("score"); delete (yyvsp[0].elt); }
+#line 1707 "guidoparse.c++"
+    break;
+
   case 3: /* gmn: header score  */
-#line 119 "guido.y"
-                                                                                                { debug("header score"); context->setHeader((yyvsp[-1].velt)); delete (yyvsp[0].elt); }
-#line 1688 "guidoparse.c++"
+#line 138 "guido.y"
+                                                                                                { debug("header score"); context->setHeader((yyvsp[-1].velt)); delete (yyvsp[-1].velt); delete (yyvsp[0].elt); }
+#line 1713 "guidoparse.c++"
     break;
 
   case 4: /* header: comment  */
-#line 122 "guido.y"
-                                                                                                { debug("header comment"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt);}
-#line 1694 "guidoparse.c++"
+#line 141 "guido.y"
+                                                                                                { debug("header comment"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt);}
+#line 1719 "guidoparse.c++"
     break;
 
   case 5: /* header: vardecl  */
-#line 123 "guido.y"
-                                                                                                                { debug("header variable"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt);}
-#line 1700 "guidoparse.c++"
+#line 142 "guido.y"
+                                                                                                                { debug("header variable"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt);}
+#line 1725 "guidoparse.c++"
     break;
 
   case 6: /* header: header vardecl  */
-#line 124 "guido.y"
-                                                                                                        { debug("header + variable"); (yyval.velt)=(yyvsp[-1].velt); (yyvsp[-1].velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1706 "guidoparse.c++"
+#line 143 "guido.y"
+                                                                                                        { debug("header + variable"); (yyval.velt)=(yyvsp[-1].velt); (yyvsp[-1].velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1731 "guidoparse.c++"
     break;
 
   case 7: /* header: header comment  */
-#line 125 "guido.y"
-                                                                                                        { debug("header + comment"); (yyval.velt)=(yyvsp[-1].velt); (yyvsp[-1].velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1712 "guidoparse.c++"
+#line 144 "guido.y"
+                                                                                                        { debug("header + comment"); (yyval.velt)=(yyvsp[-1].velt); (yyvsp[-1].velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1737 "guidoparse.c++"
     break;
 
   case 8: /* score: STARTCHORD ENDCHORD  */
-#line 128 "guido.y"
+#line 147 "guido.y"
                                                                                         { debug("new score"); (yyval.elt) = context->newScore(); }
-#line 1718 "guidoparse.c++"
+#line 1743 "guidoparse.c++"
     break;
 
   case 9: /* score: STARTCHORD voicelist ENDCHORD  */
-#line 129 "guido.y"
-                                                                                        { debug("score voicelist"); (yyval.elt) = context->newScore(); (*(yyval.elt))->push( *(yyvsp[-1].velt)); delete (yyvsp[-1].velt); }
-#line 1724 "guidoparse.c++"
+#line 148 "guido.y"
+                                                                                        { debug("score voicelist"); (yyval.elt) = context->newScore(); (*(yyval.elt))->push(std::move(*(yyvsp[-1].velt))); delete (yyvsp[-1].velt); }
+#line 1749 "guidoparse.c++"
     break;
 
   case 10: /* score: voice  */
-#line 130 "guido.y"
-                                                                                                                { debug("score voice"); (yyval.elt) = context->newScore(); (*(yyval.elt))->push( *(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1730 "guidoparse.c++"
+#line 149 "guido.y"
+                                                                                                                { debug("score voice"); (yyval.elt) = context->newScore(); (*(yyval.elt))->push(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1755 "guidoparse.c++"
     break;
 
   case 11: /* score: score comment  */
-#line 131 "guido.y"
+#line 150 "guido.y"
                                                                                                         { debug("score comment"); (yyval.elt) = (yyvsp[-1].elt); context->addFooter(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1736 "guidoparse.c++"
+#line 1761 "guidoparse.c++"
     break;
 
   case 12: /* voicelist: voice  */
-#line 134 "guido.y"
-                                                                                                        { debug("new voicelist"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back (*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1742 "guidoparse.c++"
+#line 153 "guido.y"
+                                                                                                        { debug("new voicelist"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1767 "guidoparse.c++"
     break;
 
   case 13: /* voicelist: comments voice  */
-#line 135 "guido.y"
-                                                                                                    { debug("add voicelist"); (yyval.velt) = new vector<Sguidoelement>; if ((yyvsp[-1].velt)) { for (auto c: *(yyvsp[-1].velt)) context->beforeVoice((yyvsp[0].elt), c); }; (yyval.velt)->push_back (*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1748 "guidoparse.c++"
+#line 154 "guido.y"
+                                                                                                    { debug("add voicelist"); (yyval.velt) = new vector<Sguidoelement>; if ((yyvsp[-1].velt)) { for (auto c: *(yyvsp[-1].velt)) context->beforeVoice((yyvsp[0].elt), c); }; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1773 "guidoparse.c++"
     break;
 
   case 14: /* voicelist: voicelist sep voice  */
-#line 136 "guido.y"
-                                                                                                { debug("add voicelist"); (yyval.velt) = (yyvsp[-2].velt); (yyval.velt)->push_back (*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1754 "guidoparse.c++"
+#line 155 "guido.y"
+                                                                                                { debug("add voicelist"); (yyval.velt) = (yyvsp[-2].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1779 "guidoparse.c++"
     break;
 
   case 15: /* sep: SEP  */
-#line 139 "guido.y"
+#line 158 "guido.y"
                                                                                                                 { debug("SEP"); (yyval.velt)=0; }
-#line 1760 "guidoparse.c++"
+#line 1785 "guidoparse.c++"
     break;
 
   case 16: /* sep: SEP comments  */
-#line 140 "guido.y"
+#line 159 "guido.y"
                                                                                                         { debug("SEP comments"); (yyval.velt)=(yyvsp[0].velt); }
-#line 1766 "guidoparse.c++"
+#line 1791 "guidoparse.c++"
     break;
 
   case 17: /* voice: STARTSEQ symbols ENDSEQ  */
-#line 143 "guido.y"
-                                                                                        { debug("new voice"); (yyval.elt) = context->newVoice(); (*(yyval.elt))->push( *(yyvsp[-1].velt)); delete (yyvsp[-1].velt); }
-#line 1772 "guidoparse.c++"
+#line 162 "guido.y"
+                                                                                        { debug("new voice"); (yyval.elt) = context->newVoice(); (*(yyval.elt))->push(std::move(*(yyvsp[-1].velt))); delete (yyvsp[-1].velt); }
+#line 1797 "guidoparse.c++"
     break;
 
   case 18: /* voice: voice comment  */
-#line 144 "guido.y"
+#line 163 "guido.y"
                                                                                                         { debug("voice comment"); (yyval.elt) = (yyvsp[-1].elt); context->afterVoice((yyval.elt), *(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1778 "guidoparse.c++"
+#line 1803 "guidoparse.c++"
     break;
 
   case 19: /* symbols: %empty  */
-#line 147 "guido.y"
+#line 166 "guido.y"
                                                                                                                 { debug("new symbols"); (yyval.velt) = new vector<Sguidoelement>; }
-#line 1784 "guidoparse.c++"
+#line 1809 "guidoparse.c++"
     break;
 
   case 20: /* symbols: symbols music  */
-#line 148 "guido.y"
-                                                                                                        { debug("add music"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1790 "guidoparse.c++"
+#line 167 "guido.y"
+                                                                                                        { debug("add music"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1815 "guidoparse.c++"
     break;
 
   case 21: /* symbols: symbols tag  */
-#line 149 "guido.y"
-                                                                                                        { debug("add tag"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1796 "guidoparse.c++"
+#line 168 "guido.y"
+                                                                                                        { debug("add tag"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1821 "guidoparse.c++"
     break;
 
   case 22: /* symbols: symbols chord  */
-#line 150 "guido.y"
-                                                                                                        { debug("add chord"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1802 "guidoparse.c++"
+#line 169 "guido.y"
+                                                                                                        { debug("add chord"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1827 "guidoparse.c++"
     break;
 
   case 23: /* symbols: symbols varname  */
-#line 151 "guido.y"
-                                                                                                        { debug("add varname"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1808 "guidoparse.c++"
+#line 170 "guido.y"
+                                                                                                        { debug("add varname"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1833 "guidoparse.c++"
     break;
 
   case 24: /* symbols: symbols comment  */
-#line 152 "guido.y"
-                                                                                                        { debug("add comment"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 1814 "guidoparse.c++"
+#line 171 "guido.y"
+                                                                                                        { debug("add comment"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 1839 "guidoparse.c++"
     break;
 
   case 25: /* vardecl: varname EQUAL STRING ENDVAR  */
-#line 155 "guido.y"
+#line 174 "guido.y"
                                                                                 { vdebug("vardecl string", *(yyvsp[-3].elt)); (yyval.elt) = (yyvsp[-3].elt); context->variableDecl (*(yyvsp[-3].elt), context->fText.c_str(), guidoparser::kString);  }
-#line 1820 "guidoparse.c++"
+#line 1845 "guidoparse.c++"
     break;
 
   case 26: /* vardecl: varname EQUAL signednumber ENDVAR  */
-#line 156 "guido.y"
+#line 175 "guido.y"
                                                                                         { vdebug("vardecl int", *(yyvsp[-3].elt)); (yyval.elt) = (yyvsp[-3].elt); context->variableDecl (*(yyvsp[-3].elt), context->fText.c_str(), guidoparser::kInt);  }
-#line 1826 "guidoparse.c++"
+#line 1851 "guidoparse.c++"
     break;
 
   case 27: /* vardecl: varname EQUAL floatn ENDVAR  */
-#line 157 "guido.y"
+#line 176 "guido.y"
                                                                                         { vdebug("vardecl float", *(yyvsp[-3].elt)); (yyval.elt) = (yyvsp[-3].elt); context->variableDecl (*(yyvsp[-3].elt), context->fText.c_str(), guidoparser::kFloat); }
-#line 1832 "guidoparse.c++"
+#line 1857 "guidoparse.c++"
     break;
 
   case 28: /* varname: VARNAME  */
-#line 160 "guido.y"
+#line 179 "guido.y"
                                                                                                         { vdebug("varname", context->fText); (yyval.elt) =  context->newVariable(context->fText); }
-#line 1838 "guidoparse.c++"
+#line 1863 "guidoparse.c++"
     break;
 
   case 29: /* tag: positiontag  */
-#line 165 "guido.y"
+#line 184 "guido.y"
                                                                                                         { debug("position tag "); (yyval.elt) = (yyvsp[0].elt); }
-#line 1844 "guidoparse.c++"
+#line 1869 "guidoparse.c++"
     break;
 
   case 30: /* tag: rangetag  */
-#line 166 "guido.y"
+#line 185 "guido.y"
                                                                                                                 { debug("range tag "); (yyval.elt) = (yyvsp[0].elt); }
-#line 1850 "guidoparse.c++"
+#line 1875 "guidoparse.c++"
     break;
 
   case 31: /* positiontag: tagid  */
-#line 169 "guido.y"
+#line 188 "guido.y"
                                                                                                         { debug("new position tag "); (yyval.elt) = (yyvsp[0].elt); }
-#line 1856 "guidoparse.c++"
+#line 1881 "guidoparse.c++"
     break;
 
   case 32: /* positiontag: tagid STARTPARAM tagparams ENDPARAM  */
-#line 170 "guido.y"
-                                                                                { debug("new tag + params"); (yyval.elt) = (yyvsp[-3].elt); (*(yyvsp[-3].elt))->add (*(yyvsp[-1].vattr)); delete (yyvsp[-1].vattr); }
-#line 1862 "guidoparse.c++"
+#line 189 "guido.y"
+                                                                                { debug("new tag + params"); (yyval.elt) = (yyvsp[-3].elt); (*(yyvsp[-3].elt))->add (std::move(*(yyvsp[-1].vattr))); delete (yyvsp[-1].vattr); }
+#line 1887 "guidoparse.c++"
     break;
 
   case 33: /* rangetag: positiontag STARTRANGE symbols ENDRANGE  */
-#line 173 "guido.y"
-                                                                        { debug("new range tag "); (yyval.elt) = (yyvsp[-3].elt); (*(yyvsp[-3].elt))->push (*(yyvsp[-1].velt)); delete (yyvsp[-1].velt); }
-#line 1868 "guidoparse.c++"
+#line 192 "guido.y"
+                                                                        { debug("new range tag "); (yyval.elt) = (yyvsp[-3].elt); (*(yyvsp[-3].elt))->push(std::move(*(yyvsp[-1].velt))); delete (yyvsp[-1].velt); }
+#line 1893 "guidoparse.c++"
     break;
 
   case 34: /* tagname: TAGNAME  */
-#line 176 "guido.y"
+#line 195 "guido.y"
                                                                                                         { debug("tag name "); (yyval.str) = new string(context->fText); }
-#line 1874 "guidoparse.c++"
+#line 1899 "guidoparse.c++"
     break;
 
   case 35: /* tagid: tagname  */
-#line 179 "guido.y"
+#line 198 "guido.y"
                                                                                                         { vdebug("new tag", *(yyvsp[0].str)); (yyval.elt) = context->newTag(*(yyvsp[0].str), 0); if (!(yyval.elt)) { guidotagerror(context, (yyvsp[0].str), (yylsp[0]).first_line, (yylsp[0]).first_column); YYERROR;} delete (yyvsp[0].str); }
-#line 1880 "guidoparse.c++"
+#line 1905 "guidoparse.c++"
     break;
 
   case 36: /* tagid: tagname IDSEP NUMBER  */
-#line 180 "guido.y"
+#line 199 "guido.y"
                                                                                                 { debug("new tag::id");  (yyval.elt) = context->newTag(*(yyvsp[-2].str), (yyvsp[-1].c)); if (!(yyval.elt)) { guidotagerror(context, (yyvsp[-2].str), (yylsp[-2]).first_line, (yylsp[-2]).first_column); YYERROR;} delete (yyvsp[-2].str); }
-#line 1886 "guidoparse.c++"
+#line 1911 "guidoparse.c++"
     break;
 
   case 37: /* tagid: BAR  */
-#line 181 "guido.y"
+#line 200 "guido.y"
                                                                                                                 { debug("new bar"); (yyval.elt) = context->newTag("\\bar", 0); }
-#line 1892 "guidoparse.c++"
+#line 1917 "guidoparse.c++"
     break;
 
   case 38: /* tagarg: signednumber  */
-#line 184 "guido.y"
+#line 203 "guido.y"
                                                                                                 { debug("new signednumber arg"); (yyval.attr) = context->newAttribute((yyvsp[0].num)); }
-#line 1898 "guidoparse.c++"
+#line 1923 "guidoparse.c++"
     break;
 
   case 39: /* tagarg: floatn  */
-#line 185 "guido.y"
+#line 204 "guido.y"
                                                                                                                 { debug("new FLOAT arg"); (yyval.attr) = context->newAttribute((yyvsp[0].real)); }
-#line 1904 "guidoparse.c++"
+#line 1929 "guidoparse.c++"
     break;
 
   case 40: /* tagarg: signednumber UNIT  */
-#line 186 "guido.y"
+#line 205 "guido.y"
                                                                                                         { debug("new signednumber UNIT arg"); (yyval.attr) = context->newAttribute((yyvsp[-1].num)); (*(yyval.attr))->setUnit(context->fText); }
-#line 1910 "guidoparse.c++"
+#line 1935 "guidoparse.c++"
     break;
 
   case 41: /* tagarg: floatn UNIT  */
-#line 187 "guido.y"
+#line 206 "guido.y"
                                                                                                         { debug("new FLOAT UNIT arg"); (yyval.attr) = context->newAttribute((yyvsp[-1].real)); (*(yyval.attr))->setUnit(context->fText); }
-#line 1916 "guidoparse.c++"
+#line 1941 "guidoparse.c++"
     break;
 
   case 42: /* tagarg: STRING  */
-#line 188 "guido.y"
+#line 207 "guido.y"
                                                                                                                 { debug("new STRING arg"); (yyval.attr) = context->newAttribute(context->fText, true); }
-#line 1922 "guidoparse.c++"
+#line 1947 "guidoparse.c++"
     break;
 
   case 43: /* tagarg: id  */
-#line 189 "guido.y"
+#line 208 "guido.y"
                                                                                                                 { debug("new ID arg"); (yyval.attr) = context->newAttribute(*(yyvsp[0].str), false); delete (yyvsp[0].str); }
-#line 1928 "guidoparse.c++"
+#line 1953 "guidoparse.c++"
     break;
 
   case 44: /* tagarg: varname  */
-#line 190 "guido.y"
+#line 209 "guido.y"
                                                                                                                 { debug("new var arg"); (yyval.attr) = context->newAttribute((*(yyvsp[0].elt))->getName(), false); delete (yyvsp[0].elt); }
-#line 1934 "guidoparse.c++"
+#line 1959 "guidoparse.c++"
     break;
 
   case 45: /* tagparam: tagarg  */
-#line 193 "guido.y"
+#line 212 "guido.y"
                                                                                                         { debug("tagparam"); (yyval.attr) = (yyvsp[0].attr); }
-#line 1940 "guidoparse.c++"
+#line 1965 "guidoparse.c++"
     break;
 
   case 46: /* tagparam: id EQUAL tagarg  */
-#line 194 "guido.y"
+#line 213 "guido.y"
                                                                                                         { debug("tagparam"); (yyval.attr) = (yyvsp[0].attr); (*(yyvsp[0].attr))->setName(*(yyvsp[-2].str)); delete (yyvsp[-2].str); }
-#line 1946 "guidoparse.c++"
+#line 1971 "guidoparse.c++"
     break;
 
   case 47: /* tagparams: tagparam  */
-#line 197 "guido.y"
-                                                                                                        { (yyval.vattr) = new vector<Sguidoattribute>; (yyval.vattr)->push_back(*(yyvsp[0].attr)); delete (yyvsp[0].attr); }
-#line 1952 "guidoparse.c++"
+#line 216 "guido.y"
+                                                                                                        { (yyval.vattr) = new Sguidoattributes; (yyval.vattr)->push_back(std::move(*(yyvsp[0].attr))); delete (yyvsp[0].attr); }
+#line 1977 "guidoparse.c++"
     break;
 
   case 48: /* tagparams: tagparams SEP tagparam  */
-#line 198 "guido.y"
-                                                                                                { (yyval.vattr) = (yyvsp[-2].vattr); (yyval.vattr)->push_back(*(yyvsp[0].attr)); delete (yyvsp[0].attr); }
-#line 1958 "guidoparse.c++"
+#line 217 "guido.y"
+                                                                                                { (yyval.vattr) = (yyvsp[-2].vattr); (yyval.vattr)->push_back(std::move(*(yyvsp[0].attr))); delete (yyvsp[0].attr); }
+#line 1983 "guidoparse.c++"
     break;
 
   case 49: /* chord: STARTCHORD chordsymbols ENDCHORD  */
-#line 204 "guido.y"
-                                                                                { debug("new chord"); (yyval.elt) = context->newChord(); (*(yyval.elt))->push(*(yyvsp[-1].velt)); delete (yyvsp[-1].velt); }
-#line 1964 "guidoparse.c++"
+#line 223 "guido.y"
+                                                                                { debug("new chord"); (yyval.elt) = context->newChord(); (*(yyval.elt))->push(std::move(*(yyvsp[-1].velt))); delete (yyvsp[-1].velt); }
+#line 1989 "guidoparse.c++"
     break;
 
   case 50: /* chordsymbols: tagchordsymbol  */
-#line 207 "guido.y"
+#line 226 "guido.y"
                                                                                         { (yyval.velt) = new vector<Sguidoelement>; vadd((yyval.velt), (yyvsp[0].velt)); delete (yyvsp[0].velt); }
-#line 1970 "guidoparse.c++"
+#line 1995 "guidoparse.c++"
     break;
 
   case 51: /* chordsymbols: chordsymbols SEP tagchordsymbol  */
-#line 208 "guido.y"
+#line 227 "guido.y"
                                                                                         { (yyval.velt) = (yyvsp[-2].velt); vadd((yyval.velt), (yyvsp[0].velt)); delete (yyvsp[0].velt); }
-#line 1976 "guidoparse.c++"
+#line 2001 "guidoparse.c++"
     break;
 
   case 52: /* tagchordsymbol: chordsymbol  */
-#line 211 "guido.y"
+#line 230 "guido.y"
                                                                                                 { (yyval.velt) = (yyvsp[0].velt);}
-#line 1982 "guidoparse.c++"
+#line 2007 "guidoparse.c++"
     break;
 
   case 53: /* tagchordsymbol: taglist chordsymbol  */
-#line 212 "guido.y"
+#line 231 "guido.y"
                                                                                                 { (yyval.velt) = (yyvsp[-1].velt); vadd((yyval.velt), (yyvsp[0].velt)); delete (yyvsp[0].velt); }
-#line 1988 "guidoparse.c++"
+#line 2013 "guidoparse.c++"
     break;
 
   case 54: /* tagchordsymbol: chordsymbol taglist  */
-#line 213 "guido.y"
+#line 232 "guido.y"
                                                                                                 { (yyval.velt) = (yyvsp[-1].velt); vadd((yyval.velt), (yyvsp[0].velt)); delete (yyvsp[0].velt); }
-#line 1994 "guidoparse.c++"
+#line 2019 "guidoparse.c++"
     break;
 
   case 55: /* tagchordsymbol: taglist chordsymbol taglist  */
-#line 214 "guido.y"
+#line 233 "guido.y"
                                                                                         { (yyval.velt) = (yyvsp[-2].velt); vadd((yyval.velt), (yyvsp[-1].velt)); delete (yyvsp[-1].velt); vadd((yyval.velt), (yyvsp[0].velt)); delete (yyvsp[0].velt); }
-#line 2000 "guidoparse.c++"
+#line 2025 "guidoparse.c++"
     break;
 
   case 56: /* chordsymbol: music  */
-#line 217 "guido.y"
-                                                                                                        { (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 2006 "guidoparse.c++"
+#line 236 "guido.y"
+                                                                                                        { (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 2031 "guidoparse.c++"
     break;
 
   case 57: /* chordsymbol: rangechordtag  */
-#line 218 "guido.y"
-                                                                                                        { (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 2012 "guidoparse.c++"
+#line 237 "guido.y"
+                                                                                                        { (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 2037 "guidoparse.c++"
     break;
 
   case 58: /* chordsymbol: chordsymbol comment  */
-#line 219 "guido.y"
-                                                                                                { (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 2018 "guidoparse.c++"
+#line 238 "guido.y"
+                                                                                                { (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 2043 "guidoparse.c++"
     break;
 
   case 59: /* chordsymbol: comment chordsymbol  */
-#line 220 "guido.y"
-                                                                                                { debug("comment chord"); (yyval.velt) = (yyvsp[0].velt); (yyval.velt)->push_back(*(yyvsp[-1].elt)); delete (yyvsp[-1].elt); }
-#line 2024 "guidoparse.c++"
+#line 239 "guido.y"
+                                                                                                { debug("comment chord"); (yyval.velt) = (yyvsp[0].velt); (yyval.velt)->push_back(std::move(*(yyvsp[-1].elt))); delete (yyvsp[-1].elt); }
+#line 2049 "guidoparse.c++"
     break;
 
   case 60: /* rangechordtag: positiontag STARTRANGE tagchordsymbol ENDRANGE  */
-#line 223 "guido.y"
-                                                                { debug("range chord tag"); (yyval.elt) = (yyvsp[-3].elt); (*(yyval.elt))->push(*(yyvsp[-1].velt)); delete (yyvsp[-1].velt); }
-#line 2030 "guidoparse.c++"
+#line 242 "guido.y"
+                                                                { debug("range chord tag"); (yyval.elt) = (yyvsp[-3].elt); (*(yyval.elt))->push(std::move(*(yyvsp[-1].velt))); delete (yyvsp[-1].velt); }
+#line 2055 "guidoparse.c++"
     break;
 
   case 61: /* taglist: positiontag  */
-#line 226 "guido.y"
-                                                                                                { debug("new taglist 1"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 2036 "guidoparse.c++"
+#line 245 "guido.y"
+                                                                                                { debug("new taglist 1"); (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 2061 "guidoparse.c++"
     break;
 
   case 62: /* taglist: taglist positiontag  */
-#line 227 "guido.y"
-                                                                                                { debug("new taglist 2"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 2042 "guidoparse.c++"
+#line 246 "guido.y"
+                                                                                                { debug("new taglist 2"); (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 2067 "guidoparse.c++"
     break;
 
   case 63: /* music: note  */
-#line 233 "guido.y"
+#line 252 "guido.y"
                                                                                                         { (yyval.elt) = (yyvsp[0].elt); }
-#line 2048 "guidoparse.c++"
+#line 2073 "guidoparse.c++"
     break;
 
   case 64: /* music: rest  */
-#line 234 "guido.y"
+#line 253 "guido.y"
                                                                                                                 { (yyval.elt) = (yyvsp[0].elt); }
-#line 2054 "guidoparse.c++"
+#line 2079 "guidoparse.c++"
     break;
 
   case 65: /* rest: RESTT duration dots  */
-#line 237 "guido.y"
+#line 256 "guido.y"
                                                                                                 { debug("new rest 1"); (yyval.elt) = context->newRest((yyvsp[-1].r), (yyvsp[0].num)); delete (yyvsp[-1].r); }
-#line 2060 "guidoparse.c++"
+#line 2085 "guidoparse.c++"
     break;
 
   case 66: /* rest: RESTT STARTPARAM NUMBER ENDPARAM duration dots  */
-#line 238 "guido.y"
+#line 257 "guido.y"
                                                                                 { debug("new rest 2"); (yyval.elt) = context->newRest((yyvsp[-1].r), (yyvsp[0].num)); delete (yyvsp[-1].r); }
-#line 2066 "guidoparse.c++"
+#line 2091 "guidoparse.c++"
     break;
 
   case 67: /* note: noteid octave duration dots  */
-#line 241 "guido.y"
+#line 260 "guido.y"
                                                                         { debug("new note v1"); (yyval.elt) = context->newNote(*(yyvsp[-3].str), 0, (yyvsp[-2].num), (yyvsp[-1].r), (yyvsp[0].num)); delete (yyvsp[-3].str); delete (yyvsp[-1].r); }
-#line 2072 "guidoparse.c++"
+#line 2097 "guidoparse.c++"
     break;
 
   case 68: /* note: noteid accidentals octave duration dots  */
-#line 242 "guido.y"
+#line 261 "guido.y"
                                                                         { debug("new note v2"); (yyval.elt) = context->newNote(*(yyvsp[-4].str), (yyvsp[-3].num), (yyvsp[-2].num), (yyvsp[-1].r), (yyvsp[0].num)); delete (yyvsp[-4].str); delete (yyvsp[-1].r); }
-#line 2078 "guidoparse.c++"
+#line 2103 "guidoparse.c++"
     break;
 
   case 69: /* noteid: notename  */
-#line 245 "guido.y"
+#line 264 "guido.y"
                                                                                                 { vdebug("notename", *(yyvsp[0].str)); (yyval.str) = (yyvsp[0].str); }
-#line 2084 "guidoparse.c++"
+#line 2109 "guidoparse.c++"
     break;
 
   case 70: /* noteid: notename STARTPARAM NUMBER ENDPARAM  */
-#line 246 "guido.y"
+#line 265 "guido.y"
                                                                         { (yyval.str) = (yyvsp[-3].str); }
-#line 2090 "guidoparse.c++"
+#line 2115 "guidoparse.c++"
     break;
 
   case 71: /* notename: DIATONIC  */
-#line 249 "guido.y"
+#line 268 "guido.y"
                                                                                         { debug("new diatonic note"); (yyval.str) = new string(context->fText); }
-#line 2096 "guidoparse.c++"
+#line 2121 "guidoparse.c++"
     break;
 
   case 72: /* notename: CHROMATIC  */
-#line 250 "guido.y"
+#line 269 "guido.y"
                                                                                                 { debug("new chromatic note"); (yyval.str) = new string(context->fText); }
-#line 2102 "guidoparse.c++"
+#line 2127 "guidoparse.c++"
     break;
 
   case 73: /* notename: SOLFEGE  */
-#line 251 "guido.y"
+#line 270 "guido.y"
                                                                                                 { debug("new solfege note"); (yyval.str) = new string(context->fText); }
-#line 2108 "guidoparse.c++"
+#line 2133 "guidoparse.c++"
     break;
 
   case 74: /* notename: EMPTYT  */
-#line 252 "guido.y"
+#line 271 "guido.y"
                                                                                                 { debug("new empty note"); (yyval.str) = new string(context->fText); }
-#line 2114 "guidoparse.c++"
+#line 2139 "guidoparse.c++"
     break;
 
   case 75: /* accidentals: accidental  */
-#line 255 "guido.y"
+#line 274 "guido.y"
                                                                                 { debug("accidental"); (yyval.num) = (yyvsp[0].num); }
-#line 2120 "guidoparse.c++"
+#line 2145 "guidoparse.c++"
     break;
 
   case 76: /* accidentals: accidentals accidental  */
-#line 256 "guido.y"
+#line 275 "guido.y"
                                                                                 { debug("accidentals"); (yyval.num) = (yyvsp[-1].num) + (yyvsp[0].num); }
-#line 2126 "guidoparse.c++"
+#line 2151 "guidoparse.c++"
     break;
 
   case 77: /* accidental: SHARPT  */
-#line 259 "guido.y"
+#line 278 "guido.y"
                                                                                         { debug("sharp"); (yyval.num) = 1; }
-#line 2132 "guidoparse.c++"
+#line 2157 "guidoparse.c++"
     break;
 
   case 78: /* accidental: FLATT  */
-#line 260 "guido.y"
+#line 279 "guido.y"
                                                                                                 { debug("flat"); (yyval.num) = -1; }
-#line 2138 "guidoparse.c++"
+#line 2163 "guidoparse.c++"
     break;
 
   case 79: /* octave: %empty  */
-#line 263 "guido.y"
+#line 282 "guido.y"
                                                                                                 { debug("no octave"); (yyval.num) = -1000; }
-#line 2144 "guidoparse.c++"
+#line 2169 "guidoparse.c++"
     break;
 
   case 80: /* octave: signednumber  */
-#line 264 "guido.y"
+#line 283 "guido.y"
                                                                                         { debug("octave"); (yyval.num) = (yyvsp[0].num); }
-#line 2150 "guidoparse.c++"
+#line 2175 "guidoparse.c++"
     break;
 
   case 81: /* duration: %empty  */
-#line 267 "guido.y"
+#line 286 "guido.y"
                                                                                                 { debug("implicit duration"); (yyval.r) = new rational(-1, 1); }
-#line 2156 "guidoparse.c++"
+#line 2181 "guidoparse.c++"
     break;
 
   case 82: /* duration: MULT number DIV number  */
-#line 268 "guido.y"
+#line 287 "guido.y"
                                                                                 { debug("duration ./."); (yyval.r) = new rational((yyvsp[-2].num), (yyvsp[0].num)); }
-#line 2162 "guidoparse.c++"
+#line 2187 "guidoparse.c++"
     break;
 
   case 83: /* duration: MULT number  */
-#line 269 "guido.y"
+#line 288 "guido.y"
                                                                                         { debug("duration *"); (yyval.r) = new rational((yyvsp[0].num), 1); }
-#line 2168 "guidoparse.c++"
+#line 2193 "guidoparse.c++"
     break;
 
   case 84: /* duration: DIV number  */
-#line 270 "guido.y"
+#line 289 "guido.y"
                                                                                         { debug("duration /"); (yyval.r) = new rational(1, (yyvsp[0].num)); }
-#line 2174 "guidoparse.c++"
+#line 2199 "guidoparse.c++"
     break;
 
   case 85: /* dots: %empty  */
-#line 273 "guido.y"
+#line 292 "guido.y"
                                                                                                 { debug("dots 0"); (yyval.num) = 0; }
-#line 2180 "guidoparse.c++"
+#line 2205 "guidoparse.c++"
     break;
 
   case 86: /* dots: DOT  */
-#line 274 "guido.y"
+#line 293 "guido.y"
                                                                                                 { debug("dots 1"); (yyval.num) = 1; }
-#line 2186 "guidoparse.c++"
+#line 2211 "guidoparse.c++"
     break;
 
   case 87: /* dots: DDOT  */
-#line 275 "guido.y"
+#line 294 "guido.y"
                                                                                                 { debug("dots 2"); (yyval.num) = 2; }
-#line 2192 "guidoparse.c++"
+#line 2217 "guidoparse.c++"
     break;
 
   case 88: /* comment: COMMENT  */
-#line 281 "guido.y"
+#line 300 "guido.y"
                                                                                         { vdebug("comment", context->fText);  (yyval.elt) = context->newComment(context->fText); }
-#line 2198 "guidoparse.c++"
+#line 2223 "guidoparse.c++"
     break;
 
   case 89: /* comments: comment  */
-#line 284 "guido.y"
-                                                                                        { vdebug("comments", context->fText);  (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 2204 "guidoparse.c++"
+#line 303 "guido.y"
+                                                                                        { vdebug("comments", context->fText);  (yyval.velt) = new vector<Sguidoelement>; (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 2229 "guidoparse.c++"
     break;
 
   case 90: /* comments: comments comment  */
-#line 285 "guido.y"
-                                                                                        { vdebug("comments", context->fText);  (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(*(yyvsp[0].elt)); delete (yyvsp[0].elt); }
-#line 2210 "guidoparse.c++"
+#line 304 "guido.y"
+                                                                                        { vdebug("comments", context->fText);  (yyval.velt) = (yyvsp[-1].velt); (yyval.velt)->push_back(std::move(*(yyvsp[0].elt))); delete (yyvsp[0].elt); }
+#line 2235 "guidoparse.c++"
     break;
 
   case 91: /* id: IDT  */
-#line 288 "guido.y"
+#line 307 "guido.y"
                                                                                                 { (yyval.str) = new string(context->fText); }
-#line 2216 "guidoparse.c++"
+#line 2241 "guidoparse.c++"
     break;
 
   case 92: /* number: NUMBER  */
-#line 290 "guido.y"
+#line 309 "guido.y"
                                                                                         { vdebug("NUMBER", context->fText); (yyval.num) = atol(context->fText.c_str()); }
-#line 2222 "guidoparse.c++"
+#line 2247 "guidoparse.c++"
     break;
 
   case 93: /* pnumber: PNUMBER  */
-#line 292 "guido.y"
+#line 311 "guido.y"
                                                                                         { vdebug("PNUMBER", context->fText); (yyval.num) = atol(context->fText.c_str()); }
-#line 2228 "guidoparse.c++"
+#line 2253 "guidoparse.c++"
     break;
 
   case 94: /* nnumber: NNUMBER  */
-#line 294 "guido.y"
+#line 313 "guido.y"
                                                                                         { vdebug("NNUMBER", context->fText); (yyval.num) = atol(context->fText.c_str()); }
-#line 2234 "guidoparse.c++"
+#line 2259 "guidoparse.c++"
     break;
 
   case 95: /* floatn: FLOAT  */
-#line 296 "guido.y"
-                                                                                        { vdebug("FLOAT", context->fText); (yyval.real) = atof(context->fText.c_str()); }
-#line 2240 "guidoparse.c++"
+#line 315 "guido.y"
+                                                                                        { vdebug("FLOAT", context->fText); (yyval.real) = str2float(context->fText.c_str()); }
+#line 2265 "guidoparse.c++"
     break;
 
   case 96: /* signednumber: number  */
-#line 298 "guido.y"
+#line 317 "guido.y"
                                                                                 { (yyval.num) = (yyvsp[0].num); }
-#line 2246 "guidoparse.c++"
+#line 2271 "guidoparse.c++"
     break;
 
   case 97: /* signednumber: pnumber  */
-#line 299 "guido.y"
+#line 318 "guido.y"
                                                                                                 { (yyval.num) = (yyvsp[0].num); }
-#line 2252 "guidoparse.c++"
+#line 2277 "guidoparse.c++"
     break;
 
   case 98: /* signednumber: nnumber  */
-#line 300 "guido.y"
+#line 319 "guido.y"
                                                                                                 { (yyval.num) = (yyvsp[0].num); }
-#line 2258 "guidoparse.c++"
+#line 2283 "guidoparse.c++"
     break;
 
 
-#line 2262 "guidoparse.c++"
+#line 2287 "guidoparse.c++"
 
       default: break;
     }
@@ -2488,7 +2513,7 @@ yyreturn:
   return yyresult;
 }
 
-#line 302 "guido.y"
+#line 321 "guido.y"
 
 
 } // namespace
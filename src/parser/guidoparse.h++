@@ -102,7 +102,7 @@ extern int guidoardebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 86 "guido.y"
+#line 105 "guido.y"
          
 	long int		num;
 	float			real;
@@ -112,7 +112,7 @@ union YYSTYPE
 	guido::Sguidoelement *		elt;
 	guido::Sguidoattribute*		attr;
 	std::vector<guido::Sguidoelement>*	 velt;
-	std::vector<guido::Sguidoattribute>* vattr;
+	guido::Sguidoattributes* vattr;
 	guido::rational *		r;
 
 #line 119 "guidoparse.h++"
@@ -25,10 +25,19 @@
 # pragma warning (disable : 4786)
 #endif
 
-#include <locale.h>
+#include <string.h>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
+#if !defined(WIN32) && !defined(EMCC)
+# define USE_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
 #include "guidoparser.h"
 #include "guidoelement.h"
 #include "guidocomment.h"
@@ -53,14 +62,12 @@ namespace guido
 //--------------------------------------------------------------------------
 guidoparser::guidoparser()
 {
-	setlocale(LC_NUMERIC, "C");
     initScanner();
 }
 
 //--------------------------------------------------------------------------
 guidoparser::~guidoparser() 
 {
-	setlocale(LC_NUMERIC, 0);
 	destroyScanner();
 }
 
@@ -68,9 +75,24 @@ guidoparser::~guidoparser()
 // return the next char in stream
 bool guidoparser::get(char& c)
 {
-	fStream->get(c);
-	return !fStream->eof();
+	return read (&c, 1) == 1;
+}
+
+//--------------------------------------------------------------------------
+// read a block of chars from the input stream or buffer
+// the scanner fills its buffer using this method
+size_t guidoparser::read(char* buffer, size_t max)
+{
+	if (fStream) {
+		fStream->read (buffer, max);
+		return size_t(fStream->gcount());
+	}
+	size_t n = std::min(max, size_t(fBufferEnd - fBuffer));
+	memcpy (buffer, fBuffer, n);
+	fBuffer += n;
+	return n;
 }
+
 //--------------------------------------------------------------------------
 void guidoparser::setStream(std::istream *stream)
 {
@@ -82,7 +104,7 @@ void guidoparser::setStream(std::istream *stream)
 Sguidoelement* guidoparser::newComment(const string& comment)
 {
 	Sguidoelement* cptr = new Sguidoelement;
-	Sguidocomment c = guidocomment::create();
+	Sguidocomment c = guidocomment::create(fArena);
 	c->setName(comment);
 	*cptr = c;
 	return cptr;
@@ -121,7 +143,7 @@ Sguidoelement* guidoparser::newScore()
 {
 //	cout << "create new score" << endl;
 	Sguidoelement* score = new Sguidoelement;
-	fMusic = ARFactory::instance().createMusic();
+	fMusic = ARFactory::instance().createMusic(fArena);
 	*score = fMusic;
 	return score;
 }
@@ -130,7 +152,7 @@ Sguidoelement* guidoparser::newVoice()
 {
 //	cout << "create new voice" << endl;
 	Sguidoelement* voice = new Sguidoelement;
-	*voice = ARFactory::instance().createVoice();
+	*voice = ARFactory::instance().createVoice(fArena);
 	return voice;
 }
 
@@ -138,7 +160,7 @@ Sguidoelement* guidoparser::newChord()
 {
 //	cout << "create new chord" << endl;
 	Sguidoelement* chord = new Sguidoelement;
-	*chord = ARFactory::instance().createChord();
+	*chord = ARFactory::instance().createChord(fArena);
 	return chord;
 }
 
@@ -146,9 +168,10 @@ Sguidoelement* guidoparser::newRest(const rational * r, long dots)
 {
 //	cout << "create new rest " << string(*r) << " dots: " << dots << endl;
 	Sguidoelement* notep = new Sguidoelement;
-	SARNote note = ARFactory::instance().createNote("_");
+	SARNote note = ARFactory::instance().createNote("_", fArena);
 	if (r->getNumerator() >= 0)		(*note) = *r;
 	if (dots > 0)					note->SetDots (int(dots));
+	addDuration (r, dots);
 	*notep = note;
 	return notep;
 }
@@ -157,19 +180,50 @@ Sguidoelement* guidoparser::newNote(const std::string& name, long accidentals, l
 {
 //	cout << "create new note " << name << " acc: " << accidentals << " oct: " <<  octave << " - " << string(*r) << " dots: " << dots << endl;
 	Sguidoelement* notep = new Sguidoelement;
-	SARNote note = ARFactory::instance().createNote(name);
+	SARNote note = ARFactory::instance().createNote(name, fArena);
 	if (accidentals)				note->SetAccidental (int(accidentals));
 	if (octave != -1000)			note->SetOctave (int(octave));
 	if (r->getNumerator() >= 0)		(*note) = *r;
 	if (dots > 0)					note->SetDots (int(dots));
+	addDuration (r, dots);
 	*notep = note;
 	return notep;
 }
 
+//______________________________________________________________________________
+// the tick base is the lcm of the durations denominators, multiplied by 2
+// for each dot: the dotted durations are then integer numbers of ticks too
+void guidoparser::addDuration (const rational * r, long dots)
+{
+	if (dots > fMaxDots) fMaxDots = dots;
+	long den = r->getDenominator();
+	if ((r->getNumerator() < 0) || !fTickLcm || (den <= 0) || !(fTickLcm % den)) return;
+
+	long a = fTickLcm, b = den;
+	while (b) { long t = a % b; a = b; b = t; }
+	long factor = fTickLcm / a;			// lcm = fTickLcm / gcd * den
+	fTickLcm = (factor <= ARMusic::kMaxTickBase / den) ? factor * den : 0;
+}
+
+void guidoparser::startTickBase ()
+{
+	fTickLcm = ARNote::getDefaultDuration().getDenominator();
+	fMaxDots = 0;
+}
+
+void guidoparser::setTickBase ()
+{
+	if (!fMusic) return;
+	long base = fTickLcm;
+	for (long i = 0; base && (i < fMaxDots); i++)
+		base = (base <= ARMusic::kMaxTickBase / 2) ? base * 2 : 0;
+	fMusic->setTickBase (base);
+}
+
 Sguidoelement* guidoparser::newTag(const std::string& name, long id)
 {
 //	cout << "create new tag " << name << " id: " << id << endl;
-	Sguidoelement tag = ARFactory::instance().createTag(name.substr(1), id);
+	Sguidoelement tag = ARFactory::instance().createTag(name.substr(1), id, fArena);
 	if (!tag) return 0;
 	Sguidoelement* tagp = new Sguidoelement;
 	*tagp = tag;
@@ -178,7 +232,7 @@ Sguidoelement* guidoparser::newTag(const std::string& name, long id)
 
 Sguidoelement* guidoparser::newVariable(const std::string& name)
 {
-	Sguidoelement var = ARFactory::instance().createVariable(name);
+	Sguidoelement var = ARFactory::instance().createVariable(name, fArena);
 	if (!var) return 0;
 	Sguidoelement* varp = new Sguidoelement;
 	*varp = var;
@@ -189,7 +243,7 @@ Sguidoattribute* guidoparser::newAttribute(long value)
 {
 //	cout << "create new attribute with value " << value << endl;
 	Sguidoattribute* attr = new Sguidoattribute;
-	*attr = guidoattribute::create();
+	*attr = guidoattribute::create(fArena);
 	(*attr)->setValue(value);
 	return attr;
 }
@@ -198,7 +252,7 @@ Sguidoattribute* guidoparser::newAttribute(float value)
 {
 //	cout << "create new attribute with value " << value << endl;
 	Sguidoattribute* attr = new Sguidoattribute;
-	*attr = guidoattribute::create();
+	*attr = guidoattribute::create(fArena);
 	(*attr)->setValue(value);
 	return attr;
 }
@@ -207,7 +261,7 @@ Sguidoattribute* guidoparser::newAttribute(const std::string& value, bool quote)
 {
 //	cout << "create new attribute with value " << value << " - quote: " << quote << endl;
 	Sguidoattribute* attr = new Sguidoattribute;
-	*attr = guidoattribute::create();
+	*attr = guidoattribute::create(fArena);
 	(*attr)->setValue(value, quote);
 	return attr;
 }
@@ -227,36 +281,70 @@ void guidoparser::parse  (std::istream * stream)
 	fStream = stream;
     destroyScanner();
     initScanner();
-	setlocale(LC_NUMERIC, "C");
+	startTickBase ();
 	_yyparse ();
-	setlocale(LC_NUMERIC, 0);
+	setTickBase ();
 	fStream = nullptr;
 }
 
+//______________________________________________________________________________
+void guidoparser::parse  (const char * buffer, size_t size)
+{
+	fBuffer = buffer;
+	fBufferEnd = buffer + size;
+    destroyScanner();
+    initScanner();
+	startTickBase ();
+	_yyparse ();
+	setTickBase ();
+	fBuffer = fBufferEnd = nullptr;
+}
+
 //______________________________________________________________________________
 //SARMusic guidoparser::parseFile(FILE* fd)
 //{
-//	setlocale(LC_NUMERIC, "C");
 //	readfile (fd, this);
-//	setlocale(LC_NUMERIC, 0);
 //	return fMusic;
 //}
 
 //______________________________________________________________________________
+// the file is mapped in memory when possible and parsed as a buffer
 SARMusic guidoparser::parseFile(const char* file)
 {
-	ifstream * fileStream = new ifstream (file, std::ifstream::in);
-	parse (fileStream);
-	fileStream->close();
-	delete fileStream;
+#ifdef USE_MMAP
+	int fd = open (file, O_RDONLY);
+	if (fd >= 0) {
+		struct stat st;
+		void * map = MAP_FAILED;
+		size_t size = 0;
+		if ((fstat (fd, &st) == 0) && (st.st_size > 0)) {
+			size = size_t(st.st_size);
+			map = mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		close (fd);
+		if (map != MAP_FAILED) {
+			parse ((const char*)map, size);
+			munmap (map, size);
+			return fMusic;
+		}
+	}
+#endif
+	ifstream fileStream (file, std::ifstream::in);
+	parse (&fileStream);
 	return fMusic;
 }
 
 //______________________________________________________________________________
 SARMusic guidoparser::parseString(const char* str)
 {
-	stringstream* ss = new stringstream(str);
-	parse (ss);
+	parse (str, strlen(str));
+	return fMusic;
+}
+
+//______________________________________________________________________________
+SARMusic guidoparser::parseBuffer(const char* buffer, size_t size)
+{
+	parse (buffer, size);
 	return fMusic;
 }
 
@@ -29,26 +29,47 @@
 #include <sstream>
 #include <map>
 #include <stack>
-#include <locale.h>
 
 #include "arexport.h"
 #include "gmnreader.h"
 #include "ARTypes.h"
 #include "guidorational.h"
 #include "AROthers.h"
+#include "garena.h"
 
 namespace guido 
 {
 
+/*!
+\brief	The gmn parser.
+
+	The parser doesn't use any global state (the scanner is reentrant and numbers
+	are converted independently of the C locale): independent guidoparser instances
+	can be used concurrently from different threads. A given instance must not be
+	shared between threads.
+\n	When an arena is set (see setArena), the parsed score is allocated in the arena.
+	The arena memory is released when the arena and the score are both gone.
+\n	The parser computes the score tick base (see ARMusic::getTickBase) from the
+	durations and dots of the notes.
+*/
 class gar_export guidoparser : public gmnreader
 { 
 	SARMusic 		fMusic;
+	Sgarena			fArena;                // optional arena for the parsed scores
 	std::istream * 	fStream = nullptr;     // input stream
+	const char *	fBuffer = nullptr;     // input buffer, when parsing from memory
+	const char *	fBufferEnd = nullptr;  // end of the input buffer
+	long			fTickLcm = 0;          // the lcm of the durations denominators, 0 when too large
+	long			fMaxDots = 0;          // the max dots count
     
 	void initScanner();
 	void destroyScanner();
+	void startTickBase ();
+	void addDuration (const rational * r, long dots);
+	void setTickBase ();
 	int 	_yyparse();
 	void 	parse  (std::istream * stream);
+	void 	parse  (const char * buffer, size_t size);
 	
 	public:
 				 guidoparser();
@@ -57,14 +78,28 @@ class gar_export guidoparser : public gmnreader
 		void *	fScanner;   // the flex scanner
 		errInfo fError;
 		std::string fText;
+		int		fNested = 0;	// the comments nesting level
 		
 		virtual const errInfo& getError() const  { return fError; }
 		virtual bool get(char& c);  // return the next char in stream
+		virtual size_t read(char* buffer, size_t max);  // read at most max chars from the input, returns the count of chars read
         virtual void setStream(std::istream *stream);
 
+		/*! \brief sets the arena used to allocate the next parsed scores
+			\param arena an arena, or null to allocate the scores on the heap
+		*/
+		void			setArena (const Sgarena& arena)	{ fArena = arena; }
+		const Sgarena&	getArena () const				{ return fArena; }
+
 //		SARMusic parseFile  (FILE* fd);
 		SARMusic parseFile  (const char* file);
 		SARMusic parseString(const char* string);
+		/*! \brief parses a memory buffer
+			The buffer is not copied nor modified and doesn't need to be null terminated.
+			\param buffer the gmn code
+			\param size the buffer size
+		*/
+		SARMusic parseBuffer(const char* buffer, size_t size);
 
 		virtual void	 	   setHeader(std::vector<Sguidoelement>*);
 		virtual void	 	   addFooter(Sguidoelement);
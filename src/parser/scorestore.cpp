@@ -0,0 +1,303 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifdef WIN32
+# pragma warning (disable : 4786)
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if !defined(WIN32) && !defined(EMCC)
+# define USE_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include "scorestore.h"
+#include "binaryreader.h"
+#include "binaryvisitor.h"
+#include "counteventsvisitor.h"
+#include "durationvisitor.h"
+#include "garbinary.h"
+
+using namespace std;
+
+namespace guido
+{
+
+using namespace garbinary;
+
+//______________________________________________________________________________
+//
+//   ARStoredVoice
+//______________________________________________________________________________
+SARStoredVoice ARStoredVoice::create(const Sscorestore& store, size_t index, garena* arena)
+    { ARStoredVoice* o = new (arena) ARStoredVoice(store, index); assert(o!=0); o->setArena(arena); return o; }
+
+const rational& ARStoredVoice::duration () const	{ return fStore->voice(fIndex).fDuration; }
+long ARStoredVoice::events () const					{ return fStore->voice(fIndex).fEvents; }
+
+//______________________________________________________________________________
+bool ARStoredVoice::load ()
+{
+	if (fLoaded) return !fFailed;
+	fLoaded = true;
+	Sguidoelement content = fStore->voiceContent (fIndex);
+	if (content) ARVoice::push (std::move(content->elements()));
+	else fFailed = true;			// the voice is left empty
+	return !fFailed;
+}
+
+void ARStoredVoice::acceptIn(basevisitor& v)
+{
+	load();
+	ARVoice::acceptIn (v);
+}
+
+//______________________________________________________________________________
+//
+//   scorestore
+//______________________________________________________________________________
+const char scorestore::kStoreMagic[] = "GARS";
+
+Sscorestore scorestore::create()
+    { scorestore* o = new scorestore; assert(o!=0); return o; }
+
+scorestore::~scorestore()	{ close(); }
+
+//______________________________________________________________________________
+void scorestore::close ()
+{
+#ifdef USE_MMAP
+	if (fMap) munmap (fMap, fMapSize);
+#endif
+	fMap = nullptr;
+	fMapSize = 0;
+	fBuffer.clear();
+	fData = fDataEnd = nullptr;
+	fVoices.clear();
+	fMusicOffset = fMusicSize = 0;
+	fDuration = rational(0,1);
+}
+
+//______________________________________________________________________________
+// the file is mapped in memory when possible, otherwise it is read in a buffer
+bool scorestore::open (const char* file)
+{
+	if (fData) {
+		fError = "score store already opened";
+		return false;
+	}
+	fError.clear();
+#ifdef USE_MMAP
+	int fd = ::open (file, O_RDONLY);
+	if (fd >= 0) {
+		struct stat st;
+		void * map = MAP_FAILED;
+		size_t size = 0;
+		if ((fstat (fd, &st) == 0) && (st.st_size > 0)) {
+			size = size_t(st.st_size);
+			map = mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		::close (fd);
+		if (map != MAP_FAILED) {
+			fMap = map;
+			fMapSize = size;
+			if (read ((const char*)map, size)) return true;
+			close();
+			return false;
+		}
+	}
+#endif
+	ifstream stream (file, ios::in | ios::binary);
+	if (!stream) {
+		fError = string("can't open ") + file;
+		return false;
+	}
+	ostringstream content;
+	content << stream.rdbuf();
+	fBuffer = content.str();
+	if (read (fBuffer.data(), fBuffer.size())) return true;
+	close();
+	return false;
+}
+
+//______________________________________________________________________________
+// reads the store header
+bool scorestore::read (const char* data, size_t size)
+{
+	if ((size < kMagicSize) || memcmp (data, kStoreMagic, kMagicSize)) {
+		fError = "not a score store";
+		return false;
+	}
+	const unsigned char* ptr = (const unsigned char*)data + kMagicSize;
+	const unsigned char* end = (const unsigned char*)data + size;
+	unsigned long version, offset, length, count;
+	long num, denum;
+	if (!getnum (ptr, end, version) || (version != kVersion)) {
+		fError = "unsupported score store version";
+		return false;
+	}
+	if (!getsigned (ptr, end, num) || !getsigned (ptr, end, denum)
+		|| !getnum (ptr, end, offset) || !getnum (ptr, end, length)
+		|| !getnum (ptr, end, count) || (count > size_t(end - ptr))) {
+		fError = "invalid score store header";
+		return false;
+	}
+	fDuration.set (num, denum);
+	fMusicOffset = offset;
+	fMusicSize = length;
+	fVoices.resize (count);
+	for (auto& voice: fVoices) {
+		if (!getnum (ptr, end, offset) || !getnum (ptr, end, length)
+			|| !getsigned (ptr, end, num) || !getsigned (ptr, end, denum) || !getsigned (ptr, end, voice.fEvents)) {
+			fError = "invalid score store header";
+			return false;
+		}
+		voice.fOffset = offset;
+		voice.fSize = length;
+		voice.fDuration.set (num, denum);
+	}
+	fData = (const char*)ptr;
+	fDataEnd = (const char*)end;
+
+	size_t available = size_t(end - ptr);
+	bool valid = (fMusicOffset <= available) && (fMusicSize <= available - fMusicOffset);
+	for (const auto& voice: fVoices)
+		valid = valid && (voice.fOffset <= available) && (voice.fSize <= available - voice.fOffset);
+	if (!valid) fError = "invalid score store offsets";
+	return valid;
+}
+
+//______________________________________________________________________________
+SARMusic scorestore::music ()
+{
+	if (!fData) {
+		fError = "no score store opened";
+		return 0;
+	}
+	binaryreader reader;
+	reader.setArena (fArena);
+	SARMusic music = reader.readMusic (fData + fMusicOffset, fMusicSize);
+	if (!music) {
+		fError = reader.getError();
+		return 0;
+	}
+	// the voices of the score are empty: they are replaced with the stored voices
+	size_t index = 0;
+	for (auto& elt: music->elements()) {
+		const ARVoice* voice = dynamic_cast<const ARVoice*>((const guidoelement*)elt);
+		if (!voice) continue;
+		if (index >= fVoices.size()) {
+			fError = "inconsistent score store";
+			return 0;
+		}
+		SARStoredVoice stored = ARStoredVoice::create (this, index++, fArena);
+		if (voice->getName() != stored->getName()) stored->setName (voice->getName());
+		stored->setAuto (voice->getAuto());
+		stored->add (voice->attributes());
+		for (const auto& comment: voice->getBefore())	stored->addBefore (comment);
+		for (const auto& comment: voice->getAfter())	stored->addAfter (comment);
+		elt = stored;
+	}
+	return music;
+}
+
+//______________________________________________________________________________
+Sguidoelement scorestore::voiceContent (size_t index)
+{
+	if (!fData || (index >= fVoices.size())) {
+		fError = "no such voice in the score store";
+		return 0;
+	}
+	binaryreader reader;
+	reader.setArena (fArena);
+	Sguidoelement content = reader.read (fData + fVoices[index].fOffset, fVoices[index].fSize);
+	if (!content) fError = "can't read voice " + to_string(index) + ": " + reader.getError();
+	return content;
+}
+
+//______________________________________________________________________________
+void scorestore::write (const SARMusic& score, ostream& out)
+{
+	// the score is written without its voices content
+	SARMusic music = ARMusic::create();
+	if (score->getName() != music->getName()) music->setName (score->getName());
+	music->setAuto (score->getAuto());
+	music->add (score->attributes());
+	music->setTickBase (score->getTickBase());
+	for (const auto& elt: score->getHeader()) music->addHeader (elt);
+	for (const auto& elt: score->getFooter()) music->addFooter (elt);
+
+	binaryvisitor bv;
+	durationvisitor dv;
+	counteventsvisitor cv;
+	string data;
+	string header (kStoreMagic, kMagicSize);
+	putnum (header, kVersion);
+	string index;
+	rational duration (0,1);
+	unsigned long count = 0;
+	for (const auto& elt: score->elements()) {
+		ARVoice* voice = dynamic_cast<ARVoice*>((guidoelement*)elt);
+		if (!voice) {
+			music->push (elt);
+			continue;
+		}
+		ARStoredVoice* stored = dynamic_cast<ARStoredVoice*>(voice);
+		if (stored) stored->load();
+		SARVoice empty = ARVoice::create();
+		if (voice->getName() != empty->getName()) empty->setName (voice->getName());
+		empty->setAuto (voice->getAuto());
+		empty->add (voice->attributes());
+		for (const auto& comment: voice->getBefore())	empty->addBefore (comment);
+		for (const auto& comment: voice->getAfter())	empty->addAfter (comment);
+		music->push (empty);
+
+		Sguidoelement content = guidoelement::create();
+		content->push (voice->elements());
+		string bin = bv.write (content);
+		rational vduration = dv.duration (elt);
+		if (vduration > duration) duration = vduration;
+		putnum (index, data.size());
+		putnum (index, bin.size());
+		putsigned (index, vduration.getNumerator());
+		putsigned (index, vduration.getDenominator());
+		putsigned (index, cv.count (elt));
+		data += bin;
+		count++;
+	}
+	string bin = bv.write (music);
+	putsigned (header, duration.getNumerator());
+	putsigned (header, duration.getDenominator());
+	putnum (header, data.size());
+	putnum (header, bin.size());
+	putnum (header, count);
+	out.write (header.data(), header.size());
+	out.write (index.data(), index.size());
+	out.write (data.data(), data.size());
+	out.write (bin.data(), bin.size());
+}
+
+} // namespace
@@ -0,0 +1,189 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "arexport.h"
+#include "AROthers.h"
+#include "ARTypes.h"
+#include "garena.h"
+#include "guidorational.h"
+
+namespace guido
+{
+
+class scorestore;
+typedef SMARTP<scorestore> Sscorestore;
+
+//______________________________________________________________________________
+/*!
+\brief	A voice of a score store, read from the store when first accessed.
+
+	The voice name, attributes and comments are available from the start,
+	the voice content is read when the voice is visited, when its size or its
+	elements are requested or when an element is added. elements() is not
+	virtual: code that accesses the elements through an ARVoice or a
+	guidoelement must call load() first.
+	A voice that can't be read is left empty, load() then returns false and
+	the store getError() gives the reason.
+*/
+class gar_export ARStoredVoice : public ARVoice
+{
+	Sscorestore	fStore;
+	size_t		fIndex;
+	bool		fLoaded;
+	bool		fFailed;
+
+	protected:
+				 ARStoredVoice(const Sscorestore& store, size_t index) : fStore(store), fIndex(index), fLoaded(false), fFailed(false) {}
+		virtual ~ARStoredVoice() {}
+
+	public:
+		static SMARTP<ARStoredVoice> create(const Sscorestore& store, size_t index, garena* arena=0);
+
+		/*! \brief reads the voice content from the store (if not already done)
+			\return false when the content can't be read (see scorestore::getError())
+		*/
+		bool			load ();
+		bool			loaded () const		{ return fLoaded; }
+		//! true when the voice content couldn't be read
+		bool			failed () const		{ return fFailed; }
+		//! the voice index in the store
+		size_t			index () const		{ return fIndex; }
+		//! the voice duration and events count, as stored i.e. meaningless when the voice is modified
+		const rational&	duration () const;
+		long			events () const;
+
+		virtual void	acceptIn(basevisitor& v);
+
+		branchs&		elements ()					{ load(); return ARVoice::elements(); }
+		const branchs&	elements () const			{ const_cast<ARStoredVoice*>(this)->load(); return ARVoice::elements(); }
+
+		virtual void push (const Sguidoelement& t)	{ load(); ARVoice::push (t); }
+		virtual void push (Sguidoelement&& t)		{ load(); ARVoice::push (std::move(t)); }
+		virtual void push (const branchs& b)		{ load(); ARVoice::push (b); }
+		virtual void push (branchs&& b)				{ load(); ARVoice::push (std::move(b)); }
+		virtual int  size  () const					{ const_cast<ARStoredVoice*>(this)->load(); return ARVoice::size(); }
+		virtual bool empty () const					{ const_cast<ARStoredVoice*>(this)->load(); return ARVoice::empty(); }
+		virtual void clear ()						{ fLoaded = true; ARVoice::clear(); }
+};
+typedef SMARTP<ARStoredVoice> SARStoredVoice;
+
+//______________________________________________________________________________
+/*!
+\brief	A read-only file of scores whose voices are read on demand.
+
+	A store file starts with a header that gives the score duration and, for
+	each voice, its location in the file, its duration and its events count.
+	The header is followed by the binary form (see garbinary) of each voice
+	content, then by the binary form of the score without the voices content.
+	The file is mapped in memory when possible.
+
+	music() gives a score made of ARStoredVoice: the voices content is read
+	when a voice is first accessed, thus operations that don't browse all the
+	voices (e.g. a top operation, a voice count or the duration of a score
+	whose voices have not been accessed) don't read the whole file.
+
+	The header layout, all numbers being written as in the binary form:
+	- the 4 bytes kStoreMagic and the format version
+	- the score duration numerator and denominator
+	- the offset and the size of the score binary form
+	- the voices count
+	- for each voice: the offset and the size of its content binary form, its
+	  duration numerator and denominator and its events count
+	The offsets are relative to the end of the header.
+*/
+class gar_export scorestore : public smartable
+{
+	public:
+		enum { kVersion = 1 };
+		static const char kStoreMagic[];
+
+		struct voiceinfo {
+			size_t		fOffset;
+			size_t		fSize;
+			rational	fDuration;
+			long		fEvents;
+		};
+
+		static Sscorestore create();
+
+		/*! \brief opens a store file
+			A store is opened once, the file is closed when the store and all
+			the stored voices are gone.
+			\param file the file name
+			\return false when the file can't be read or is not a valid store (see getError())
+		*/
+		bool		open (const char* file);
+		//! the message of the last error
+		const std::string& getError () const			{ return fError; }
+
+		//! sets the arena used to allocate the scores and voices read from the store
+		void			setArena (const Sgarena& arena)	{ fArena = arena; }
+		const Sgarena&	getArena () const				{ return fArena; }
+
+		//! the score duration, as stored
+		const rational&		duration () const			{ return fDuration; }
+		//! the voices count
+		size_t				voices () const				{ return fVoices.size(); }
+		//! the stored data of a voice
+		const voiceinfo&	voice (size_t index) const	{ return fVoices[index]; }
+
+		/*! \brief gives the score of the store
+			Each call gives a new score, made of stored voices (see ARStoredVoice).
+			\return the score, or null in case of error
+		*/
+		SARMusic	music ();
+		//! reads the content of a voice, null in case of error
+		Sguidoelement	voiceContent (size_t index);
+
+		/*! \brief writes a score as a store
+			\param score the score
+			\param out the output stream, which must be opened in binary mode
+		*/
+		static void	write (const SARMusic& score, std::ostream& out);
+
+	protected:
+				 scorestore() : fData(nullptr), fDataEnd(nullptr), fMap(nullptr), fMapSize(0) {}
+		virtual ~scorestore();
+
+	private:
+		const char*				fData;		// the store data i.e. after the header
+		const char*				fDataEnd;
+		void*					fMap;		// the memory mapped file (if any)
+		size_t					fMapSize;
+		std::string				fBuffer;	// the file content when it's not mapped
+		Sgarena					fArena;
+		std::string				fError;
+
+		rational				fDuration;
+		size_t					fMusicOffset = 0;
+		size_t					fMusicSize = 0;
+		std::vector<voiceinfo>	fVoices;
+
+		bool	read (const char* data, size_t size);
+		void	close ();
+};
+
+} // namespace
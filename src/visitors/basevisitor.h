@@ -23,13 +23,44 @@
 #ifndef __basevisitor__
 #define __basevisitor__
 
+#include <vector>
+
 namespace guido 
 {
 
+/*!
+\brief the base class of the visitors
+
+	The base visitor holds the dispatch table used by the visitable objects
+	(see dispatcher in visitor.h): for each type of visitable object, the table
+	stores the visitor<C> interface that handles it. The table is filled the
+	first time an object of a given type is visited, it is not copied with the
+	visitor.
+*/
 class basevisitor 
 {
 	public:
+		//! a dispatch table entry
+		struct target {
+			enum { kUnresolved=-2, kNone=-1 };
+			void*	fVisitor;	///< the visitor<C> interface that handles the type
+			int		fLevel;		///< the index of C in the type dispatch list, or kUnresolved or kNone
+			target() : fVisitor(0), fLevel(kUnresolved) {}
+		};
+
+				 basevisitor() {}
+				 basevisitor(const basevisitor&) {}
 		virtual ~basevisitor() {}
+		basevisitor& operator= (const basevisitor&)	{ return *this; }
+
+		//! gives the dispatch table entry of a type
+		target& dispatch (unsigned int type) {
+			if (type >= fDispatch.size()) fDispatch.resize (type + 1);
+			return fDispatch[type];
+		}
+
+	private:
+		std::vector<target>	fDispatch;
 };
 
 }
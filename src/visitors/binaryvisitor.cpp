@@ -0,0 +1,193 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifdef WIN32
+#pragma warning (disable : 4786)
+#endif
+
+#include <cstring>
+
+#include "binaryvisitor.h"
+#include "ARChord.h"
+#include "ARNote.h"
+#include "AROthers.h"
+#include "ARTag.h"
+#include "garbinary.h"
+
+using namespace std;
+
+namespace guido
+{
+
+using namespace garbinary;
+
+//______________________________________________________________________________
+string binaryvisitor::write (const Sguidoelement& elt)
+{
+	fOut.clear();
+	fStrings.clear();
+	fOut.append (kMagic, kMagicSize);
+	putnum (fOut, kVersion);
+	if (elt) fBrowser.browse (*elt);
+	fStrings.clear();
+	return std::move(fOut);
+}
+
+void binaryvisitor::write (const Sguidoelement& elt, ostream& out)
+{
+	string bin = write (elt);
+	out.write (bin.data(), bin.size());
+}
+
+//______________________________________________________________________________
+// a string is written once, then referred to by its index
+void binaryvisitor::putstring (const string& str)
+{
+	auto i = fStrings.emplace (str, fStrings.size());
+	putnum (fOut, i.first->second);
+	if (i.second) {
+		putnum (fOut, str.size());
+		fOut += str;
+	}
+}
+
+//______________________________________________________________________________
+void binaryvisitor::start (int kind, const guidoelement& elt)
+{
+	int flags = 0;
+	if (elt.getAuto())				flags |= kAuto;
+	if (elt.attributes().size())	flags |= kAttributes;
+	if (elt.size())					flags |= kElements;
+	fOut += char(kind);
+	fOut += char(flags);
+	putstring (elt.getName());
+}
+
+//______________________________________________________________________________
+// the attributes and the count of sub elements, which are written by the browser
+void binaryvisitor::content (const guidoelement& elt)
+{
+	const Sguidoattributes& attributes = elt.attributes();
+	if (attributes.size()) {
+		putnum (fOut, attributes.size());
+		for (const auto& attr: attributes) {
+			putstring (attr->getName());
+			putstring (attr->getUnit());
+			int type = attr->getType();
+			fOut += char(attr->quoteVal() ? type | kQuote : type);
+			switch (type) {
+				case guidoattribute::kLong:
+					putsigned (fOut, long(*attr));
+					break;
+				case guidoattribute::kFloat: {
+					double value = attr->getFloat();
+					unsigned long long bits;
+					memcpy (&bits, &value, sizeof(bits));
+					for (int i = 0; i < 8; i++, bits >>= 8)
+						fOut += char(bits & 0xff);
+					}
+					break;
+				default:
+					putstring (attr->getValue());
+			}
+		}
+	}
+	if (elt.size()) putnum (fOut, elt.size());
+}
+
+//______________________________________________________________________________
+void binaryvisitor::elements (const vector<Sguidoelement>& elts)
+{
+	putnum (fOut, elts.size());
+	for (const auto& elt: elts) fBrowser.browse (*elt);
+}
+
+//______________________________________________________________________________
+void binaryvisitor::visitStart ( Sguidoelement& elt )
+{
+	start (kElement, *elt);
+	content (*elt);
+}
+
+void binaryvisitor::visitStart ( Sguidocomment& elt )
+{
+	start (kComment, *elt);
+	content (*elt);
+}
+
+void binaryvisitor::visitStart ( Sguidovariable& elt )
+{
+	start (kVariable, *elt);
+	content (*elt);
+}
+
+void binaryvisitor::visitStart ( Sguidotag& elt )
+{
+	start (kTag, *elt);
+	putsigned (fOut, elt->getID());
+	content (*elt);
+}
+
+void binaryvisitor::visitStart ( SARNote& elt )
+{
+	start (kNote, *elt);
+	const rational& duration = elt->duration();
+	putsigned (fOut, duration.getNumerator());
+	putsigned (fOut, duration.getDenominator());
+	putsigned (fOut, elt->GetDots());
+	putsigned (fOut, elt->GetOctave());
+	putsigned (fOut, elt->GetAccidental());
+	content (*elt);
+}
+
+void binaryvisitor::visitStart ( SARChord& elt )
+{
+	start (kChord, *elt);
+	content (*elt);
+}
+
+//______________________________________________________________________________
+void binaryvisitor::visitStart ( SARMusic& elt )
+{
+	start (kMusic, *elt);
+	putsigned (fOut, elt->getTickBase());
+	elements (elt->getHeader());
+	content (*elt);
+}
+
+void binaryvisitor::visitEnd ( SARMusic& elt )
+{
+	elements (elt->getFooter());
+}
+
+//______________________________________________________________________________
+void binaryvisitor::visitStart ( SARVoice& elt )
+{
+	start (kVoice, *elt);
+	elements (elt->getBefore());
+	content (*elt);
+}
+
+void binaryvisitor::visitEnd ( SARVoice& elt )
+{
+	elements (elt->getAfter());
+}
+
+} // namespace
@@ -0,0 +1,95 @@
+/*
+
+  guidoar Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#ifndef __binaryvisitor__
+#define __binaryvisitor__
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "arexport.h"
+#include "ARTypes.h"
+#include "guidocomment.h"
+#include "guidovariable.h"
+#include "tree_browser.h"
+#include "visitor.h"
+
+namespace guido
+{
+
+/*!
+\addtogroup visitors
+@{
+*/
+
+//______________________________________________________________________________
+/*!
+\brief	A visitor to write the binary form of a score (see garbinary).
+
+	The binary form can be read back by binaryreader, without the gmn parser.
+*/
+class gar_export binaryvisitor :
+	public visitor<Sguidoelement>,
+	public visitor<Sguidotag>,
+	public visitor<SARNote>,
+	public visitor<SARMusic>,
+	public visitor<SARChord>,
+	public visitor<SARVoice>,
+	public visitor<Sguidocomment>,
+	public visitor<Sguidovariable>
+{
+	private:
+		std::string		fOut;			///< the binary output
+		std::unordered_map<std::string, unsigned long>	fStrings;	///< the strings already written, with their index
+		tree_browser<guidoelement> fBrowser;
+
+		void putstring	(const std::string& str);
+		void start		(int kind, const guidoelement& elt);
+		void content	(const guidoelement& elt);
+		void elements	(const std::vector<Sguidoelement>& elts);
+
+    public:
+				 binaryvisitor() : fBrowser(this) {}
+		virtual ~binaryvisitor() {}
+
+		//! gives the binary form of an element and its sub elements
+		std::string	write (const Sguidoelement& elt);
+		//! writes the binary form of an element and its sub elements to a stream
+		void		write (const Sguidoelement& elt, std::ostream& out);
+
+		virtual void visitStart ( Sguidoelement& elt );
+		virtual void visitStart ( Sguidocomment& elt );
+		virtual void visitStart ( Sguidovariable& elt );
+		virtual void visitStart ( Sguidotag& elt );
+		virtual void visitStart ( SARNote& elt );
+		virtual void visitStart ( SARMusic& elt );
+		virtual void visitStart ( SARChord& elt );
+		virtual void visitStart ( SARVoice& elt );
+
+		virtual void visitEnd ( SARMusic& elt );
+		virtual void visitEnd ( SARVoice& elt );
+};
+
+/*! @} */
+
+} // namespace
+
+#endif
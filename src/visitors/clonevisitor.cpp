@@ -60,15 +60,11 @@ Sguidoelement clonevisitor::clone(const Sguidoelement& elt)
 //______________________________________________________________________________
 void clonevisitor::copyAttributes (const Sguidoelement& src, Sguidoelement& dst ) const
 {
-	Sguidoattributes attr = src->attributes();
+	const Sguidoattributes& attr = src->attributes();
+	dst->attributes().reserve (dst->attributes().size() + attr.size());
 	Sguidoattributes::const_iterator iter;
-	for (iter=attr.begin(); iter != attr.end(); iter++) {
-		Sguidoattribute ac = guidoattribute::create();
-		ac->setName ( (*iter)->getName());
-		ac->setValue( (*iter)->getValue(), (*iter)->quoteVal());
-		ac->setUnit ( (*iter)->getUnit());
-		dst->add( ac );
-	}
+	for (iter=attr.begin(); iter != attr.end(); iter++)
+		dst->add( (*iter)->clone() );
 }
 
 //______________________________________________________________________________
@@ -120,22 +116,28 @@ void clonevisitor::push( const Sguidoelement& elt, bool stack )
 void clonevisitor::visitStart( SARMusic& elt )
 {
 	SARMusic music = ARFactory::instance().createMusic();
-	for (auto elt: elt->getHeader()) music->addHeader (elt);
-	for (auto elt: elt->getFooter()) music->addFooter (elt);
+	for (const auto& h: elt->getHeader()) music->addHeader (h);
+	for (const auto& f: elt->getFooter()) music->addFooter (f);
 	fStack.push (music);
 }
 
 //______________________________________________________________________________
 void clonevisitor::visitStart( Sguidovariable& elt ) {
 	if (copy()) {
-		Sguidoelement c = guidovariable::create();
-		push( copy(elt, c), false );
+		if (fShare) push (Sguidoelement(elt), false);
+		else {
+			Sguidoelement c = guidovariable::create();
+			push( copy(elt, c), false );
+		}
 	}
 }
 void clonevisitor::visitStart( Sguidocomment& elt )  {
 	if (copy()) {
-		Sguidoelement c = guidocomment::create();
-		push( copy(elt,c ), false );
+		if (fShare) push (Sguidoelement(elt), false);
+		else {
+			Sguidoelement c = guidocomment::create();
+			push( copy(elt,c ), false );
+		}
 	}
 }
 
@@ -161,7 +163,8 @@ void clonevisitor::visitStart( SARChord& elt )
 void clonevisitor::visitStart( SARNote& elt )
 {
 	if (copy()) {
-		push( copy(elt), false );
+		if (fShare) push (elt, false);
+		else push( copy(elt), false );
 	}
 }
 
@@ -169,8 +172,11 @@ void clonevisitor::visitStart( SARNote& elt )
 void clonevisitor::visitStart( Sguidotag& elt )
 {
 	if (copy()) {
-		Sguidoelement cc = ARFactory::instance().createTag(elt->getName(), elt->getID() );
-		push( copy (elt, cc), elt->size() ? true : false );
+		if (fShare && !elt->size()) push (Sguidoelement(elt), false);
+		else {
+			Sguidoelement cc = ARFactory::instance().createTag(elt->getName(), elt->getID() );
+			push( copy (elt, cc), elt->size() ? true : false );
+		}
 	}
 }
 
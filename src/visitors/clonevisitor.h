@@ -42,6 +42,15 @@ namespace guido
 //______________________________________________________________________________
 /*!
 \brief	A visitor to print the gmn description
+
+	When sharing is enabled, the notes, the tags without content, the comments
+	and the variables are not copied: the cloned tree shares them with the
+	source tree. Shared elements must not be modified in place: an operation
+	that modifies an element works on a copy of the element (see copy()).
+	Voices, chords and range tags are always copied.
+	Sharing should be enabled only when neither the source nor the result will
+	be edited in place, e.g. when the result is printed then dropped, or when
+	the source is an intermediate result that is dropped afterwards.
 */
 class gar_export clonevisitor :
 	public visitor<SARMusic>,
@@ -53,12 +62,16 @@ class gar_export clonevisitor :
 	public visitor<Sguidovariable>
 {
     public:
-				 clonevisitor() {}
+				 clonevisitor() : fShare(false) {}
        	virtual ~clonevisitor() {}
               
 		virtual Sguidoelement clone(const Sguidoelement&);
 		virtual Sguidoelement result()		{ Sguidoelement res = fStack.top(); fStack.pop(); return res; }
 
+		//! enables or disables the elements sharing (disabled by default)
+		void	share (bool state)			{ fShare = state; }
+		bool	share () const				{ return fShare; }
+
 	protected:
 		virtual void visitStart( SARMusic& elt );
 		virtual void visitStart( SARVoice& elt );
@@ -82,6 +95,7 @@ class gar_export clonevisitor :
 		virtual SARNote			copy (const SARNote& elt) const;
 
 		std::stack<Sguidoelement> fStack;
+		bool	fShare;
 };
 
 /*! @} */
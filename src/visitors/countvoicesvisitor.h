@@ -3,6 +3,7 @@
 #define __countVoicesVisitor__
 
 #include "arexport.h"
+#include "AROthers.h"
 #include "guidoelement.h"
 #include "ARTypes.h"
 #include "tree_browser.h"
@@ -20,30 +21,33 @@ namespace guido
 /*!
 \brief  a visitor to count the number of voices in a score
 */
-class gar_export countvoicesvisitor : public visitor<SARVoice>
+class gar_export countvoicesvisitor :
+	public visitor<SARMusic>,
+	public visitor<SARVoice>
 {
 public: 
 				 countvoicesvisitor() { fBrowser.set(this); }
 		virtual ~countvoicesvisitor() {}
     
     int count (const Sguidoelement& elt) {
-		fCountEnter = 0;
-		fCountLeave = 0;
+		fCount = 0;
+		fBrowser.stop (false);
         if (elt) fBrowser.browse (*elt);
-        if (fCountEnter != fCountLeave) {
-			printf("Didn't count same voice count going in and out! (%d, %d)\n", fCountEnter, fCountLeave);
-			std::cout.flush();
-		}
-		return fCountEnter;
+		return fCount;
     }
     
-    virtual void visitStart ( SARVoice& elt )   { fCountEnter++; }
-	virtual void visitEnd   ( SARVoice& elt )   { fCountLeave++; }
+	// the voices are the score elements: they are counted without being browsed,
+	// which also avoids loading the voices of a score store (see scorestore)
+    virtual void visitStart ( SARMusic& elt ) {
+		for (const auto& e: elt->elements())
+			if (dynamic_cast<const ARVoice*>((const guidoelement*)e)) fCount++;
+		fBrowser.stop();
+	}
+    virtual void visitStart ( SARVoice& elt )   { fCount++; fBrowser.stop(); }
 
 protected:
 	tree_browser<guidoelement> fBrowser;
-	int fCountEnter;
-	int	fCountLeave;
+	int fCount;
 };
 
 /*! @} */
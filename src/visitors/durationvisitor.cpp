@@ -23,12 +23,15 @@
 */
 
 #include <iostream>
+#include <vector>
 
 #include "ARChord.h"
 #include "ARNote.h"
 #include "AROthers.h"
 #include "durationvisitor.h"
+#include "scorestore.h"
 #include "tree_browser.h"
+#include "voicepool.h"
 
 using namespace std;
 
@@ -39,9 +42,70 @@ namespace guido
 rational durationvisitor::duration(const Sguidoelement& elt)
 { 
 	fDuration = rational(0,1);
+	fDurationTicks = 0;
+	initTicks (elt);
 	reset();
-	if (elt) fBrowser.browse (*elt);
-	return fDuration;
+	rational stored (0,1);
+	if (elt && !browseStored (elt, stored)) fBrowser.browse (*elt);
+	rational duration = fTickBase ? fromTicks (fDurationTicks, fTickBase) : fDuration;
+	return (stored > duration) ? stored : duration;
+}
+
+//______________________________________________________________________________
+rational durationvisitor::voicesDuration(const Sguidoelement& score)
+{
+	vector<Sguidoelement> voices = voicepool::voices (score);
+	if (voices.empty()) return duration (score);
+
+	initTicks (score);
+	long base = fTickBase;
+	vector<rational> durations (voices.size());
+	voicepool::run (voices.size(), [&] (size_t i) {
+		const ARStoredVoice* stored = dynamic_cast<const ARStoredVoice*>((const guidoelement*)voices[i]);
+		if (stored && !stored->loaded()) durations[i] = stored->duration();
+		else {
+			durationvisitor dv;
+			durations[i] = dv.voiceDuration (voices[i], base);
+		}
+	});
+	rational duration (0,1);
+	for (const auto& d: durations)
+		if (d > duration) duration = d;
+	return duration;
+}
+
+rational durationvisitor::voiceDuration (const Sguidoelement& voice, long base)
+{
+	fDuration = rational(0,1);
+	fDurationTicks = 0;
+	setTickBase (base);
+	reset();
+	fBrowser.browse (*voice);
+	return fTickBase ? fromTicks (fDurationTicks, fTickBase) : fDuration;
+}
+
+//______________________________________________________________________________
+// the voices of a score store that are not loaded are not browsed: their duration
+// is known from the store (see scorestore)
+bool durationvisitor::browseStored (const Sguidoelement& elt, rational& duration)
+{
+	const ARMusic* music = dynamic_cast<const ARMusic*>((const guidoelement*)elt);
+	if (!music) return false;
+	bool stored = false;
+	for (const auto& e: music->elements()) {
+		const ARStoredVoice* voice = dynamic_cast<const ARStoredVoice*>((const guidoelement*)e);
+		if (voice && !voice->loaded()) {
+			if (voice->duration() > duration) duration = voice->duration();
+			stored = true;
+		}
+	}
+	if (stored) {
+		for (const auto& e: music->elements()) {
+			const ARStoredVoice* voice = dynamic_cast<const ARStoredVoice*>((const guidoelement*)e);
+			if (!voice || voice->loaded()) fBrowser.browse (*e);
+		}
+	}
+	return stored;
 }
 
 //______________________________________________________________________________
@@ -51,6 +115,93 @@ void durationvisitor::reset()
 	fCurrentChordDuration = fCurrentVoiceDuration = rational(0,1);
 	fCurrentNoteDuration = ARNote::getDefaultDuration();
 	fCurrentDots = 0;
+	fCurrentChordTicks = fCurrentVoiceTicks = 0;
+	if (fTickBase) toTicks (fCurrentNoteDuration, fTickBase, fCurrentNoteTicks);
+}
+
+//______________________________________________________________________________
+void durationvisitor::resume (const rational& date, const rational& noteDuration, int dots)
+{
+	reset();
+	fCurrentVoiceDuration = date;
+	fCurrentNoteDuration = noteDuration;
+	fCurrentDots = dots;
+	if (fTickBase && !(toTicks (date, fTickBase, fCurrentVoiceTicks) && toTicks (noteDuration, fTickBase, fCurrentNoteTicks))) {
+		fDuration = fromTicks (fDurationTicks, fTickBase);
+		fTickBase = 0;					// switches to rationals
+	}
+}
+
+//______________________________________________________________________________
+// ticks management
+//______________________________________________________________________________
+bool durationvisitor::toTicks (const rational& date, long base, long long& ticks)
+{
+	long long n = (long long)date.getNumerator() * base;
+	long long d = date.getDenominator();
+	if (d < 0) { n = -n; d = -d; }
+	ticks = n / d;
+	long long r = n % d;
+	if (r < 0) ticks--;					// rounds down
+	return r == 0;
+}
+
+rational durationvisitor::fromTicks (long long ticks, long base)
+{
+	return rational(long(ticks), base).rationalise();
+}
+
+//______________________________________________________________________________
+void durationvisitor::setTickBase (long base)
+{
+	long long ticks = 0;
+	// the default duration must be an integer number of ticks
+	fTickBase = ((base > 0) && toTicks (ARNote::getDefaultDuration(), base, ticks)) ? base : 0;
+	fCurrentNoteTicks = ticks;
+}
+
+void durationvisitor::initTicks (const Sguidoelement& score)
+{
+	const ARMusic* music = dynamic_cast<const ARMusic*>((const guidoelement*)score);
+	setTickBase (music ? music->getTickBase() : 0);
+}
+
+void durationvisitor::leaveTicks ()
+{
+	fCurrentVoiceDuration = fromTicks (fCurrentVoiceTicks, fTickBase);
+	fCurrentChordDuration = fromTicks (fCurrentChordTicks, fTickBase);
+	fDuration = fromTicks (fDurationTicks, fTickBase);
+	fTickBase = 0;
+}
+
+rational durationvisitor::currentVoiceDate() const
+{
+	return fTickBase ? fromTicks (fCurrentVoiceTicks, fTickBase) : fCurrentVoiceDuration;
+}
+
+//______________________________________________________________________________
+// computes the note duration in ticks, with the same rules than ARNote::totalduration
+// the current duration and dots are updated only when the duration is an integer number of ticks
+bool durationvisitor::noteTicks (const SARNote& elt, long long& ticks)
+{
+	const rational& dur = elt->duration();
+	bool implicit = ARNote::implicitDuration (dur);
+	long long base = fCurrentNoteTicks;
+	if (!implicit && !toTicks (dur, fTickBase, base)) return false;
+
+	int dots = elt->GetDots();
+	if (!dots) dots = implicit ? fCurrentDots : 0;
+	ticks = base;
+	for (int i = 1; i <= dots; i++) {
+		if (base & ((1LL << i) - 1)) return false;
+		ticks += base >> i;
+	}
+	if (!implicit) {
+		fCurrentNoteDuration = dur;
+		fCurrentNoteTicks = base;
+	}
+	fCurrentDots = dots;
+	return true;
 }
 
 //______________________________________________________________________________
@@ -62,12 +213,23 @@ void durationvisitor::visitStart( SARVoice& elt )	{ reset();	}
 void durationvisitor::visitStart( SARChord& elt )
 {
 	fCurrentChordDuration = rational(0,1);
+	fCurrentChordTicks = 0;
 	fInChord = true;
 }
 
 //______________________________________________________________________________
 void durationvisitor::visitStart( SARNote& elt )
 {
+	if (fTickBase) {
+		long long ticks;
+		if (noteTicks (elt, ticks)) {
+			if (!fInChord) fCurrentVoiceTicks += ticks;
+			else if (ticks > fCurrentChordTicks) fCurrentChordTicks = ticks;
+			return;
+		}
+		leaveTicks();
+	}
+
 	rational duration = elt->totalduration(fCurrentNoteDuration, fCurrentDots);	
 	if ( fInChord ) {
 		if (duration > fCurrentChordDuration)
@@ -82,14 +244,18 @@ void durationvisitor::visitStart( SARNote& elt )
 //______________________________________________________________________________
 void durationvisitor::visitEnd  ( SARVoice& elt )
 { 
-	if (fCurrentVoiceDuration > fDuration) 
+	if (fTickBase) {
+		if (fCurrentVoiceTicks > fDurationTicks) fDurationTicks = fCurrentVoiceTicks;
+	}
+	else if (fCurrentVoiceDuration > fDuration) 
 		fDuration = fCurrentVoiceDuration;
 }
 
 //______________________________________________________________________________
 void durationvisitor::visitEnd  ( SARChord& elt )
 { 
-	fCurrentVoiceDuration += fCurrentChordDuration;
+	if (fTickBase) fCurrentVoiceTicks += fCurrentChordTicks;
+	else fCurrentVoiceDuration += fCurrentChordDuration;
 	fInChord = false;
 }
 
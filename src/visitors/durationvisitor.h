@@ -43,7 +43,12 @@ namespace guido
 
 //______________________________________________________________________________
 /*!
-\brief	A visitor to print the gmn description
+\brief	A visitor to compute the dates and durations of a score
+
+	When the score has a tick base (see ARMusic::getTickBase), the dates are
+	computed as integer numbers of ticks and converted to rationals on demand.
+	The visitor falls back to rationals when a duration is not an integer
+	number of ticks (e.g. when the score has been modified since parsed).
 */
 class gar_export durationvisitor :
 	public visitor<SARVoice>,
@@ -51,7 +56,7 @@ class gar_export durationvisitor :
 	public visitor<SARNote>
 {
     public:
-				 durationvisitor() { fBrowser.set(this); }
+				 durationvisitor() : fTickBase(0) { fBrowser.set(this); reset(); }
        	virtual ~durationvisitor() {}
               
 		/*!
@@ -60,9 +65,45 @@ class gar_export durationvisitor :
 			\return the total duration of the input score expressed as a rational (where 1 is a whole note)
 		*/
 		virtual rational duration(const Sguidoelement& score);
+
+		/*!
+			\brief computes the duration of a score voice by voice
+			The voices are browsed concurrently when possible (see voicepool),
+			the result is the same as duration().
+			\param score an input score
+			\return the total duration of the input score
+		*/
+		rational voicesDuration(const Sguidoelement& score);
  
 		virtual void reset();
 		bool  inChord() const	{ return fInChord; }
+		/*!
+			\brief sets the current voice state, to resume the browsing of a voice elsewhere than at its start
+			\param date the current voice date
+			\param noteDuration the current implicit note duration
+			\param dots the current implicit dots
+		*/
+		void  resume (const rational& date, const rational& noteDuration, int dots);
+
+		/*!
+			\brief sets the tick base used to compute the dates
+			\param base the number of ticks of a whole note, 0 to compute the dates with rationals
+		*/
+		void	setTickBase (long base);
+		long	tickBase () const					{ return fTickBase; }
+		//! the current voice date in ticks, meaningful when tickBase() is not null
+		long long currentVoiceTicks () const		{ return fCurrentVoiceTicks; }
+
+		/*!
+			\brief converts a date to ticks
+			\param date the date to convert
+			\param base the tick base
+			\param ticks on output, the date in ticks, rounded down when not exact
+			\return true when the date is an integer number of ticks
+		*/
+		static bool		toTicks (const rational& date, long base, long long& ticks);
+		//! converts a date in ticks to a rational
+		static rational	fromTicks (long long ticks, long base);
 
 		virtual void visitStart( SARVoice& elt );
 		virtual void visitStart( SARChord& elt );
@@ -71,12 +112,21 @@ class gar_export durationvisitor :
 		virtual void visitEnd  ( SARVoice& elt );
 		virtual void visitEnd  ( SARChord& elt );
 
-		virtual rational  currentVoiceDate() const		{ return fCurrentVoiceDuration; }
+		virtual rational  currentVoiceDate() const;
 		virtual rational  currentNoteDuration() const	{ return fCurrentNoteDuration; }
 		virtual int		  currentDots() const			{ return fCurrentDots; }
 
 	protected:		
 		virtual void stop (bool state=true)	{ fBrowser.stop (state); }
+		//! sets the tick base of a score (if any)
+		void	initTicks (const Sguidoelement& score);
+		//! switches to rationals
+		void	leaveTicks ();
+		bool	noteTicks (const SARNote& elt, long long& ticks);
+		//! browses a score store voices, the voices that are not loaded give their stored duration
+		bool	browseStored (const Sguidoelement& elt, rational& duration);
+		//! computes the duration of a voice using a given tick base
+		rational voiceDuration (const Sguidoelement& voice, long base);
 
 		rational	fCurrentVoiceDuration;
 		rational	fCurrentChordDuration;
@@ -85,6 +135,12 @@ class gar_export durationvisitor :
 		rational	fDuration;
 		bool		fInChord;
 
+		long		fTickBase;				// the number of ticks of a whole note, 0 when dates are rationals
+		long long	fCurrentVoiceTicks;
+		long long	fCurrentChordTicks;
+		long long	fCurrentNoteTicks;
+		long long	fDurationTicks;
+
 		tree_browser<guidoelement> fBrowser;
 };
 
@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <iostream>
 
 #include "AROthers.h"
@@ -7,6 +8,8 @@
 #include "ARTag.h"
 #include "ARChord.h"
 #include "ARNote.h"
+#include "clonevisitor.h"
+#include "getvoicesvisitor.h"
 #include "guidotags.h"
 
 namespace guido
@@ -32,9 +35,11 @@ static int breakNoteTo(SARVoice voice, SARNote el, rational newDur);
 static int breakChordTo(SARVoice voice, SARChord el, rational newDur);
 static SARNote getCopyOfNote(SARNote el);
 static SARChord getCopyOfChord(SARChord el);
+template <typename T> static SMARTP<T> replaceByCopy(Sguidoelement parent, const SMARTP<T>& el);
 static bool checkSongDuration(SARVoice voice, rational desiredLength);
 static void shiftNoteMidiPitchBy(SARNote note, int currentPitch, int pitchShiftDirection, int keySig, int octaveShift);
-static OpResult shiftRangeMidiPitchBy(SARVoice voice, Sguidoelement startEl, rational rangeLength, int pitchShiftDirection, int keySig, int octaveShift);
+static OpResult collectRange(SARVoice voice, Sguidoelement startEl, rational rangeLength, std::vector<Sguidoelement>& elements);
+static void shiftElementPitchBy(Sguidoelement el, int pitchShiftDirection, int keySig, int octaveShift);
 static rational getRealDuration(Sguidoelement el);
 
 static void print(char* input) {
@@ -176,6 +181,13 @@ static rational getRealDuration(Sguidoelement el) {
 	return el->totalduration(durOut, dots);
 }
 
+// Whether the note has the given pitch (-1 matches any note)
+static bool matchPitch(const SARNote& note, int midiPitch) {
+	if (midiPitch == -1) return true;
+	int octave = note->GetOctave();
+	return note->midiPitch(octave) == midiPitch;
+}
+
 static void getInfoFromMidiPitch(int midiPitch, int keySig, std::string* name, int* octave, int* accidental) {
 	// Initialize variables to fill
 	int pitchFromC = midiPitch % 12;
@@ -234,11 +246,13 @@ OpResult elementoperationvisitor::deleteRange (const Sguidoelement& score, const
 		if (!fFoundNote && !fFoundChord) return OpResult::failure;
 		
 		// Assemble list of rests to fill gap with
-		rationals restDursToAdd = rational::getBaseRationals(endTime - startTime);
+		basedurations restDurs(endTime - startTime);
 		std::vector<Sguidoelement> restsToAdd;
-		for (int i = 0; i < restDursToAdd.size(); i++) {
+		restsToAdd.reserve(restDurs.size());
+		rational restDur; int restDots;
+		while (restDurs.next(restDur, restDots)) {
 			SARNote rest = ARFactory().createNote("_");
-			*rest = restDursToAdd.at(i);
+			*rest = restDur;
 			rest->SetDots(0);
 			restsToAdd.push_back(rest);
 		}
@@ -357,6 +371,9 @@ OpResult elementoperationvisitor::setDurationAndDots(const Sguidoelement& score,
 	// Start off by finding where we are working in the score
 	findResultVoiceChordNote(score, time, voice, -1);
 	
+	// Stop if there's nothing at that time
+	if (!fFoundNote && !fFoundChord) return OpResult::failure;
+	
 	rational foundDurPlain = fFoundChord
 				? fResultChord->duration()
 				: fResultNote->duration();
@@ -401,29 +418,36 @@ OpResult elementoperationvisitor::setDurationAndDots(const Sguidoelement& score,
 		
 	} else /* desiredDur < foundDur */ {
 		// Here, we need to shorted the current element, and then insert the rests needed to
-		// fill the gap we created.
+		// fill the gap we created.  The element is replaced by a shortened copy.
+		Sguidoelement shortened;
 		if (fResultChord != nullptr) {
-			*fResultChord = newDur;
-			fResultChord->SetDots(newDots);
+			SARChord copy = replaceByCopy(fResultVoice, fResultChord);
+			// Stop if we didn't find it (sanity check)
+			if (!copy) return OpResult::failure;
+			*copy = newDur;
+			copy->SetDots(newDots);
+			shortened = copy;
 		} else {
-			*fResultNote = newDur;
-			fResultNote->SetDots(newDots);
+			SARNote copy = replaceByCopy(fResultVoice, fResultNote);
+			if (!copy) return OpResult::failure;
+			*copy = newDur;
+			copy->SetDots(newDots);
+			shortened = copy;
 		}
 		// Find gap length
 		rational gapLength = foundDur - desiredDur;
-		rationals restsToCreate = rational::getBaseRationals(gapLength, false);
+		basedurations restsToCreate(gapLength);
 		auto it = fResultVoice->begin();
 		// Seek to find our spot
-		while ((*it) != fResultChord && (*it) != fResultNote && it != fResultVoice->end()) { it++; }
-		// Stop if we didn't find it (sanity check)
-		if (it == fResultVoice->end()) return OpResult::failure;
+		while (it != fResultVoice->end() && (*it) != shortened) { it++; }
 		
 		// Insert the rests
 		it.rightShift();
 		bool atEndOfVoice = it == fResultVoice->end();
-		for (int i = 0; i < restsToCreate.size(); i++) {
+		rational restDur; int restDots;
+		while (restsToCreate.next(restDur, restDots)) {
 			SARNote rest = ARFactory().createNote("_");
-			*rest = restsToCreate.at(i);
+			*rest = restDur;
 			rest->SetDots(0);
 			if (atEndOfVoice) {
 				fResultVoice->push(rest);
@@ -502,6 +526,10 @@ OpResult elementoperationvisitor::shiftNotePitch(const Sguidoelement& score, con
 
 OpResult elementoperationvisitor::shiftRangeNotePitch(const Sguidoelement& score, const rational& startTime, const rational& endTime, int startVoice, int endVoice, int pitchShiftDirection, int octaveShift) {
 	rational rangeLength = endTime - startTime;
+	// The elements of all the voices are collected first, so that nothing is shifted when
+	// one of the voices can't be
+	std::vector<Sguidoelement> elements;
+	std::vector<int> keySignatures;
 	for (int currVoice = startVoice; currVoice <= endVoice; currVoice++) {
 		// Start off by finding where we are working in the score
 		findResultVoiceChordNote(score, startTime, currVoice, -1);
@@ -510,16 +538,13 @@ OpResult elementoperationvisitor::shiftRangeNotePitch(const Sguidoelement& score
 		Sguidoelement target = fResultNote;
 		if (fFoundChord) target = fResultChord;
 		
-		OpResult result = shiftRangeMidiPitchBy(
-			fResultVoice,
-			target,
-			rangeLength,
-			pitchShiftDirection,
-			fCurrentKeySignature,
-			octaveShift
-		);
-		
+		OpResult result = collectRange(fResultVoice, target, rangeLength, elements);
 		if (result != OpResult::success) return result;
+		keySignatures.resize(elements.size(), fCurrentKeySignature);
+	}
+	
+	for (size_t i = 0; i < elements.size(); i++) {
+		shiftElementPitchBy(elements[i], pitchShiftDirection, keySignatures[i], octaveShift);
 	}
 	return OpResult::success;
 }
@@ -550,6 +575,8 @@ OpResult elementoperationvisitor::insertRange(const Sguidoelement& score, SARVoi
 OpResult elementoperationvisitor::setVoiceInstrument(const Sguidoelement& score, int voice, const char* instrName, int instrCode) {
 	// Start off by finding the first note in the score, and seeing if that voice had an isntrument already
 	findResultVoiceChordNote(score, rational(0, 1), voice, -1);
+	// The instrument tag is searched from the voice start
+	fEditedTop = 0;
 	
 	if (fCurrentInstrument) {
 		// Change the existing tag's attributes to match desired instrument
@@ -617,18 +644,126 @@ OpResult elementoperationvisitor::setVoiceInstrument(const Sguidoelement& score,
 // flags fFoundNote and fFoundChord.
 //
 // Set midiPitch to -1 to look for chords or groups, and specify any other midiPitch to only find elements with that exact pitch
+//
+// The lookup is a binary search in the time index of the voice.  A note matches when it starts at the given time (and
+// has the given pitch), and a chord is found as a whole when midiPitch is -1 and the time falls inside the chord.
 void elementoperationvisitor::findResultVoiceChordNote(const Sguidoelement& score, rational time, int voice, int midiPitch) {
-	fTargetVoice = voice;
-	fTargetDate = time;
-	fTargetMidiPitch = midiPitch;
-	init();
+	fResultVoice = nullptr;
+	fResultChord = nullptr;
+	fResultNote = nullptr;
+	fCurrentKeySignature = 0;
+	fCurrentMeter = "";
+	fCurrentInstrument = nullptr;
+	fFoundNote = false;
+	fFoundChord = false;
+	
+	voiceindexvisitor* index = voiceIndex(score, voice);
+	if (!index) return;
+	index->indexTo(time);
+	fResultVoice = index->voice();
+	
+	const std::vector<indexedevent>& events = index->events();
+	eventdate date = index->makeDate(time);
+	size_t i = index->lowerBound(date);
+	const indexedevent* found = nullptr;
+	// A chord that started earlier and is still sounding at that time
+	if (i > 0 && midiPitch < 0 && events[i-1].fChord && date.endsAfter(events[i-1])) {
+		found = &events[i-1];
+		fResultChord = found->fChord;
+	}
+	// Otherwise, the events starting exactly at that time
+	for ( ; !found && i < events.size() && date.startsAt(events[i]); i++) {
+		const indexedevent& event = events[i];
+		if (event.fNote) {
+			if (matchPitch(event.fNote, midiPitch)) {
+				found = &event;
+				fResultNote = event.fNote;
+			}
+		} else {
+			std::vector<SARNote> notes = event.fChord->notes();
+			for (size_t n = 0; n < notes.size() && !found; n++) {
+				if (matchPitch(notes[n], midiPitch)) {
+					found = &event;
+					fResultChord = event.fChord;
+					fResultNote = notes[n];
+				}
+			}
+			if (!found && midiPitch < 0 && date.endsAfter(event)) {
+				found = &event;
+				fResultChord = event.fChord;
+			}
+		}
+	}
+	
+	// Report the voice state at the result, or where the search stopped
+	voicestate state = found ? found->fState : (i < events.size() ? events[i].fState : index->state());
+	fCurrentKeySignature = state.fKeySignature;
+	fCurrentMeter = state.fMeter;
+	fCurrentInstrument = state.fInstrument;
 	
-	fBrowser.browse(*score);
+	// The edit that follows may modify the voice from the result on
+	fEditedVoice = voice;
+	fEditedTop = found ? found->fTop : events.size() ? events.back().fTop : 0;
 	
 	fFoundNote = fResultNote != nullptr;
 	fFoundChord = fResultChord != nullptr;
 }
 
+voiceindexvisitor* elementoperationvisitor::voiceIndex(const Sguidoelement& score, unsigned int voice) {
+	if (score != fIndexedScore) {
+		invalidate();
+		getvoicesvisitor gvv;
+		std::vector<SARVoice> voices = gvv(score);
+		const ARMusic* music = dynamic_cast<const ARMusic*>((const guidoelement*)score);
+		long tickbase = music ? music->getTickBase() : 0;
+		for (size_t i = 0; i < voices.size(); i++) {
+			fIndex.push_back(new voiceindexvisitor(voices[i], tickbase));
+		}
+		fIndexedScore = score;
+		fModified.assign(voices.size(), size_t(-1));
+	}
+	else if (fEditedVoice >= 0 && fEditedVoice < int(fIndex.size())) {
+		fIndex[fEditedVoice]->invalidate(fEditedTop);
+		fModified[fEditedVoice] = std::min(fModified[fEditedVoice], fEditedTop);
+	}
+	fEditedVoice = -1;
+	return voice < fIndex.size() ? fIndex[voice] : nullptr;
+}
+
+rational elementoperationvisitor::duration(const Sguidoelement& score) {
+	rational result(0, 1);
+	for (unsigned int v = 0; voiceindexvisitor* index = voiceIndex(score, v); v++) {
+		rational end = index->end();
+		if (end > result) result = end;
+	}
+	return result;
+}
+
+void elementoperationvisitor::invalidate() {
+	for (size_t i = 0; i < fIndex.size(); i++) {
+		delete fIndex[i];
+	}
+	fIndex.clear();
+	fIndexedScore = nullptr;
+	fEditedVoice = -1;
+	fModified.clear();
+	fAllModified = true;
+}
+
+bool elementoperationvisitor::takeModified(std::vector<size_t>& modified) {
+	// The last edit is still pending: it is reported here, as the next edit would do
+	if (fEditedVoice >= 0 && fEditedVoice < int(fIndex.size())) {
+		fIndex[fEditedVoice]->invalidate(fEditedTop);
+		fModified[fEditedVoice] = std::min(fModified[fEditedVoice], fEditedTop);
+	}
+	fEditedVoice = -1;
+	bool result = !fAllModified;
+	modified = fModified;
+	fModified.assign(fModified.size(), size_t(-1));
+	fAllModified = false;
+	return result;
+}
+
 static void shiftNoteMidiPitchBy(SARNote note, int currentPitch, int pitchShiftDirection, int keySig, int octaveShift) {
 	if (pitchShiftDirection == 0 && octaveShift == 0) return;
 	
@@ -681,10 +816,22 @@ static void shiftChordMidiPitchBy(ARChord* chord, int pitchShiftDirection, int k
 	}
 }
 
-static OpResult shiftRangeMidiPitchBy(SARVoice voice, Sguidoelement startEl, rational rangeLength, int pitchShiftDirection, int keySig, int octaveShift) {
+static void shiftElementPitchBy(Sguidoelement el, int pitchShiftDirection, int keySig, int octaveShift) {
+	ARChord* isChord = dynamic_cast<ARChord*>((guidoelement*)el);
+	ARNote* isNote = dynamic_cast<ARNote*>((guidoelement*)el);
+	if (isChord) {
+		shiftChordMidiPitchBy(isChord, pitchShiftDirection, keySig, octaveShift);
+	} else if (isNote) {
+		int octave = isNote->GetOctave();
+		shiftNoteMidiPitchBy(isNote, isNote->midiPitch(octave), pitchShiftDirection, keySig, octaveShift);
+	}
+}
+
+// Collects the chords and the notes (rests excepted) of a voice range, starting at a given element
+static OpResult collectRange(SARVoice voice, Sguidoelement startEl, rational rangeLength, std::vector<Sguidoelement>& elements) {
 	// Seek to the start element in the voice
 	auto it = voice->begin();
-	while (startEl != (*it) && it != voice->end()) { it++; }
+	while (it != voice->end() && startEl != (*it)) { it++; }
 	
 	if (it == voice->end()) return OpResult::failure;
 	
@@ -707,11 +854,10 @@ static OpResult shiftRangeMidiPitchBy(SARVoice voice, Sguidoelement startEl, rat
 		ARChord* isChord = dynamic_cast<ARChord*>((&**it));
 		ARNote* isNote = dynamic_cast<ARNote*>((&**it));
 		if (isChord) {
-			shiftChordMidiPitchBy(isChord, pitchShiftDirection, keySig, octaveShift);
+			elements.push_back(*it);
 			rangeLengthLeft -= currentDur;
 		} else if (isNote && !isNote->isRest()) { // Exclude rests; moving them causes a crash
-			int octave = isNote->GetOctave();
-			shiftNoteMidiPitchBy(isNote, isNote->midiPitch(octave), pitchShiftDirection, keySig, octaveShift);
+			elements.push_back(*it);
 			rangeLengthLeft -= currentDur;
 		}
 		
@@ -1011,22 +1157,25 @@ static int breakNoteTo(SARVoice voice, SARNote el, rational timeToRemove) {
 	// If the desired length is the current length, we're done.
 	if (timeToRemove <= rational(0, 1)) return 0;
 	
-	std::vector<int> noDots = std::vector<int>();
-	rationals breakout = rational::getBaseRationals(newDur, false, &noDots);
-	std::vector<int> dots = std::vector<int>();
-	rationals breakoutDotted = rational::getBaseRationals(newDur, true, &dots);
-	// If the new duration can be represented as one note, do that.
-	if (breakout.size() == 1) { *el = newDur;  el->SetDots(0);  return 1; }
-	if (breakoutDotted.size() == 1) { *el = breakoutDotted.at(0);  el->SetDots(1);  return 1; }
+	basedurations breakout(newDur);
+	basedurations breakoutDotted(newDur, true);
+	size_t plainCount = breakout.size();
+	size_t dottedCount = breakoutDotted.size();
+	rational dur; int dots;
+	// If the new duration can be represented as one note, do that (on a copy of the note).
+	if ((plainCount == 1) || (dottedCount == 1)) {
+		if (plainCount == 1) { dur = newDur;  dots = 0; }
+		else breakoutDotted.next(dur, dots);
+		SARNote copy = replaceByCopy(voice, el);
+		if (!copy) return 0;
+		*copy = dur;  copy->SetDots(dots);  return 1;
+	}
 	
 	// If we hit this point, we need to actually break up the note into separate notes to represent it
 	
-	// Point list at non-dotted breakout, unless dotted provides a solution with strictly less notes
-	rationals* durList = &breakout;
-	std::vector<int>* dotList = &noDots;
-	if (breakoutDotted.size() < breakout.size()) { durList = &breakoutDotted;  dotList = &dots; }
-	// Sanity check: dots and durations have same length
-	if (durList->size() != dotList->size()) { printf("Dots and Durs have different lengths!\n");  return 0; }
+	// Use the non-dotted breakout, unless dotted provides a solution with strictly less notes
+	basedurations& durList = (dottedCount < plainCount) ? breakoutDotted : breakout;
+	size_t count = (dottedCount < plainCount) ? dottedCount : plainCount;
 	
 	// Find the element in the voice first (so we can use the iterator as an index)
 	guido::treeIterator<guido::Sguidoelement> it;
@@ -1043,17 +1192,17 @@ static int breakNoteTo(SARVoice voice, SARNote el, rational timeToRemove) {
 	voice->erase(it);
 	
 	// For each duration in the breakout chosen, create the note to match the original, and insert it
-	for (int i = 0; i < durList->size(); i++) {
+	while (durList.next(dur, dots)) {
 		// Copy old note, and adjust duration
 		SARNote durNote = getCopyOfNote(el);
-		*durNote = durList->at(i);
-		durNote->SetDots(dotList->at(i));
+		*durNote = dur;
+		durNote->SetDots(dots);
 		// Insert into parent
 		voice->insert(it, durNote);
 	}
 	
 	// Return the number of notes added
-	return (int)(durList->size());
+	return (int)count;
 }
 
 static int breakChordTo(SARVoice voice, SARChord el, rational timeToRemove) {
@@ -1062,22 +1211,25 @@ static int breakChordTo(SARVoice voice, SARChord el, rational timeToRemove) {
 	// If the desired length is the current length, we're done.
 	if (timeToRemove <= rational(0, 1)) return 0;
 	
-	std::vector<int> noDots = std::vector<int>();
-	rationals breakout = rational::getBaseRationals(newDur, false, &noDots);
-	std::vector<int> dots = std::vector<int>();
-	rationals breakoutDotted = rational::getBaseRationals(newDur, true, &dots);
-	// If the new duration can be represented as one chord, do that.
-	if (breakout.size() == 1) { *el = newDur;  el->SetDots(0);  return 1; }
-	if (breakoutDotted.size() == 1) { *el = breakoutDotted.at(0);  el->SetDots(1);  return 1; }
+	basedurations breakout(newDur);
+	basedurations breakoutDotted(newDur, true);
+	size_t plainCount = breakout.size();
+	size_t dottedCount = breakoutDotted.size();
+	rational dur; int dots;
+	// If the new duration can be represented as one chord, do that (on a copy of the chord).
+	if ((plainCount == 1) || (dottedCount == 1)) {
+		if (plainCount == 1) { dur = newDur;  dots = 0; }
+		else breakoutDotted.next(dur, dots);
+		SARChord copy = replaceByCopy(voice, el);
+		if (!copy) return 0;
+		*copy = dur;  copy->SetDots(dots);  return 1;
+	}
 	
 	// If we hit this point, we need to actually break up the chord into separate chords to represent it
 	
-	// Point list at non-dotted breakout, unless dotted provides a solution with strictly less pieces
-	rationals* durList = &breakout;
-	std::vector<int>* dotList = &noDots;
-	if (breakoutDotted.size() < breakout.size()) { durList = &breakoutDotted;  dotList = &dots; }
-	// Sanity check: dots and durations have same length
-	if (durList->size() != dotList->size()) { printf("Dots and Durs have different lengths!\n");  return 0; }
+	// Use the non-dotted breakout, unless dotted provides a solution with strictly less pieces
+	basedurations& durList = (dottedCount < plainCount) ? breakoutDotted : breakout;
+	size_t count = (dottedCount < plainCount) ? dottedCount : plainCount;
 	
 	// Find the element in the voice first (so we can use the iterator as an index)
 	guido::treeIterator<guido::Sguidoelement> it;
@@ -1094,17 +1246,37 @@ static int breakChordTo(SARVoice voice, SARChord el, rational timeToRemove) {
 	voice->erase(it);
 	
 	// For each duration in the breakout chosen, create the chord to match the original, and insert it
-	for (int i = 0; i < durList->size(); i++) {
+	while (durList.next(dur, dots)) {
 		// Copy old chord, and adjust duration
 		SARChord durChord = getCopyOfChord(el);
-		*durChord = durList->at(i);
-		durChord->SetDots(dotList->at(i));
+		*durChord = dur;
+		durChord->SetDots(dots);
 		// Insert into parent
 		voice->insert(it, durChord);
 	}
 	
 	// Return the number of chords added
-	return (int)(durList->size());
+	return (int)count;
+}
+
+// An edit that can still fail must not modify the existing elements: the score handles restore
+// the elements containers only.  The element is replaced in its container by a copy, which is
+// returned (null when the element is not found).
+template <typename T> static SMARTP<T> replaceByCopy(Sguidoelement parent, const SMARTP<T>& el) {
+	for (auto& child: parent->elements()) {
+		if (child == el) {
+			clonevisitor cv;
+			Sguidoelement clone = cv.clone(child);
+			SMARTP<T> copy = dynamic_cast<T*>((guidoelement*)clone);
+			child = copy;
+			return copy;
+		}
+		if (child->size()) {
+			SMARTP<T> copy = replaceByCopy(child, el);
+			if (copy) return copy;
+		}
+	}
+	return 0;
 }
 
 // Simple helper to copy notes
@@ -1144,128 +1316,4 @@ static bool checkSongDuration(SARVoice voice, rational desiredLength) {
 // ---------------------------[ End Action Methods ]------------------------------------
 
 
-// -----------------------------[ Browse Methods ]--------------------------------------
-
-// Returns whether we were already done by now
-bool elementoperationvisitor::done() {
-	return currentVoiceDate() > fTargetDate;
-}
-
-// Returns whether the given element is the one we are done now because of
-bool elementoperationvisitor::done(SARNote& elt) {
-	bool midiSatisfied = fTargetMidiPitch == -1;
-	if (! midiSatisfied) {
-		int octave = elt->GetOctave();
-		int midiPitch = elt->midiPitch(octave);
-		midiSatisfied = midiPitch == fTargetMidiPitch;
-	}
-	return midiSatisfied && currentVoiceDate() == fTargetDate;
-}
-
-// In addition to this, always specify: fMidiPitch, fTargetDate, fTargetVoice
-void elementoperationvisitor::init() {
-	fCurrentVoiceNum = 0;
-	fInChord = false;
-	fCurrentKeySignature = 0;
-	fCurrentMeter = "";
-	fCurrentInstrument = nullptr;
-	fDone = false;
-	fResultVoice = nullptr;
-	fResultChord = nullptr;
-	fResultNote = nullptr;
-	fFoundNote = false;
-	fFoundChord = false;
-	durationvisitor::reset();
-}
-
-void elementoperationvisitor::visitStart(SARVoice& elt) {
-	// print("Visit Start: Voice\n");
-	fCurrentVoiceRef = elt;
-	if (fCurrentVoiceNum == fTargetVoice) {
-		durationvisitor::visitStart(elt);
-	} else {
-		fBrowser.stop();
-	}
-}
-
-void elementoperationvisitor::visitStart(SARChord& elt) {
-	fCurrentChordRef = elt;
-	fInChord = true;
-	durationvisitor::visitStart(elt);
-}
-
-void elementoperationvisitor::visitStart(SARNote& elt) {
-	// print("Visit Start: Note\n");
-	
-	if (done()) {
-		// This means that a previous note was being looked for.  Stop.
-		fBrowser.stop();
-		return;
-	}
-	
-	if (! done(elt)) {
-		durationvisitor::visitStart(elt);
-		return;
-	}
-	
-	// If we're here, that means that we are at the time slot being looked for
-	
-	// Set the data we need to go and do what we want after the browsing is done.
-	fResultVoice = fCurrentVoiceRef;
-	fResultChord = fInChord ? fCurrentChordRef : nullptr;
-	fResultNote  = elt;
-	
-	// Call for browsing to stop
-	fBrowser.stop();
-}
-
-void elementoperationvisitor::visitStart(Sguidotag& tag) {
-	// print("Visit Start: Tag\n");
-	
-	switch (tag->getType()) {
-		case kTKey: {
-			std::string val = tag->getAttribute(0)->getValue();
-			fCurrentKeySignature = stoi(val);
-			break;}
-		case kTMeter:
-			fCurrentMeter = tag->attributes().at(0)->getValue();
-			break;
-		case kTInstr:
-		case kTInstrument:
-			fCurrentInstrument = tag;
-			break;
-	}
-}
-
-void elementoperationvisitor::visitEnd(SARVoice& elt) {
-	// print("Visit End: Voice\n");
-	if (fCurrentVoiceNum == fTargetVoice) {
-		durationvisitor::visitEnd(elt);
-	}
-	fBrowser.stop(false);
-	fCurrentVoiceNum++;
-}
-
-void elementoperationvisitor::visitEnd(SARChord& elt) {
-	// print("Visit End: Chord\n");
-	fInChord = false;
-	if (done()) { fBrowser.stop(); return; }
-	
-	durationvisitor::visitEnd(elt);
-	
-	if (! done()) { return; }
-	
-	// If we got here, we want to act on this chord
-	
-	// Set results so the outer method can do it's thing
-	if (fTargetMidiPitch < 0) {
-		fResultVoice = fCurrentVoiceRef;
-		fResultChord = fCurrentChordRef;
-		fResultNote  = nullptr;
-	}
-}
-
-// ---------------------------[ End Browse Methods ]------------------------------------
-
-
 } // namespace
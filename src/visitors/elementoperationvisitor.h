@@ -17,9 +17,10 @@ mbwilliams226@gmail.com
 #ifndef __ElementOperationVisitor__
 #define __ElementOperationVisitor__
 
+#include <vector>
+
 #include "arexport.h"
-#include "durationvisitor.h"
-#include "visitor.h"
+#include "voiceindexvisitor.h"
 #include "ARNote.h"
 #include "ARChord.h"
 #include "ARFactory.h"
@@ -56,14 +57,12 @@ struct NamedNewNoteInfo {
 enum OpResult { none, success, needsMeasureAdded, failure, noActionTaken };
 
 
-class gar_export elementoperationvisitor :
-	public durationvisitor,
-	public visitor<Sguidotag>
+class gar_export elementoperationvisitor
 {
 	
 	public:
-		         elementoperationvisitor() {  }
-		virtual ~elementoperationvisitor() {  }
+		         elementoperationvisitor() : fEditedVoice(-1), fEditedTop(0) {  }
+		virtual ~elementoperationvisitor() { invalidate(); }
 		
 		// Methods to add/remove elements
 		OpResult 	deleteEvent   (const Sguidoelement& score, const rational& time, unsigned int voiceIndex, int midiPitch=-1);
@@ -81,17 +80,25 @@ class gar_export elementoperationvisitor :
 		OpResult	setVoiceInstrument(const Sguidoelement& score, int voice, const char* instrName, int instrCode);
 		
 		
-		bool done();
-		bool done(SARNote& elt);
-		void init();
-		
-		virtual void visitStart ( SARVoice& elt );
-		virtual void visitStart ( SARNote& elt );
-		virtual void visitStart ( SARChord& elt );
-		virtual void visitStart ( Sguidotag& tag );
-
-		virtual void visitEnd   ( SARVoice& elt );
-		virtual void visitEnd   ( SARChord& elt );
+		/*! \brief Drops the time index of the score.  Must be called when the score is modified
+				by something else than the edit methods (extended, voices added or removed...)
+		*/
+		void		invalidate();
+		/*! \brief Gives the parts of the score modified by the edits since the previous call.
+			\param modified on output, for each voice, the first voice child that may have been
+				modified, or size_t(-1) when the voice is unchanged
+			\return false when the whole score must be considered as modified
+				(first call for a score, or after invalidate())
+		*/
+		bool		takeModified(std::vector<size_t>& modified);
+		/*! \brief Returns the time index of a voice, building the voices list on the first call for a score.
+				The part of the voice modified by the previous edit is dropped from the index first.
+			\return the voice index, or 0 when the score has no such voice
+		*/
+		voiceindexvisitor*	voiceIndex(const Sguidoelement& score, unsigned int voice);
+		/*! \brief Returns the score duration, ie the end date of its longest voice, taken from the time index.
+		*/
+		rational			duration(const Sguidoelement& score);
 		
 	protected:
 	
@@ -107,25 +114,30 @@ class gar_export elementoperationvisitor :
 		*/
 		OpResult 	cutScoreAndInsert(SARVoice& voice, Sguidoelement existing, std::vector<Sguidoelement> newEls, rational insertListDur);
 	
-		// These represent what we are looking for
-		rational		fTargetDate;
-		unsigned int	fTargetVoice;
-		int				fTargetMidiPitch;
-		// These represent the current state of the browsing
-		unsigned int	fCurrentVoiceNum;
-		SARVoice		fCurrentVoiceRef;
-		SARChord		fCurrentChordRef;
+		// The time index of the score voices, kept from one edit to the next
+		Sguidoelement					fIndexedScore;
+		std::vector<voiceindexvisitor*>	fIndex;
+		// The part of the score that the last edit may have modified
+		int				fEditedVoice;
+		size_t			fEditedTop;
+		// The parts of the score modified since the last call to takeModified
+		std::vector<size_t>	fModified;
+		bool			fAllModified = true;
+		// These represent the state of the voice at the result location
 		int				fCurrentKeySignature = 0;
 		std::string		fCurrentMeter = "";
 		Sguidotag		fCurrentInstrument;
-		bool			fDone;
 		// Used to return results from a browse to an edit method
 		SARVoice		fResultVoice;
 		SARChord		fResultChord;
 		SARNote			fResultNote;
 		bool			fFoundNote;
 		bool			fFoundChord;
-		
+	
+	private:
+		// the index is owned by the visitor: copies are not allowed
+				 elementoperationvisitor(const elementoperationvisitor&);
+		elementoperationvisitor& operator= (const elementoperationvisitor&);
 };
 
 /*! @} */
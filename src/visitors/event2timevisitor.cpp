@@ -40,7 +40,7 @@ rational event2timevisitor::event2time (const Sguidoelement& score, unsigned int
 	fTargetVoice = voiceIndex;
 	fTargetDate.set(-1,1);
 	fTargetEvent = evIndex;
-	init();
+	init(score);
 	fBrowser.browse(*score);
 	return fDone ? currentVoiceDate().rationalise() : rational(-1,1);
 }
@@ -51,7 +51,7 @@ int	event2timevisitor::time2event (const Sguidoelement& score, const rational& t
 	fTargetVoice = voiceIndex;
 	fTargetDate = time;
 	fTargetEvent = -1;
-	init();
+	init(score);
 	fBrowser.browse(*score);
 	int evIndex = -1;
 	if (fDone)
@@ -64,10 +64,12 @@ int	event2timevisitor::time2event (const Sguidoelement& score, const rational& t
 }
 
 //______________________________________________________________________________
-void event2timevisitor::init ()
+void event2timevisitor::init (const Sguidoelement& score)
 {
 	fCurrentVoice = 0;
 	fDone = false;
+	initTicks (score);
+	if (fTickBase) toTicks (fTargetDate, fTickBase, fTargetTicks);
 	durationvisitor::reset();
 	fCountVisitor.reset();
 }
@@ -77,6 +79,7 @@ bool event2timevisitor::done ()
 {
 	fDone = false;
 	if (fTargetEvent >= 0) fDone = (fCountVisitor.currentCount() == (int)fTargetEvent);
+	else if (fTickBase) fDone = (fCurrentVoiceTicks > fTargetTicks);	// date > target iff ticks > floor(target ticks)
 	else fDone = (currentVoiceDate() > fTargetDate);
 	return fDone;
 }
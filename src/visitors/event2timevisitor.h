@@ -73,6 +73,7 @@ class gar_export event2timevisitor : public durationvisitor
 
 	protected:
 		rational		fTargetDate;
+		long long		fTargetTicks;		// the target date in ticks (rounded down) when the score has a tick base
 		int				fTargetEvent;
 		unsigned int	fTargetVoice;
 		unsigned int	fCurrentVoice;
@@ -80,7 +81,7 @@ class gar_export event2timevisitor : public durationvisitor
 		counteventsvisitor fCountVisitor;
 
 		bool done ();
-		void init ();
+		void init (const Sguidoelement& score);
 
 		virtual void visitStart ( SARVoice& elt );
 		virtual void visitStart ( SARNote& elt );
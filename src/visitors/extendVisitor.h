@@ -62,12 +62,11 @@ public:
 		rational durAdded = rational(0, 1);
 		rational currentMeterDur = rational(fCurrentMeter);
 		while (durAdded < fDurToFill) {
-			rational restDur = currentMeterDur;
-			restDur = restDur.rationalise();
-			rationals brokenDownDurs = rational::getBaseRationals(restDur, false, nullptr);
-			for (int i = 0; i < brokenDownDurs.size(); i++) {
+			basedurations brokenDownDurs(currentMeterDur);
+			rational restDur; int restDots;
+			while (brokenDownDurs.next(restDur, restDots)) {
 				SARNote rest = ARFactory().createNote("_");
-				*rest = brokenDownDurs.at(i);
+				*rest = restDur;
 				rest->SetDots(0);
 				elt->push(rest);
 			}
@@ -33,6 +33,7 @@
 #include "AROthers.h"
 #include "ARTag.h"
 #include "guidocomment.h"
+#include "tree_browser.h"
 
 using namespace std;
 
@@ -41,22 +42,63 @@ namespace guido
 
 //_______________________________________________________________________________
 struct count_notes {
-	bool operator () (const Sguidoelement elt) const { 
+	bool operator () (const Sguidoelement& elt) const { 
 		return dynamic_cast<ARNote*>((guidoelement*)elt)!=0;
 	}
 };
 
+//______________________________________________________________________________
+gmnvisitor::gmnvisitor(std::ostream& stream, bool visitauto, bool compact)
+	: fOut(stream, compact ? 0 : kMaxLine, compact ? 0 : 4), fChordNotes(0),
+	  fVoicesCount(1), fInsideTag(0), fVisitAuto(visitauto), fCompact(compact)
+{
+	reset();
+}
+
+//______________________________________________________________________________
+void gmnvisitor::reset ()
+{
+	fSpace = false;
+	fCurrentDuration = ARNote::getDefaultDuration();
+	fCurrentDots = 0;
+	fCurrentOctave = ARNote::getDefaultOctave();
+}
+
+//______________________________________________________________________________
+// in compact mode, a space is only required between 2 notes or tags
+void gmnvisitor::token (const std::string& str, bool space)
+{
+	if (fCompact) {
+		if (fSpace && space) fOut << ' ';
+		fSpace = space;
+	}
+	fOut << str;
+}
+
+//______________________________________________________________________________
+void gmnvisitor::separator (const char* pretty, char compact)
+{
+	if (fCompact) {
+		fOut << compact;
+		fSpace = false;
+	}
+	else fOut << pretty;
+}
+
 //______________________________________________________________________________
 void gmnvisitor::visitStart ( Sguidotag& tag )
 {
 	if (tag->getAuto() && !fVisitAuto) return; // auto elements are not printed
-	fOut << string(*tag);
+	fToken.clear();
+	tag->write (fToken);
+	token (fToken);
 	fOut.pbreak();
 	if (tag->size() > 0) { 
 		fOut << '(';
+		fSpace = false;
 		if (fChordNotes > 1) fInsideTag++;
 	}
-	fOut << ' ';
+	if (!fCompact) fOut << ' ';
 }
 
 //______________________________________________________________________________
@@ -64,13 +106,13 @@ void gmnvisitor::visitEnd ( Sguidotag& tag )
 {
 	if (tag->getAuto() && !fVisitAuto) return; // auto elements are not printed
 	if (tag->size() > 0) {
-		fOut << ") ";
+		separator (") ", ')');
 		fOut.pbreak();
 		if (fInsideTag) fInsideTag--;
 		// here we check whether the container is inside a chord and whether
 		// we need to print a note separator
 		if (!fInsideTag && (fChordNotes > 1)) {
-			fOut << ", ";
+			separator (", ", ',');
 			fChordNotes--;
 		}
 	}
@@ -82,41 +124,99 @@ void gmnvisitor::visitStart ( SARNote& note )
 	if (note->getAuto() && !fVisitAuto) return; // auto elements are not printed
 	if (note->size() && fVisitAuto) return;		// the note has been automatically splitted
 
-	fOut << string(*note);
+	fToken.clear();
+	if (fCompact) compact (note);
+	else note->write (fToken);
+	token (fToken);
 	// inside a chord, notes are separated by a comma (',') 
 	// but when the note is inside a container tag, the comma is printed when
 	// the container is closed (ie after the ')'
 	if ((fChordNotes > 1) && !fInsideTag) {
 		fChordNotes--;
-		fOut << ", ";
+		separator (", ", ',');
 	}
-	fOut << ' ';
+	if (!fCompact) fOut << ' ';
 	fOut.pbreak();
 }
 
+//______________________________________________________________________________
+// writes the note without the octave, duration and dots that are equal to the
+// implicit ones, according to the current state of the output
+void gmnvisitor::compact ( SARNote& note )
+{
+	bool octave = true;
+	if (note->isPitched() && !note->implicitOctave()) {
+		octave = (note->GetOctave() != fCurrentOctave);
+		fCurrentOctave = note->GetOctave();
+	}
+
+	int dots = note->GetDots();
+	bool duration = !note->implicitDuration();
+	// an implicit duration takes the current dots when the note has no dots
+	if (duration && (note->duration() == fCurrentDuration) && (dots || !fCurrentDots))
+		duration = false;
+	bool writedots = duration || (dots != fCurrentDots);
+	note->write (fToken, octave, duration, writedots);
+
+	// same rules as ARNote::totalduration
+	if (!note->implicitDuration()) {
+		fCurrentDuration = note->duration();
+		fCurrentDots = 0;
+	}
+	if (dots) fCurrentDots = dots;
+}
+
 //______________________________________________________________________________
 void gmnvisitor::barline ( Sguidotag& bar )
 {
 	if (bar->getAuto() && !fVisitAuto) return; // auto elements are not printed
-	fOut << "\n| ";
+	if (fCompact) token ("|", false);
+	else fOut << "\n| ";
+}
+
+//______________________________________________________________________________
+void gmnvisitor::repeat ( Sguidotag& bar )
+{
+	fToken.clear();
+	bar->write (fToken);
+	if (fCompact) token (fToken);
+	else fOut << "\n " << fToken << " ";
 }
 
 //______________________________________________________________________________
 void gmnvisitor::visitStart ( SARBar& bar )			{ Sguidotag t(bar); barline(t); }
-void gmnvisitor::visitStart ( SARRepeatBegin& bar )	{ fOut << "\n " << string(*bar) << " "; }
-void gmnvisitor::visitStart ( SARRepeatEnd& bar )	{ fOut << "\n " << string(*bar) << " "; }
+void gmnvisitor::visitStart ( SARRepeatBegin& bar )	{ Sguidotag t(bar); repeat(t); }
+void gmnvisitor::visitStart ( SARRepeatEnd& bar )	{ Sguidotag t(bar); repeat(t); }
 
 //______________________________________________________________________________
-void gmnvisitor::visitStart ( Sguidovariable& var )	{ fOut << "\n" << Sguidoelement(var); }
-void gmnvisitor::visitStart ( Sguidocomment& c )	{ fOut << c->getName(); }
+void gmnvisitor::visitStart ( Sguidovariable& var )
+{
+	if (fCompact) token (string(*var));
+	else fOut << "\n" << Sguidoelement(var);
+}
+
+//______________________________________________________________________________
+// a line comment must be followed by an end of line
+void gmnvisitor::visitStart ( Sguidocomment& c )
+{
+	const string& text = c->getName();
+	fOut << text;
+	if (fCompact) {
+		size_t start = text.find_first_not_of (" \t\r\n");
+		if ((start != string::npos) && (text[start] == '%') && (text.back() != '\n'))
+			fOut << '\n';
+		fSpace = false;
+	}
+}
 
 //______________________________________________________________________________
 void gmnvisitor::visitStart ( SARMusic& music )
 {
-	for (auto elt: music->getHeader()) elt->acceptIn(*this);
+	for (const auto& elt: music->getHeader()) elt->acceptIn(*this);
 	fVoicesCount = music->size();
 	fOut << "{";
-	if (fVoicesCount >= 1)
+	fSpace = false;
+	if (!fCompact && (fVoicesCount >= 1))
 		fOut++ << "\n";
 }
 
@@ -127,7 +227,8 @@ void gmnvisitor::visitEnd ( SARMusic& music )
 		fOut--;
 	}
 	fOut << "}";
-	for (auto elt: music->getFooter()) { fOut << elt ; }
+	for (const auto& elt: music->getFooter()) { fOut << elt ; }
+	fOut.flush();		// the score is complete: the stream must not wait for the visitor destruction
 }
 
 //______________________________________________________________________________
@@ -136,7 +237,7 @@ void gmnvisitor::visitStart ( SARChord& chord )
 	if (chord->getAuto() && !fVisitAuto) return;
 	count_notes p;
 	fChordNotes = count_if(chord->begin(), chord->end(), p);
-	fOut << "{ ";
+	separator ("{ ", '{');
 }
 
 //______________________________________________________________________________
@@ -144,26 +245,138 @@ void gmnvisitor::visitEnd ( SARChord& chord )
 {
 	if (chord->getAuto() && !fVisitAuto) return;
 	fChordNotes = 0;
-	fOut << "} ";
+	separator ("} ", '}');
 	fOut.pbreak();
 }
 
 //______________________________________________________________________________
 void gmnvisitor::visitStart ( SARVoice& voice )
 {
-	for (auto elt: voice->getBefore()) elt->acceptIn(*this);
+	for (const auto& elt: voice->getBefore()) elt->acceptIn(*this);
+	reset();
 	fOut << "[";
-	if (voice->size () > 10) fOut++ << '\n';
+	if (!fCompact && (voice->size () > 10)) fOut++ << '\n';
 }
 
 //______________________________________________________________________________
 void gmnvisitor::visitEnd ( SARVoice& voice )
 {
-	if (voice->size () > 10) --fOut << '\n';
+	closeVoice (voice);
+	nextVoice ();
+}
+
+//______________________________________________________________________________
+void gmnvisitor::closeVoice ( SARVoice& voice )
+{
+	if (!fCompact && (voice->size () > 10)) --fOut << '\n';
 	fOut << ']';
-	for (auto elt: voice->getAfter()) elt->acceptIn(*this);
-	if  (--fVoicesCount) fOut << ",\n\n";
-	else --fOut << "\n" ;
+	fSpace = false;
+	for (const auto& elt: voice->getAfter()) elt->acceptIn(*this);
+}
+
+//______________________________________________________________________________
+void gmnvisitor::nextVoice ()
+{
+	if  (--fVoicesCount) separator (",\n\n", ',');
+	else if (!fCompact) --fOut << "\n" ;
+}
+
+//______________________________________________________________________________
+// printing with a cache
+//______________________________________________________________________________
+void gmncache::invalidate (size_t voice, size_t top)
+{
+	if ((voice < fVoices.size()) && (top < fVoices[voice].fDirty))
+		fVoices[voice].fDirty = top;
+}
+
+//______________________________________________________________________________
+void gmnvisitor::print ( const Sguidoelement& score, gmncache& cache )
+{
+	tree_browser<guidoelement> browser(this);
+	SARMusic music = dynamic_cast<ARMusic*>((guidoelement*)score);
+	if (!music) {
+		browser.browse (*score);
+		fOut.flush();
+		return;
+	}
+
+	size_t voices = 0;
+	for (const auto& elt: music->elements())
+		if (dynamic_cast<ARVoice*>((guidoelement*)elt)) voices++;
+
+	if ((cache.fScore != score) || (cache.fCompact != fCompact) || (cache.fVoices.size() != voices)) {
+		cache.fScore = score;
+		cache.fCompact = fCompact;
+		cache.fVoices.clear();
+		cache.fVoices.resize (voices);
+	}
+
+	visitStart (music);
+	size_t n = 0;			// the voices are numbered as the score voices i.e. ignoring the other elements
+	for (const auto& elt: music->elements()) {
+		SARVoice voice = dynamic_cast<ARVoice*>((guidoelement*)elt);
+		if (voice) printVoice (voice, cache.fVoices[n++]);
+		else browser.browse (*elt);
+	}
+	visitEnd (music);
+}
+
+//______________________________________________________________________________
+// a voice is printed again from its first modified child, using the output state
+// saved at this child; the code of the previous children is copied from the cache
+void gmnvisitor::printVoice ( SARVoice& voice, gmncache::voicecode& code )
+{
+	bool indented = !fCompact && (voice->size () > 10);
+	if ((code.fVoice != (guidoelement*)voice) || (code.fStartColumn != fOut.column())) {
+		code.fVoice = voice;
+		code.fStartColumn = fOut.column();
+		code.fDirty = 0;
+	}
+	if (code.fDirty == gmncache::kClean) {
+		fOut.append (code.fCode, code.fCode.size(), code.fEndColumn);
+		nextVoice ();
+		return;
+	}
+
+	fOut.hold (true);
+	size_t start = fOut.mark();
+	size_t top = code.fDirty;
+	if (code.fCheckpoints.size() && (top >= code.fCheckpoints.size()))
+		top = code.fCheckpoints.size() - 1;			// the voice has been modified after its last child
+
+	if (!top || (indented != code.fIndented)) {
+		top = 0;
+		visitStart (voice);
+	}
+	else {
+		const gmncache::checkpoint& state = code.fCheckpoints[top];
+		fOut.append (code.fCode, state.fOffset, state.fColumn);
+		if (indented) fOut++;
+		fChordNotes = 0;
+		fInsideTag = 0;
+		fSpace = state.fSpace;
+		fCurrentDuration = state.fDuration;
+		fCurrentDots = state.fDots;
+		fCurrentOctave = state.fOctave;
+	}
+
+	code.fCheckpoints.resize (top);
+	const ctree<guidoelement>::branchs& children = voice->elements();
+	tree_browser<guidoelement> browser(this);
+	for (size_t i = top; i <= children.size(); i++) {
+		gmncache::checkpoint state = { fOut.mark() - start, fOut.column(), fSpace, fCurrentDuration, fCurrentDots, fCurrentOctave };
+		code.fCheckpoints.push_back (state);
+		if (i < children.size()) browser.browse (*children[i]);
+	}
+	closeVoice (voice);
+
+	code.fCode.assign (fOut.pending(), start, string::npos);
+	code.fEndColumn = fOut.column();
+	code.fIndented = indented;
+	code.fDirty = gmncache::kClean;
+	fOut.hold (false);
+	nextVoice ();
 }
 
 } // namespace
@@ -25,9 +25,12 @@
 #define __gmnvisitor__
 
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include "arexport.h"
 #include "ARTypes.h"
+#include "guidorational.h"
 #include "streambeautifuller.h"
 #include "visitor.h"
 
@@ -39,9 +42,60 @@ namespace guido
 @{
 */
 
+//______________________________________________________________________________
+/*!
+\brief	The gmn code of a score, kept to print the score again after local edits.
+
+	The code of each voice is kept with the state of the output at the start of
+	each voice child. A voice modified from a given child is printed again
+	from this child only, the code of the previous children is copied from the
+	cache, and the unmodified voices are entirely copied from the cache.
+	The modified parts must be reported using invalidate().
+*/
+class gar_export gmncache
+{
+	public:
+		//! drops the whole cache
+		void	invalidate ()							{ fScore = Sguidoelement(); fVoices.clear(); }
+		//! drops the code of a voice starting at the voice child top
+		void	invalidate (size_t voice, size_t top);
+
+	private:
+		friend class gmnvisitor;
+		static const size_t kClean = ~size_t(0);
+
+		// the state of the output at the start of a voice child
+		struct checkpoint {
+			size_t		fOffset;		// the offset of the child code in the voice code
+			int			fColumn;
+			bool		fSpace;
+			rational	fDuration;
+			int			fDots;
+			int			fOctave;
+		};
+		struct voicecode {
+			Sguidoelement			fVoice;
+			std::string				fCode;
+			std::vector<checkpoint>	fCheckpoints;	// one per voice child, plus the end of the children
+			size_t					fDirty = 0;		// the first voice child to print again, or kClean
+			int						fStartColumn = 0;
+			int						fEndColumn = 0;
+			bool					fIndented = false;
+		};
+
+		Sguidoelement			fScore;
+		bool					fCompact = false;
+		std::vector<voicecode>	fVoices;
+};
+
 //______________________________________________________________________________
 /*!
 \brief	A visitor to print the gmn description
+
+	In compact mode, the output is intended for machines rather than for humans:
+	there is no indentation nor line breaks, the spaces are limited to the
+	separation of notes and tags, and the octaves, durations and dots that are
+	equal to the implicit ones are omitted.
 */
 class gar_export gmnvisitor :
 	public visitor<Sguidotag>,
@@ -57,19 +111,37 @@ class gar_export gmnvisitor :
 {
 	private:
 		streambeautifuller fOut;	///< the decorated output stream 
+		std::string	fToken;		///< a buffer for the notes and tags gmn code, reused to avoid allocations
 		long	fChordNotes;	///< count of notes, should always be 0 outside a chord, used for notes separator
 		long	fVoicesCount;	///< count of voices, used for voices separator
 		int		fInsideTag;		///< only used inside a chord for notes separator purpose
 		bool	fVisitAuto;		///< control auto elements visite
+		bool	fCompact;		///< compact output mode
+		bool	fSpace;			///< compact mode: a space is required before the next note or tag
+		rational fCurrentDuration;	///< compact mode: the current implicit duration
+		int		fCurrentDots;		///< compact mode: the current implicit dots
+		int		fCurrentOctave;		///< compact mode: the current implicit octave
 
 		enum { kMaxLine=70 };	///< the maximum length of a line
 		
+		void reset ();
+		void printVoice ( SARVoice& voice, gmncache::voicecode& code );
+		void closeVoice ( SARVoice& voice );
+		void nextVoice ();
+		void token ( const std::string& str, bool space=true );
+		void separator ( const char* pretty, char compact );
+		void compact ( SARNote& note );
 		void barline ( Sguidotag& tag );
+		void repeat  ( Sguidotag& tag );
 
     public:
-				gmnvisitor(std::ostream& stream, bool visitauto=false) 
-					: fOut(stream, kMaxLine), fChordNotes(0), 
-					  fVoicesCount(1), fInsideTag(0), fVisitAuto(visitauto) {}
+				gmnvisitor(std::ostream& stream, bool visitauto=false, bool compact=false);
+
+		/*! \brief prints a score using and updating the code kept in a cache
+			\param score the score to print
+			\param cache the cache of the score code, where the score modifications must have been reported
+		*/
+		void print ( const Sguidoelement& score, gmncache& cache );
 
 		virtual void visitStart ( Sguidocomment& tag );
 		virtual void visitStart ( Sguidovariable& tag );
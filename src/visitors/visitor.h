@@ -45,6 +45,67 @@ template<class C> class visitor : virtual public basevisitor
 		virtual void visitEnd  ( C& ) {};
 };
 
+//______________________________________________________________________________
+/*!
+\brief dispatches a visitable object to a visitor
+
+	The dispatch list C... gives the smart pointer types that may handle an
+	object, from the most to the least specific one (e.g. SARNote, Sguidoelement).
+	The first visitor<C> implemented by the visitor is resolved once per visitor
+	and per type and stored in the visitor dispatch table, so that the following
+	visits of the same type don't have to look for it again.
+	\param type a unique integer for each visitable type (see guidotags.h)
+*/
+template<class... C> class dispatcher;
+
+template<class C, class... Rest> class dispatcher<C, Rest...>
+{
+	public:
+		template<class T> static void visitStart (basevisitor& v, unsigned int type, T* obj) {
+			const basevisitor::target& t = resolve (v, type);
+			if (t.fLevel >= 0) start (t, t.fLevel, obj);
+		}
+		template<class T> static void visitEnd (basevisitor& v, unsigned int type, T* obj) {
+			const basevisitor::target& t = resolve (v, type);
+			if (t.fLevel >= 0) end (t, t.fLevel, obj);
+		}
+
+		static const basevisitor::target& resolve (basevisitor& v, unsigned int type) {
+			basevisitor::target& t = v.dispatch (type);
+			if (t.fLevel == basevisitor::target::kUnresolved) find (v, t, 0);
+			return t;
+		}
+		static void find (basevisitor& v, basevisitor::target& t, int level) {
+			if (visitor<C>* p = dynamic_cast<visitor<C>*>(&v)) {
+				t.fVisitor = p;
+				t.fLevel = level;
+			}
+			else dispatcher<Rest...>::find (v, t, level + 1);
+		}
+		template<class T> static void start (const basevisitor::target& t, int level, T* obj) {
+			if (level) dispatcher<Rest...>::start (t, level - 1, obj);
+			else {
+				C ptr = obj;
+				static_cast<visitor<C>*>(t.fVisitor)->visitStart (ptr);
+			}
+		}
+		template<class T> static void end (const basevisitor::target& t, int level, T* obj) {
+			if (level) dispatcher<Rest...>::end (t, level - 1, obj);
+			else {
+				C ptr = obj;
+				static_cast<visitor<C>*>(t.fVisitor)->visitEnd (ptr);
+			}
+		}
+};
+
+template<> class dispatcher<>
+{
+	public:
+		static void find (basevisitor&, basevisitor::target& t, int)	{ t.fLevel = basevisitor::target::kNone; }
+		template<class T> static void start (const basevisitor::target&, int, T*)	{}
+		template<class T> static void end (const basevisitor::target&, int, T*)		{}
+};
+
 /*! @} */
 
 } // namespace
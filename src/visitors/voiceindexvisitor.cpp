@@ -0,0 +1,234 @@
+
+#include <algorithm>
+
+#include "ARChord.h"
+#include "ARNote.h"
+#include "AROthers.h"
+#include "guidotags.h"
+#include "voiceindexvisitor.h"
+
+using namespace std;
+
+namespace guido
+{
+
+//______________________________________________________________________________
+voiceindexvisitor::voiceindexvisitor(const SARVoice& voice, long tickbase)
+	: fVoice(voice), fCurrentTop(0), fCurrentChord(0)
+{
+	setTickBase (tickbase);
+	durationvisitor::reset();
+	fCurrentOctave = fPitchOctave = ARNote::getDefaultOctave();
+	fCurrentKeySignature = 0;
+	fCheckpoints.push_back (state());
+	snapshot();
+}
+
+//______________________________________________________________________________
+voicestate voiceindexvisitor::state() const
+{
+	voicestate state;
+	state.fDate = currentVoiceDate();
+	state.fTicks = fCurrentVoiceTicks;
+	state.fNoteTicks = fCurrentNoteTicks;
+	state.fNoteDuration = fCurrentNoteDuration;
+	state.fDots = fCurrentDots;
+	state.fOctave = fCurrentOctave;
+	state.fKeySignature = fCurrentKeySignature;
+	state.fMeter = fCurrentMeter;
+	state.fInstrument = fCurrentInstrument;
+	return state;
+}
+
+//______________________________________________________________________________
+void voiceindexvisitor::snapshot()
+{
+	voicesnapshot s;
+	s.fTop = fCheckpoints.size() - 1;
+	s.fState = fCheckpoints.back();
+	s.fPitchOctave = fPitchOctave;
+	s.fTags = fCurrentTags;
+	fSnapshots.push_back (s);
+}
+
+//______________________________________________________________________________
+void voiceindexvisitor::restore(const voicesnapshot& snapshot)
+{
+	const voicestate& state = snapshot.fState;
+	durationvisitor::reset();
+	fCurrentVoiceDuration = state.fDate;
+	fCurrentVoiceTicks = state.fTicks;
+	fCurrentNoteTicks = state.fNoteTicks;
+	fCurrentNoteDuration = state.fNoteDuration;
+	fCurrentDots = state.fDots;
+	fCurrentOctave = state.fOctave;
+	fCurrentKeySignature = state.fKeySignature;
+	fCurrentMeter = state.fMeter;
+	fCurrentInstrument = state.fInstrument;
+	fPitchOctave = snapshot.fPitchOctave;
+	fCurrentTags = snapshot.fTags;
+}
+
+//______________________________________________________________________________
+// the voice children are scanned one at a time, so that the scan can stop as
+// soon as the requested date is reached and restart later from a checkpoint
+void voiceindexvisitor::indexTo(const rational& date)
+{
+	eventdate d = makeDate (date);
+	while ((fCheckpoints.size() - 1) < fVoice->elements().size()) {
+		if (d.startsAfter (fCheckpoints.back())) break;
+		scan();
+		if (!fTickBase) d.fUseTicks = false;		// the scan has switched to rationals
+	}
+}
+
+//______________________________________________________________________________
+rational voiceindexvisitor::end()
+{
+	while ((fCheckpoints.size() - 1) < fVoice->elements().size()) scan();
+	return fCheckpoints.back().fDate;
+}
+
+//______________________________________________________________________________
+// scans the next voice child
+void voiceindexvisitor::scan()
+{
+	fCurrentTop = fCheckpoints.size() - 1;
+	fBrowser.browse (*fVoice->elements()[fCurrentTop]);
+	fCheckpoints.push_back (state());
+	if (((fCheckpoints.size() - 1) % kSnapshotPeriod) == 0) snapshot();
+}
+
+//______________________________________________________________________________
+eventdate voiceindexvisitor::makeDate(const rational& date) const
+{
+	eventdate d;
+	d.fDate = date;
+	d.fTicks = 0;
+	d.fUseTicks = fTickBase != 0;
+	d.fExact = d.fUseTicks ? toTicks (date, fTickBase, d.fTicks) : false;
+	return d;
+}
+
+//______________________________________________________________________________
+static bool startsBefore (const indexedevent& event, const eventdate& date)	{ return date.startsBefore (event); }
+
+size_t voiceindexvisitor::lowerBound(const eventdate& date) const
+{
+	return lower_bound (fEvents.begin(), fEvents.end(), date, startsBefore) - fEvents.begin();
+}
+
+//______________________________________________________________________________
+static bool startsAfter (const rational& date, const voicesnapshot& s)	{ return s.fState.fDate > date; }
+
+const voicesnapshot& voiceindexvisitor::seek(const rational& date)
+{
+	indexTo (date);
+	vector<voicesnapshot>::const_iterator i = upper_bound (fSnapshots.begin(), fSnapshots.end(), date, startsAfter);
+	if (i != fSnapshots.begin()) i--;
+	return *i;
+}
+
+//______________________________________________________________________________
+void voiceindexvisitor::invalidate(size_t top)
+{
+	if ((top + 1) >= fCheckpoints.size()) return;		// this part of the voice is not indexed yet
+
+	top -= top % kSnapshotPeriod;						// the scan restarts from a snapshot
+	fCheckpoints.resize (top + 1);
+	fSnapshots.resize ((top / kSnapshotPeriod) + 1);
+	restore (fSnapshots.back());
+	while (fEvents.size() && (fEvents.back().fTop >= top))
+		fEvents.pop_back();
+}
+
+//______________________________________________________________________________
+// the visit methods
+//______________________________________________________________________________
+void voiceindexvisitor::visitStart(SARNote& elt)
+{
+	if (fInChord) durationvisitor::visitStart (elt);
+	else {
+		indexedevent event;
+		event.fState = state();
+		event.fNote = elt;
+		event.fTop = fCurrentTop;
+		durationvisitor::visitStart (elt);
+		event.fEnd = currentVoiceDate();
+		event.fEndTicks = fCurrentVoiceTicks;
+		fEvents.push_back (event);
+	}
+	if (!elt->implicitOctave()) {
+		fCurrentOctave = elt->GetOctave();
+		if (elt->isPitched()) fPitchOctave = fCurrentOctave;
+	}
+}
+
+//______________________________________________________________________________
+void voiceindexvisitor::visitStart(SARChord& elt)
+{
+	indexedevent event;
+	event.fState = state();
+	event.fEnd = event.fState.fDate;
+	event.fEndTicks = event.fState.fTicks;
+	event.fChord = elt;
+	event.fTop = fCurrentTop;
+	fCurrentChord = fEvents.size();
+	fEvents.push_back (event);
+	durationvisitor::visitStart (elt);
+}
+
+//______________________________________________________________________________
+void voiceindexvisitor::visitEnd(SARChord& elt)
+{
+	durationvisitor::visitEnd (elt);
+	fEvents[fCurrentChord].fEnd = currentVoiceDate();
+	fEvents[fCurrentChord].fEndTicks = fCurrentVoiceTicks;
+}
+
+//______________________________________________________________________________
+void voiceindexvisitor::visitStart(Sguidotag& tag)
+{
+	switch (tag->getType()) {
+		case kTKey:
+			fCurrentKeySignature = tag->getAttributeIntValue (0, 0);
+			break;
+		case kTMeter:
+			fCurrentMeter = tag->getAttributeValue (0);
+			break;
+		case kTInstr:
+		case kTInstrument:
+			fCurrentInstrument = tag;
+			break;
+		case kTText:
+		case kTLyrics:
+			return;
+	}
+	// maintains the tags in effect: a tag replaces the previous tag of the same type
+	for (size_t i = 0; i < fCurrentTags.size(); i++) {
+		if (fCurrentTags[i]->getType() == tag->getType()) {
+			fCurrentTags[i] = tag;
+			return;
+		}
+	}
+	fCurrentTags.push_back (tag);
+}
+
+//______________________________________________________________________________
+// a range tag or an end tag closes the tags of the same type and of the matching type
+void voiceindexvisitor::visitEnd(Sguidotag& tag)
+{
+	int type = tag->getType();
+	if ((type == kTText) || (type == kTLyrics)) return;
+	if (!tag->endTag() && !tag->size()) return;
+
+	int match = tag->matchType();
+	for (size_t i = 0; i < fCurrentTags.size(); ) {
+		int current = fCurrentTags[i]->getType();
+		if ((current == type) || (match && (current == match)))
+			fCurrentTags.erase (fCurrentTags.begin() + i);
+		else i++;
+	}
+}
+
+} // namespace
@@ -0,0 +1,172 @@
+/*
+
+This visitor builds a time index of the events (notes and chords) of a voice,
+so that the edit methods of the elementoperationvisitor can locate an event
+at a given date with a binary search instead of browsing the score again.
+
+The index is built lazily: the voice children are only scanned up to the
+latest date asked for.  When an edit modifies the voice, only the events
+starting from the modified voice child are dropped, and they are scanned
+again on the next lookup.
+
+Every kSnapshotPeriod voice children, the index also keeps a snapshot of the
+voice state that includes the tags in effect, so that an operation can resume
+the browsing of the voice from there (see tailOperation).
+
+When the score has a tick base, the events dates are also stored in ticks and
+the lookups compare integers (see eventdate).
+
+*/
+
+#ifndef __voiceIndexVisitor__
+#define __voiceIndexVisitor__
+
+#include <string>
+#include <vector>
+
+#include "arexport.h"
+#include "durationvisitor.h"
+#include "guidoelement.h"
+#include "ARChord.h"
+#include "ARNote.h"
+#include "ARTag.h"
+#include "ARTypes.h"
+#include "visitor.h"
+
+namespace guido
+{
+
+/*!
+\addtogroup visitors
+@{
+*/
+
+//______________________________________________________________________________
+/*!
+\brief	The implicit state of a voice at a given date
+*/
+struct gar_export voicestate {
+	rational		fDate;				///< the current voice date
+	long long		fTicks;				///< the current voice date in ticks (when the index uses ticks)
+	long long		fNoteTicks;			///< the current implicit note duration in ticks
+	rational		fNoteDuration;		///< the current implicit note duration
+	int				fDots;				///< the current implicit dots
+	int				fOctave;			///< the current implicit octave
+	int				fKeySignature;		///< the current key signature
+	std::string		fMeter;				///< the current meter
+	Sguidotag		fInstrument;		///< the current instrument tag (if any)
+};
+
+//______________________________________________________________________________
+/*!
+\brief	An indexed event: a note outside of a chord or a chord
+*/
+struct gar_export indexedevent {
+	voicestate		fState;		///< the voice state at the event start
+	rational		fEnd;		///< the event end date
+	long long		fEndTicks;	///< the event end date in ticks (when the index uses ticks)
+	SARNote			fNote;		///< the note (null for a chord)
+	SARChord		fChord;		///< the chord (null for a single note)
+	size_t			fTop;		///< the index of the voice child that contains the event
+};
+
+//______________________________________________________________________________
+/*!
+\brief	The state of a voice at the start of a voice child, to resume the voice browsing
+*/
+struct gar_export voicesnapshot {
+	size_t					fTop;			///< the index of the voice child
+	voicestate				fState;			///< the voice state at the voice child start
+	int						fPitchOctave;	///< the octave of the last pitched note with an explicit octave
+	std::vector<Sguidotag>	fTags;			///< the tags in effect: the last opened tag of each type, text and lyrics excepted
+};
+
+//______________________________________________________________________________
+/*!
+\brief	A date prepared for comparisons with the indexed events dates
+*/
+struct gar_export eventdate {
+	rational		fDate;		///< the date
+	long long		fTicks;		///< the date in ticks rounded down, when fUseTicks is true
+	bool			fExact;		///< true when the date is an integer number of ticks
+	bool			fUseTicks;	///< true when the comparisons use the ticks
+
+	bool startsAt	(const indexedevent& e) const	{ return fUseTicks ? (fExact && (e.fState.fTicks == fTicks)) : (e.fState.fDate == fDate); }
+	bool endsAfter	(const indexedevent& e) const	{ return fUseTicks ? (e.fEndTicks > fTicks) : (e.fEnd > fDate); }
+	bool startsAfter(const voicestate& s) const		{ return fUseTicks ? (s.fTicks > fTicks) : (s.fDate > fDate); }
+	bool startsBefore(const indexedevent& e) const	{ return fUseTicks ? (e.fState.fTicks < fTicks + !fExact) : (e.fState.fDate < fDate); }
+};
+
+//______________________________________________________________________________
+/*!
+\brief	A visitor that maintains a time index of a voice events.
+*/
+class gar_export voiceindexvisitor :
+	public durationvisitor,
+	public visitor<Sguidotag>
+{
+	public:
+		enum { kSnapshotPeriod = 16 };
+
+				 voiceindexvisitor(const SARVoice& voice, long tickbase = 0);
+		virtual ~voiceindexvisitor() {}
+
+		const SARVoice&		voice() const	{ return fVoice; }
+		/*! \brief the events indexed so far, in time order */
+		const std::vector<indexedevent>& events() const	{ return fEvents; }
+		/*! \brief the voice state after the last indexed event */
+		voicestate			state() const;
+
+		/*! \brief prepares a date for the comparisons with the events dates */
+		eventdate	makeDate (const rational& date) const;
+		/*! \brief makes sure that all the events starting at or before date are indexed */
+		void	indexTo (const rational& date);
+		/*! \brief indexes the whole voice and returns the voice end date */
+		rational	end ();
+		/*! \brief returns the index of the first event that starts at or after date */
+		size_t	lowerBound (const eventdate& date) const;
+		size_t	lowerBound (const rational& date) const		{ return lowerBound (makeDate(date)); }
+		/*!
+			\brief gives the last snapshot of the voice state before a date
+			The voice is indexed up to the date first.
+			\param date the date
+			\return the last snapshot that starts at or before date
+		*/
+		const voicesnapshot&	seek (const rational& date);
+		/*!
+			\brief drops the events contained in the voice children starting at index top
+			The scan restarts from the last snapshot before the modified voice child.
+			\param top the index of the first modified voice child
+		*/
+		void	invalidate (size_t top);
+
+		virtual void visitStart ( SARNote& elt );
+		virtual void visitStart ( SARChord& elt );
+		virtual void visitStart ( Sguidotag& tag );
+		virtual void visitEnd   ( SARChord& elt );
+		virtual void visitEnd   ( Sguidotag& tag );
+
+	protected:
+		void	restore (const voicesnapshot& snapshot);
+		void	snapshot ();
+		void	scan ();
+
+		SARVoice					fVoice;
+		std::vector<indexedevent>	fEvents;
+		std::vector<voicestate>		fCheckpoints;	// the state at the start of each scanned voice child
+		std::vector<voicesnapshot>	fSnapshots;		// the state every kSnapshotPeriod voice children
+		size_t						fCurrentTop;	// the index of the voice child being scanned
+		size_t						fCurrentChord;	// the index of the chord event being scanned
+		int							fCurrentOctave;
+		int							fPitchOctave;	// ignores the octave of the empty notes
+		std::vector<Sguidotag>		fCurrentTags;	// the tags in effect
+		int							fCurrentKeySignature;
+		std::string					fCurrentMeter;
+		Sguidotag					fCurrentInstrument;
+};
+
+/*! @} */
+
+} // namespace
+
+#endif
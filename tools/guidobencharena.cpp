@@ -0,0 +1,84 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It measures the parse and destroy time and the peak memory with and without an arena.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
+#include "common.cxx"
+
+#include "garena.h"
+#include "guidoelement.h"
+#include "guidoparser.h"
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " heap|arena count score [score...]" << endl;
+	cerr << "       parses and destroys the scores count times and reports the time and the peak"  << endl;
+	cerr << "       memory of the process; with arena, each score is allocated in its own arena"  << endl;
+	cerr << "       the peak memory is for the whole process: run each mode separately to compare them"  << endl;
+	cerr << "       " << scoredesc << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+// the peak resident set size in KB, or 0 when unavailable
+static long peakRSS ()
+{
+#ifndef WIN32
+	struct rusage usage;
+	if (getrusage (RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+		return usage.ru_maxrss / 1024;		// in bytes on macOS
+#else
+		return usage.ru_maxrss;
+#endif
+	}
+#endif
+	return 0;
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	int count;
+	if ((argc < 4) || !intVal(argv[2], count) || (count <= 0)) usage(argv[0]);
+	string mode (argv[1]);
+	if ((mode != "heap") && (mode != "arena")) usage(argv[0]);
+	bool arena = (mode == "arena");
+
+	vector<string> scores;
+	string _stdin;
+	for (int i = 3; i < argc; i++) {
+		string gmn;
+		if (!gmnVal (argv[i], gmn, _stdin)) return -1;
+		scores.push_back (gmn);
+	}
+
+	long before = peakRSS();
+	size_t failed = 0;
+	auto start = chrono::steady_clock::now();
+	for (int n = 0; n < count; n++) {
+		for (const auto& gmn: scores) {
+			guidoparser r;
+			if (arena) r.setArena (garena::create());
+			Sguidoelement elt = r.parseBuffer(gmn.data(), gmn.size());
+			if (!elt) failed++;
+		}		// the parser and the score are destroyed here
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	cout << scores.size() << " scores parsed " << count << " times on the " << mode << ": "
+		 << elapsed.count() << " s, peak RSS " << peakRSS() << " KB (" << before << " KB before parsing)";
+	if (failed) cout << ", " << failed << " parse errors";
+	cout << endl;
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It compares the load time of the scores binary form to the gmn parse time.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "common.cxx"
+
+#include "binaryreader.h"
+#include "binaryvisitor.h"
+#include "guidoelement.h"
+#include "guidoparser.h"
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " count score [score...]" << endl;
+	cerr << "       parses the scores and reads their binary form count times and reports the times"  << endl;
+	cerr << "       " << scoredesc << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	int count;
+	if ((argc < 3) || !intVal(argv[1], count) || (count <= 0)) usage(argv[0]);
+
+	vector<string> gmns, binaries;
+	string _stdin;
+	for (int i = 2; i < argc; i++) {
+		string gmn;
+		if (!gmnVal (argv[i], gmn, _stdin)) return -1;
+		guidoparser p;
+		Sguidoelement score = p.parseString(gmn.c_str());
+		if (!score) {
+			cerr << argv[i] << ": parse error, skipped" << endl;
+			continue;
+		}
+		binaryvisitor bv;
+		gmns.push_back (gmn);
+		binaries.push_back (bv.write (score));
+	}
+	if (gmns.empty()) return -1;
+
+	size_t failed = 0;
+	auto start = chrono::steady_clock::now();
+	for (int n = 0; n < count; n++) {
+		for (const auto& gmn: gmns) {
+			guidoparser p;
+			if (!p.parseString (gmn.c_str())) failed++;
+		}
+	}
+	chrono::duration<double> parse = chrono::steady_clock::now() - start;
+
+	start = chrono::steady_clock::now();
+	for (int n = 0; n < count; n++) {
+		for (const auto& data: binaries) {
+			binaryreader r;
+			if (!r.read (data.data(), data.size())) failed++;
+		}
+	}
+	chrono::duration<double> load = chrono::steady_clock::now() - start;
+	if (failed) cerr << failed << " scores failed to load" << endl;
+
+	cout << gmns.size() << " scores loaded " << count << " times" << endl;
+	cout << "  gmn parse:   " << parse.count() << " s" << endl;
+	cout << "  binary read: " << load.count() << " s (" << (load.count() ? parse.count() / load.count() : 0) << " times faster)" << endl;
+	return failed ? -1 : 0;
+}
@@ -0,0 +1,59 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It measures the gmn printing throughput.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "common.cxx"
+
+#include "guidoelement.h"
+#include "guidoparser.h"
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " count score [score...]" << endl;
+	cerr << "       print the scores count times and report the print throughput in MB/s"  << endl;
+	cerr << "       " << scoredesc << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	int count;
+	if ((argc < 3) || !intVal(argv[1], count) || (count <= 0)) usage(argv[0]);
+
+	vector<Sguidoelement> scores;
+	string _stdin;
+	for (int i = 2; i < argc; i++) {
+		string gmn;
+		if (!gmnVal (argv[i], gmn, _stdin)) return -1;
+		guidoparser r;
+		Sguidoelement elt = r.parseBuffer(gmn.data(), gmn.size());
+		if (elt) scores.push_back (elt);
+		else cerr << argv[i] << ": parse error, skipped" << endl;
+	}
+	if (scores.empty()) return -1;
+
+	size_t bytes = 0;
+	auto start = chrono::steady_clock::now();
+	for (int n = 0; n < count; n++) {
+		for (const auto& score: scores) {
+			ostringstream out;
+			out << score;
+			bytes += out.str().size();
+		}
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	double mb = bytes / (1024. * 1024.);
+	cout << scores.size() << " scores printed " << count << " times: " << mb << " MB in "
+		 << elapsed.count() << " s, " << (mb / elapsed.count()) << " MB/s" << endl;
+	return 0;
+}
@@ -0,0 +1,102 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It measures the cost of the rational arithmetic on the scores durations.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "common.cxx"
+
+#include "ARNote.h"
+#include "AROthers.h"
+#include "ARTypes.h"
+#include "guidoelement.h"
+#include "guidoparser.h"
+#include "tree_browser.h"
+#include "visitor.h"
+
+//_______________________________________________________________________________
+// collects the notes durations of the voices of a score, one list per voice
+class durationscollector :
+	public visitor<SARVoice>,
+	public visitor<SARNote>
+{
+	public:
+		void collect (const Sguidoelement& score, vector<vector<rational> >& voices) {
+			fVoices = &voices;
+			tree_browser<guidoelement> browser(this);
+			browser.browse (*score);
+		}
+
+		virtual void visitStart ( SARVoice& elt )	{
+			fVoices->push_back (vector<rational>());
+			fCurrent = ARNote::getDefaultDuration();
+			fDots = 0;
+		}
+		virtual void visitStart ( SARNote& elt )	{
+			if (!fVoices->empty()) fVoices->back().push_back (elt->totalduration (fCurrent, fDots));
+		}
+
+	private:
+		vector<vector<rational> >* fVoices;
+		rational	fCurrent;
+		int			fDots;
+};
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " count score [score...]" << endl;
+	cerr << "       sums the durations of the scores voices count times and reports the time per addition"  << endl;
+	cerr << "       " << scoredesc << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	int count;
+	if ((argc < 3) || !intVal(argv[1], count) || (count <= 0)) usage(argv[0]);
+
+	vector<vector<rational> > voices;
+	string _stdin;
+	for (int i = 2; i < argc; i++) {
+		string gmn;
+		if (!gmnVal (argv[i], gmn, _stdin)) return -1;
+		guidoparser r;
+		Sguidoelement elt = r.parseBuffer(gmn.data(), gmn.size());
+		if (elt) {
+			durationscollector collector;
+			collector.collect (elt, voices);
+		}
+		else cerr << argv[i] << ": parse error, skipped" << endl;
+	}
+
+	size_t additions = 0;
+	long check = 0;
+	auto start = chrono::steady_clock::now();
+	try {
+		for (int n = 0; n < count; n++) {
+			for (const auto& voice: voices) {
+				rational sum;
+				for (const auto& d: voice) sum += d;
+				check += sum.getNumerator();		// keeps the sums from being optimized out
+				additions += voice.size();
+			}
+		}
+	}
+	catch (const overflow_error& e) {
+		cerr << e.what() << endl;
+		return -1;
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	cout << voices.size() << " voices summed " << count << " times: " << additions << " additions in "
+		 << elapsed.count() << " s, " << (elapsed.count() * 1e9 / (additions ? additions : 1)) << " ns per addition"
+		 << " (check " << check << ")" << endl;
+	return 0;
+}
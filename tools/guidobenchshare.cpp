@@ -0,0 +1,83 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It measures the top and head operations with and without elements sharing.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include "common.cxx"
+
+#include "guidoelement.h"
+#include "guidoparser.h"
+#include "headOperation.h"
+#include "topOperation.h"
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " count score [voices duration]" << endl;
+	cerr << "       applies the top and head operations count times to a score, with and without"  << endl;
+	cerr << "       elements sharing, and reports the times"  << endl;
+	cerr << "       voices: the voices kept by the top operation (default 2)"  << endl;
+	cerr << "       duration: the duration kept by the head operation (default 1/2)"  << endl;
+	cerr << "       " << scoredesc << endl;
+	cerr << "       e.g. a 30 voices score: " << basename(name) << " 1000 score.gmn 2 1/2" << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+static string print (const Sguidoelement& elt)
+{
+	ostringstream out;
+	out << elt;
+	return out.str();
+}
+
+//_______________________________________________________________________________
+template <typename OP, typename ARG> static double measure (const Sguidoelement& score, ARG arg, int count, bool share, string& result)
+{
+	auto start = chrono::steady_clock::now();
+	Sguidoelement elt;
+	for (int n = 0; n < count; n++) {
+		OP op;
+		op.share (share);
+		elt = op (score, arg);
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	result = elt ? print (elt) : "";
+	return elapsed.count();
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	int count, voices = 2;
+	rational duration (1, 2);
+	if (((argc != 3) && (argc != 5)) || !intVal(argv[1], count) || (count <= 0)) usage(argv[0]);
+	if ((argc == 5) && (!intVal(argv[3], voices) || !rationalVal(argv[4], duration))) usage(argv[0]);
+
+	string gmn, _stdin;
+	if (!gmnVal (argv[2], gmn, _stdin)) return -1;
+	guidoparser p;
+	Sguidoelement score = p.parseString (gmn.c_str());
+	if (!score) {
+		cerr << argv[2] << ": parse error" << endl;
+		return -1;
+	}
+
+	string copied, shared;
+	double tc = measure<topOperation> (score, voices, count, false, copied);
+	double ts = measure<topOperation> (score, voices, count, true, shared);
+	cout << "top " << voices << ":  copy " << tc << " s, share " << ts << " s" << endl;
+	int ret = 0;
+	if (copied != shared) { cerr << "top: the results differ" << endl; ret = -1; }
+
+	double hc = measure<headOperation> (score, duration, count, false, copied);
+	double hs = measure<headOperation> (score, duration, count, true, shared);
+	cout << "head " << duration << ": copy " << hc << " s, share " << hs << " s" << endl;
+	if (copied != shared) { cerr << "head: the results differ" << endl; ret = -1; }
+	return ret;
+}
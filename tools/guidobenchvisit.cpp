@@ -0,0 +1,96 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It measures the cost of the visits dispatch with durationvisitor passes.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "common.cxx"
+
+#include "durationvisitor.h"
+#include "guidoelement.h"
+#include "guidoparser.h"
+#include "tree_browser.h"
+#include "visitor.h"
+
+//_______________________________________________________________________________
+// a visitor that does nothing but to count the elements: its passes measure
+// the browsing and the dispatch only
+class elementsvisitor : public visitor<Sguidoelement>
+{
+	public:
+		size_t count (const Sguidoelement& score) {
+			fCount = 0;
+			tree_browser<guidoelement> browser(this);
+			browser.browse (*score);
+			return fCount;
+		}
+		virtual void visitStart ( Sguidoelement& elt )	{ fCount++; }
+
+	private:
+		size_t fCount;
+};
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " count score [score...]" << endl;
+	cerr << "       browses the scores count times with a durationvisitor and with an empty visitor"  << endl;
+	cerr << "       and reports the time per visited element"  << endl;
+	cerr << "       " << scoredesc << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	int count;
+	if ((argc < 3) || !intVal(argv[1], count) || (count <= 0)) usage(argv[0]);
+
+	vector<Sguidoelement> scores;
+	size_t elements = 0;
+	string _stdin;
+	for (int i = 2; i < argc; i++) {
+		string gmn;
+		if (!gmnVal (argv[i], gmn, _stdin)) return -1;
+		guidoparser r;
+		Sguidoelement elt = r.parseBuffer(gmn.data(), gmn.size());
+		if (elt) {
+			elementsvisitor ev;
+			elements += ev.count (elt);
+			scores.push_back (elt);
+		}
+		else cerr << argv[i] << ": parse error, skipped" << endl;
+	}
+	if (!elements) return -1;
+
+	rational total (0, 1);
+	auto start = chrono::steady_clock::now();
+	for (int n = 0; n < count; n++) {
+		for (const auto& score: scores) {
+			durationvisitor dv;
+			total = dv.duration (score);
+		}
+	}
+	chrono::duration<double> durations = chrono::steady_clock::now() - start;
+
+	size_t visited = 0;
+	start = chrono::steady_clock::now();
+	for (int n = 0; n < count; n++) {
+		for (const auto& score: scores) {
+			elementsvisitor ev;
+			visited += ev.count (score);
+		}
+	}
+	chrono::duration<double> empty = chrono::steady_clock::now() - start;
+
+	double visits = double(elements) * count;
+	cout << scores.size() << " scores, " << elements << " elements, browsed " << count << " times" << endl;
+	cout << "durationvisitor: " << durations.count() << " s, " << (durations.count() * 1e9 / visits) << " ns per element" << endl;
+	cout << "empty visitor:   " << empty.count() << " s, " << (empty.count() * 1e9 / visits) << " ns per element" << endl;
+	if (visited != elements * count) cerr << "unexpected visits count: " << visited << endl;
+	return 0;
+}
@@ -0,0 +1,72 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It checks that the binary form of the scores gives the scores back.
+*/
+
+#include <iostream>
+#include <sstream>
+
+#include "common.cxx"
+
+#include "binaryreader.h"
+#include "binaryvisitor.h"
+#include "guidoelement.h"
+#include "guidoparser.h"
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " score [score...]" << endl;
+	cerr << "       writes the scores binary form, reads it back and compares the gmn code"  << endl;
+	cerr << "       of the score read to the gmn code of the parsed score"  << endl;
+	cerr << "       " << scoredesc << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+static string print (const Sguidoelement& elt)
+{
+	ostringstream out;
+	out << elt;
+	return out.str();
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	if (argc < 2) usage(argv[0]);
+
+	int failed = 0;
+	string _stdin;
+	for (int i = 1; i < argc; i++) {
+		string gmn;
+		if (!gmnVal (argv[i], gmn, _stdin)) return -1;
+		guidoparser p;
+		Sguidoelement score = p.parseBuffer(gmn.data(), gmn.size());
+		if (!score) {
+			cerr << argv[i] << ": parse error, skipped" << endl;
+			continue;
+		}
+
+		binaryvisitor bv;
+		string data = bv.write (score);
+		binaryreader r;
+		Sguidoelement back = r.read (data.data(), data.size());
+		if (!back) {
+			cout << argv[i] << ": read failed: " << r.getError() << endl;
+			failed++;
+		}
+		else if (print(back) != print(score)) {
+			cout << argv[i] << ": the score read differs from the parsed score" << endl;
+			failed++;
+		}
+		else if (SARMusic(dynamic_cast<ARMusic*>((guidoelement*)back))->getTickBase() !=
+				 SARMusic(dynamic_cast<ARMusic*>((guidoelement*)score))->getTickBase()) {
+			cout << argv[i] << ": the score read tick base differs from the parsed score" << endl;
+			failed++;
+		}
+		else cout << argv[i] << ": ok (" << gmn.size() << " bytes of gmn, " << data.size() << " bytes of binary data)" << endl;
+	}
+	return failed ? -1 : 0;
+}
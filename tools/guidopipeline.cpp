@@ -0,0 +1,42 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+*/
+
+#include <iostream>
+
+#include "common.cxx"
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " score step [step...]"  << endl;
+	cerr << "       applies a sequence of operations to a score, which is parsed and printed once."  << endl;
+	cerr << "       " << scoredesc << endl;
+	cerr << "       step: an operation and its argument, e.g. 'transpose 2', 'head 1/2' or 'top 1'."  << endl;
+	cerr << "             operations: transpose, top, bottom, mirror, head, tail, ehead, etail,"  << endl;
+	cerr << "             setduration, multduration, seq, par, rpar (the latter take gmn code, e.g. 'seq [c d]')."  << endl;
+	cerr << "             a step may also contain several steps separated with ';'."  << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	if (argc < 3) usage(argv[0]);
+
+	string gmn, _stdin;
+	if (!gmnVal (argv[1], gmn, _stdin)) return -1;
+
+	string pipeline;
+	for (int i = 2; i < argc; i++) {
+		pipeline += argv[i];
+		pipeline += ";";
+	}
+	garErr err = guidoPipeline (gmn.c_str(), pipeline.c_str(), cout);
+	if (err != kNoErr) {
+		error (err);
+		return err;
+	}
+	return 0;
+}
@@ -30,7 +30,7 @@ int main (int argc, char* argv[])
 	if (!gmnVal (argv[1], gmn, _stdin)) return -1;
 
 	guidoparser r;
-	Sguidoelement elt = r.parseString(gmn.c_str());
+	Sguidoelement elt = r.parseBuffer(gmn.data(), gmn.size());
 
 	if (elt) cout << elt << endl;
 	else {
@@ -0,0 +1,141 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It checks the smart pointers reference counting: the moves don't touch
+  the reference counts and, when the counting is atomic, pointers to a
+  shared tree may be copied concurrently.
+*/
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "common.cxx"
+
+#include "clonevisitor.h"
+#include "ctree.h"
+#include "gar_smartpointer.h"
+#include "guidoelement.h"
+#include "guidoparser.h"
+
+//_______________________________________________________________________________
+// a tree node that counts the references it gets: SMARTP calls the node
+// addReference, which hides the smartable one
+static atomic<unsigned long> gAddRefs (0);
+
+class node : public ctree<node>
+{
+	public:
+		static SMARTP<node> create()	{ node* o = new node; assert(o!=0); return o; }
+		void addReference()				{ gAddRefs++; smartable::addReference(); }
+
+	protected:
+				 node() {}
+		virtual ~node() {}
+};
+typedef SMARTP<node> Snode;
+
+static int gFailed = 0;
+static void check (const char* what, unsigned long value, unsigned long expected)
+{
+	cout << what << ": " << value << " (expected " << expected << ")";
+	if (value != expected) {
+		cout << " FAILED";
+		gFailed++;
+	}
+	cout << endl;
+}
+
+//_______________________________________________________________________________
+static void moves (size_t n)
+{
+	ctree<node>::branchs children;
+	for (size_t i = 0; i < n; i++) children.push_back (node::create());
+
+	Snode parent = node::create();
+	gAddRefs = 0;
+	parent->push (children);
+	check ("references added by a copying push", gAddRefs, n);
+
+	Snode other = node::create();
+	gAddRefs = 0;
+	other->push (std::move(children));
+	check ("references added by a moving push", gAddRefs, 0);
+
+	gAddRefs = 0;
+	Snode copy (parent);
+	Snode moved (std::move(copy));
+	moved = std::move(other);
+	check ("references added by a copy then two moves", gAddRefs, 1);
+	check ("references of a moved from pointer", copy ? 1 : 0, 0);
+}
+
+#ifdef GAR_ATOMIC_REFCOUNT
+//_______________________________________________________________________________
+// the threads take and drop references to the same nodes
+static void threads (size_t n, unsigned count)
+{
+	ctree<node>::branchs shared;
+	for (size_t i = 0; i < n; i++) shared.push_back (node::create());
+
+	vector<thread> pool;
+	for (unsigned t = 0; t < count; t++)
+		pool.emplace_back ([&shared] () {
+			for (int round = 0; round < 100; round++) {
+				ctree<node>::branchs copy (shared);
+			}
+		});
+	for (auto& t: pool) t.join();
+
+	unsigned long wrong = 0;
+	for (const auto& elt: shared) if (elt->refs() != 1) wrong++;
+	check ("nodes with a wrong count after the concurrent copies", wrong, 0);
+}
+#endif
+
+//_______________________________________________________________________________
+// a clone holds no reference to the source nor extra references to its own elements
+static unsigned long extraRefs (const Sguidoelement& elt, unsigned expected)
+{
+	unsigned long wrong = (elt->refs() != expected) ? 1 : 0;
+	for (const auto& child: elt->elements()) wrong += extraRefs (child, 1);	// held by the parent only
+	return wrong;
+}
+
+static void clones (const char* file)
+{
+	string gmn, _stdin;
+	if (!gmnVal (file, gmn, _stdin)) return;
+	Sguidoelement score;
+	{
+		guidoparser p;			// the parser keeps a reference to the last score
+		score = p.parseString (gmn.c_str());
+	}
+	if (!score) return;
+
+	clonevisitor cv;
+	Sguidoelement copy = cv.clone (score);
+	check ("score elements with extra references after a clone", extraRefs (score, 1), 0);
+	check ("clone elements with extra references", extraRefs (copy, 1), 0);
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	if (argc > 2) {
+		cerr << "usage: " << basename(argv[0]) << " [score]" << endl;
+		cerr << "       checks the smart pointers reference counting, and optionally the references of a cloned score" << endl;
+		cerr << "       " << scoredesc << endl;
+		return -1;
+	}
+	moves (1000);
+#ifdef GAR_ATOMIC_REFCOUNT
+	cout << "the reference counting is atomic" << endl;
+	threads (1000, 8);
+#else
+	cout << "the reference counting is not atomic: the concurrent copies are not checked" << endl;
+#endif
+	if (argc == 2) clones (argv[1]);
+	return gFailed ? -1 : 0;
+}
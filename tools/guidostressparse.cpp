@@ -0,0 +1,76 @@
+/*
+
+  This file is provided as an example of the guidoar library use.
+  It parses scores concurrently and checks the results against a sequential parse.
+*/
+
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "common.cxx"
+
+#include "guidoelement.h"
+#include "guidoparser.h"
+
+//_______________________________________________________________________________
+static void usage(char * name)
+{
+	cerr << "usage: " << basename(name) << " threads count score [score...]" << endl;
+	cerr << "       parses the scores count times on each thread and compares the printed"  << endl;
+	cerr << "       results to the ones of a sequential parse"  << endl;
+	cerr << "       " << scoredesc << endl;
+	exit (-1);
+}
+
+//_______________________________________________________________________________
+// a score that can't be parsed is printed as an empty string
+static string parse (const string& gmn)
+{
+	guidoparser r;
+	Sguidoelement elt = r.parseBuffer(gmn.data(), gmn.size());
+	if (!elt) return "";
+	ostringstream out;
+	out << elt;
+	return out.str();
+}
+
+//_______________________________________________________________________________
+int main (int argc, char* argv[])
+{
+	int threads, count;
+	if ((argc < 4) || !intVal(argv[1], threads) || (threads <= 0) || !intVal(argv[2], count) || (count <= 0))
+		usage(argv[0]);
+
+	vector<string> scores, expected;
+	string _stdin;
+	for (int i = 3; i < argc; i++) {
+		string gmn;
+		if (!gmnVal (argv[i], gmn, _stdin)) return -1;
+		scores.push_back (gmn);
+		expected.push_back (parse (gmn));
+	}
+
+	atomic<unsigned long> failed (0);
+	vector<thread> pool;
+	for (int t = 0; t < threads; t++)
+		pool.emplace_back ([&, t] () {
+			for (int n = 0; n < count; n++) {
+				// the threads don't parse the scores in the same order
+				for (size_t i = 0; i < scores.size(); i++) {
+					size_t s = (i + t) % scores.size();
+					if (parse (scores[s]) != expected[s]) {
+						failed++;
+						cerr << argv[s + 3] << ": different result on thread " << t << endl;
+					}
+				}
+			}
+		});
+	for (auto& t: pool) t.join();
+
+	unsigned long total = (unsigned long)threads * count * scores.size();
+	cout << total << " concurrent parses on " << threads << " threads: " << failed << " different results" << endl;
+	return failed ? -1 : 0;
+}